@@ -1,103 +1,158 @@
 #include <iostream>
 #include <string>
-#include <iomanip> // 为了使用 std::fixed 和 std::setprecision 来格式化输出货币
+#include <algorithm>
+#include <span>
+#include <utility>
+#include "Money.h" // 用整数 "分" 表示金额的定点数类型
+#include "Txn.h"   // 批量交易: Txn 和 BatchResult
+#include "Log.h"   // 日志: 类的成员函数通过 LOG_xxx 输出，而不是直接写 std::cout
+#include "InternedString.h" // 驻留字符串: 同一个人的多个账户共享同一份姓名
 
 class BankAccount {
 // 公有成员: 可以从类的外部访问和调用
 public:
     // 构造函数: 初始化一个新的 BankAccount 对象
-    BankAccount(std::string accNum, std::string ownerName, double initialBalance) {
-        accountNumber = accNum;
+    // accNum 每个账户都不同，按值传入后移动进成员，避免再复制一次
+    BankAccount(std::string accNum, InternedString ownerName, Money initialBalance) {
+        accountNumber = std::move(accNum);
         owner = ownerName;
         // 初始余额不能为负
-        if (initialBalance >= 0) {
+        if (!initialBalance.isNegative()) {
             balance = initialBalance;
         } else {
-            balance = 0.0;
-            std::cout << "警告: 初始余额不能为负。已将余额设置为0。" << std::endl;
+            balance = Money();
+            LOG_WARN("警告: 初始余额不能为负。已将余额设置为0。");
         }
-        std::cout << "账户 " << accountNumber << " 为 " << owner << " 创建成功。" << std::endl;
+        LOG_INFO("账户 ", accountNumber, " 为 ", owner, " 创建成功。");
     }
 
     // 公有方法: 存款
-    void deposit(double amount) {
-        if (amount > 0) {
-            balance += amount;
-            std::cout << "存款 " << amount << " 成功。";
-            displayBalance();
+    // 余额溢出时存款失败 (Money 的加法带溢出检查)
+    void deposit(Money amount) {
+        if (amount.isPositive()) {
+            std::optional<Money> newBalance = balance.checkedAdd(amount);
+            if (!newBalance) {
+                LOG_WARN("存款失败：余额超出上限。");
+                return;
+            }
+            balance = *newBalance;
+            LOG_INFO("存款 ", amount, " 成功。当前余额: ", balance);
         } else {
-            std::cout << "存款金额必须为正数。" << std::endl;
+            LOG_WARN("存款金额必须为正数。");
         }
     }
 
     // 公有方法: 取款
-    bool withdraw(double amount) {
-        if (amount <= 0) {
-            std::cout << "取款金额必须为正数。" << std::endl;
+    bool withdraw(Money amount) {
+        if (!amount.isPositive()) {
+            LOG_WARN("取款金额必须为正数。");
             return false;
         }
         if (amount <= balance) {
-            balance -= amount;
-            std::cout << "取款 " << amount << " 成功。";
-            displayBalance();
+            balance = Money::fromCents(balance.cents() - amount.cents()); // 已确认 0 < amount <= balance，不会溢出
+            LOG_INFO("取款 ", amount, " 成功。当前余额: ", balance);
             return true;
         } else {
-            std::cout << "取款失败：余额不足。";
-            displayBalance();
+            LOG_WARN("取款失败：余额不足。当前余额: ", balance);
             return false;
         }
     }
 
+    // 公有方法: 批量交易
+    // 先在一个局部余额上按顺序试算整批交易 (一次校验循环，不输出任何内容)，
+    // 全部通过才写回 balance；只要有一笔被拒绝，余额保持不变。
+    // 返回的 BatchResult 用位图标出被拒绝的交易。
+    BatchResult apply(std::span<const Txn> txns) {
+        BatchResult result(txns.size());
+        Money::Cents running = balance.cents();
+        std::uint64_t anyRejected = 0;
+        for (std::size_t base = 0; base < txns.size(); base += 64) {
+            std::size_t end = std::min(txns.size(), base + 64);
+            std::uint64_t word = 0;
+            for (std::size_t i = base; i < end; ++i) {
+                word |= static_cast<std::uint64_t>(tryApplyTxn(running, txns[i])) << (i - base);
+            }
+            result.setWord(base / 64, word);
+            anyRejected |= word;
+        }
+        if (anyRejected == 0) {
+            balance = Money::fromCents(running);
+            LOG_INFO("批量交易 ", txns.size(), " 笔已提交。当前余额: ", balance);
+        } else {
+            LOG_WARN("批量交易被拒绝：", result.rejectedCount(), " 笔交易无效。当前余额: ", balance);
+        }
+        return result;
+    }
+
     // 公有方法: 获取当前余额
-    double getBalance() {
+    Money getBalance() {
         return balance;
     }
 
     // 公有方法: 显示账户信息
     void displayAccountInfo() {
-        std::cout << "-----------------------------" << std::endl;
-        std::cout << "账户持有人: " << owner << std::endl;
-        std::cout << "账户号码:   " << accountNumber << std::endl;
+        LOG_INFO("-----------------------------");
+        LOG_INFO("账户持有人: ", owner);
+        LOG_INFO("账户号码:   ", accountNumber);
         displayBalance();
-        std::cout << "-----------------------------" << std::endl;
+        LOG_INFO("-----------------------------");
     }
 
 // 私有成员: 只能在类的内部 (即被类的成员函数) 访问
 private:
     std::string accountNumber; // 账户号码
-    std::string owner;         // 账户持有人姓名
-    double balance;            // 账户余额
+    InternedString owner;      // 账户持有人姓名
+    Money balance;             // 账户余额 (以分为单位的整数，避免浮点误差)
 
     // 私有辅助方法: 格式化显示余额 (只能在类内部调用)
     void displayBalance() {
-        // std::fixed 和 std::setprecision 用于将double格式化为两位小数
-        std::cout << "当前余额: " << std::fixed << std::setprecision(2) << balance << std::endl;
+        // Money 自带两位小数的格式化，不需要 std::fixed 和 std::setprecision
+        LOG_INFO("当前余额: ", balance);
     }
 }; // 类定义结束
 
 int main() {
     // 创建一个 BankAccount 对象
-    BankAccount myAccount("123456789", "张三", 1000.50);
+    BankAccount myAccount("123456789", "张三", Money::fromCents(100050)); // 1000.50
 
     // 使用公有方法与对象交互
     myAccount.displayAccountInfo();
 
-    myAccount.deposit(500.75);
-    myAccount.withdraw(200.20);
-    myAccount.withdraw(2000.00); // 尝试取款超过余额
+    myAccount.deposit(Money::fromDouble(500.75));
+    myAccount.withdraw(Money::fromDouble(200.20));
+    myAccount.withdraw(Money::fromDouble(2000.00)); // 尝试取款超过余额
 
     // 尝试直接访问私有成员 (这将导致编译错误)
-    // myAccount.balance = 50.0; // 错误! 'balance' 是私有的
+    // myAccount.balance = Money(); // 错误! 'balance' 是私有的
     // std::cout << myAccount.accountNumber; // 错误! 'accountNumber' 是私有的
 
     // 只能通过公有方法获取信息
     std::cout << "\n通过 getBalance() 获取当前余额: "
-              << std::fixed << std::setprecision(2) << myAccount.getBalance() << std::endl;
+              << myAccount.getBalance() << std::endl;
+
+    // 批量交易: 全部成功才生效
+    std::cout << "\n--- 批量交易 ---" << std::endl;
+    Txn batch[] = {
+        {TxnType::Deposit, Money::fromCents(10000)},
+        {TxnType::Withdraw, Money::fromCents(50000)},
+        {TxnType::Withdraw, Money::fromCents(90000)},
+    };
+    BatchResult result = myAccount.apply(batch);
+    batch[2].amount = Money::fromCents(200000); // 超过余额，整批都会被拒绝
+    result = myAccount.apply(batch);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        std::cout << "  交易 " << i << (result.isRejected(i) ? ": 被拒绝" : ": 有效") << std::endl;
+    }
 
-    BankAccount anotherAccount("987654321", "李四", -100.0); // 测试初始余额为负数的情况
+    BankAccount anotherAccount("987654321", "李四", Money::fromDouble(-100.0)); // 测试初始余额为负数的情况
     anotherAccount.displayAccountInfo();
-    anotherAccount.deposit(200);
+    anotherAccount.deposit(Money::fromCents(20000));
 
+    // 生产环境可以关闭日志: 安装 NullLogSink 后，下面的调用不再产生任何输出
+    NullLogSink nullSink;
+    Log::setSink(&nullSink);
+    anotherAccount.withdraw(Money::fromCents(100));
+    Log::setSink(nullptr); // 恢复默认的控制台输出
 
     return 0;
 }
\ No newline at end of file
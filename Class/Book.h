@@ -0,0 +1,193 @@
+// Book.h
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <atomic>
+#include "Log.h"  // 日志: 类的成员函数通过 LOG_xxx 输出
+#include "InstanceCounter.h" // 线程安全的存活对象计数
+#include "BookIndex.h" // 书名/作者全文索引
+#include "InternedString.h" // 驻留字符串: 相同的书名/作者只保存一份
+
+// === Book 类定义 ===
+// 私有继承 InstanceCounter<Book>: 每个 Book 对象 (包括拷贝出来的) 构造时计数加一，析构时减一
+class Book : private InstanceCounter<Book> {
+private:
+    // 书名、作者用 InternedString 保存: 每个只占 4 字节，大量重名的作者在内存中只有一份，
+    // 拷贝 Book 时也不用复制字符串内容。
+    InternedString title;      // 书名 (私有成员)
+    InternedString author;     // 作者 (私有成员)
+    int publicationYear;     // 出版年份 (私有成员)
+    // 是否可借阅 (私有成员)。用 std::atomic 保证两个线程同时借同一本书时只有一个能成功。
+    // 多副本、排队和到期日管理见 Library.h
+    std::atomic<bool> isAvailable;
+    // 所在的全文索引 (见 BookIndex.h)。加入索引后，修改书名/作者会自动更新索引
+    BookIndex* index = nullptr;
+    BookIndex::DocId indexId = 0;
+
+    void reindex() {
+        if (index != nullptr) {
+            index->update(indexId, title, author);
+        }
+    }
+
+public:
+    // --- 1. 构造函数 (Constructors) ---
+    // 构造函数用于初始化对象。一个类可以有多个构造函数（重载）。
+
+    // (a) 默认构造函数
+    // 当不提供参数创建对象时调用。
+    Book() {
+        title = "未知书名";
+        author = "未知作者";
+        publicationYear = 0;
+        isAvailable = true;
+        LOG_TRACE("默认构造函数调用: 创建了一本空信息的书。");
+    }
+
+    // (b) 参数化构造函数
+    // 用于在创建对象时提供初始值。
+    // 参数可以是字符串字面量、std::string 或 InternedString，都会隐式转换为 InternedString。
+    Book(InternedString initialTitle, InternedString initialAuthor, int initialYear) {
+        // 使用 this 指针来区分成员变量和参数名（如果它们相同）
+        // this 指针指向调用该成员函数的对象本身。
+        this->title = initialTitle;
+        this->author = initialAuthor;
+        this->publicationYear = initialYear;
+        this->isAvailable = true;
+        LOG_TRACE("参数化构造函数调用: 《", this->title, "》 已创建。");
+    }
+
+    // (c) 拷贝构造函数与拷贝赋值
+    // std::atomic 不能拷贝，所以需要自己写: 读出原对象的状态再存入新对象。
+    // 拷贝出来的书不在任何索引中；被赋值的书如果在索引中，索引会随新内容更新。
+    Book(const Book& other)
+        : InstanceCounter<Book>(other), title(other.title), author(other.author), publicationYear(other.publicationYear),
+          isAvailable(other.isAvailable.load()) {
+        LOG_TRACE("拷贝构造函数调用: 《", title, "》 已复制。");
+    }
+
+    Book& operator=(const Book& other) {
+        if (this != &other) {
+            title = other.title;
+            author = other.author;
+            publicationYear = other.publicationYear;
+            isAvailable.store(other.isAvailable.load());
+            reindex();
+        }
+        return *this;
+    }
+
+    // --- 2. 析构函数 (Destructor) ---
+    // 当对象生命周期结束时（例如，离开作用域或被 delete），析构函数会自动调用。
+    // 通常用于释放对象占用的资源。
+    // 一个类只有一个析构函数，它没有参数，也没有返回值。
+    ~Book() {
+        // 计数器在基类 InstanceCounter 的析构函数中减少 (它在 ~Book 之后运行)
+        LOG_TRACE("析构函数调用: 《", title, "》 已被销毁。");
+        if (index != nullptr) {
+            index->remove(indexId);
+        }
+        // 如果在这里分配了动态内存（例如用 new），则应在此处用 delete 释放。
+    }
+
+    // --- 3. 成员函数 (Member Functions) ---
+
+    // (a) Setter 方法 (修改器): 用于修改私有成员变量的值
+    // InternedString 只有 4 字节，按值传递即可: 传入已驻留的字符串时不涉及任何字符串复制，
+    // 传入 std::string / 字面量时只在第一次出现该内容时复制进字符串池。
+    void setTitle(InternedString newTitle) {
+        if (!newTitle.empty()) {
+            this->title = newTitle;
+            reindex();
+        }
+    }
+
+    void setAuthor(InternedString newAuthor) {
+        if (!newAuthor.empty()) {
+            this->author = newAuthor;
+            reindex();
+        }
+    }
+
+    void setPublicationYear(int newYear) {
+        if (newYear > 0 && newYear <= 2025) { // 简单校验
+            this->publicationYear = newYear;
+        } else {
+            LOG_WARN("警告: 无效的出版年份 ", newYear);
+        }
+    }
+
+    // (b) Getter 方法 (访问器): 用于获取私有成员变量的值
+    // "const" 关键字用在成员函数末尾，表示该函数不会修改对象的任何成员变量。
+    // 这是一种良好的实践，称为 "const correctness"。
+    InternedString getTitle() const {
+        return this->title;
+    }
+
+    InternedString getAuthor() const {
+        return this->author;
+    }
+
+    int getPublicationYear() const {
+        return this->publicationYear;
+    }
+
+    bool getAvailability() const {
+        return this->isAvailable;
+    }
+
+    // (c) 其他行为方法
+    // 借书: compare_exchange_strong 只在 isAvailable 仍为 true 时把它改为 false，
+    // "检查" 和 "修改" 是一个不可分割的操作，不会出现两个人同时借到这本书。
+    void borrowBook() {
+        bool expected = true;
+        if (isAvailable.compare_exchange_strong(expected, false)) {
+            LOG_INFO("《", title, "》 已被借出。");
+        } else {
+            LOG_WARN("《", title, "》 当前不可借阅。");
+        }
+    }
+
+    void returnBook() {
+        bool expected = false;
+        if (isAvailable.compare_exchange_strong(expected, true)) {
+            LOG_INFO("《", title, "》 已被归还。");
+        } else {
+            LOG_WARN("《", title, "》 无需归还 (已在库)。");
+        }
+    }
+
+    // 加入全文索引 (一本书同一时间只在一个索引中)。索引必须比书活得久
+    void addToIndex(BookIndex& target) {
+        if (index != nullptr) {
+            index->remove(indexId);
+        }
+        index = &target;
+        indexId = target.add(title, author);
+    }
+
+    // 在索引中的编号，用于把 BookIndex::search 的结果对应回书
+    BookIndex::DocId getIndexId() const {
+        return indexId;
+    }
+
+    void displayBookInfo() const { // const 成员函数
+        LOG_INFO("\n--- 书籍信息 ---");
+        LOG_INFO("书名: ", title);
+        LOG_INFO("作者: ", author);
+        LOG_INFO("出版年份: ", publicationYear);
+        LOG_INFO("状态: ", (isAvailable.load() ? "可借阅" : "已借出"));
+        LOG_INFO("------------------");
+    }
+
+    // --- 4. 静态成员函数 (Static Member Function) ---
+    // 静态成员函数可以直接通过类名调用，而不需要创建类的对象。
+    // 它们只能访问静态成员变量或其他静态成员函数。
+    static int getBookCount() {
+        // 注意：静态成员函数没有 this 指针，因为它不与任何特定对象关联。
+        // 计数分散在每个线程各自的计数槽里，这里把它们加起来
+        return static_cast<int>(InstanceCounter<Book>::liveCount());
+    }
+};
+
+#endif // BOOK_H
@@ -0,0 +1,480 @@
+// BookIndex.h
+#ifndef BOOK_INDEX_H
+#define BOOK_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// === BookIndex (书名/作者全文索引) 类定义 ===
+// 1. 倒排索引: 每个词 (term) 对应一个按文档编号排序的倒排列表 (posting list)，记录该词在书名/作者中
+//    出现的次数 (书名中的出现按 kTitleBoost 倍计算)。多词查询要求所有词都出现 (AND)，
+//    从最短的倒排列表开始求交集，再用 BM25 打分，取分数最高的 k 本书；
+//    倒排列表分块记录分数上界，不可能进入前 k 名的块直接跳过。
+// 2. 前缀树 (trie): 所有词按字节插入一棵前缀树，每个节点缓存其子树中文档频率最高的
+//    kTopCompletions 个词，所以自动补全只需要沿前缀走到对应节点，耗时与词典大小无关。
+//    文档频率增加时只需沿路径把该词插入各节点的缓存；减少时才需要自底向上重新合并。
+//
+// 分词规则: 连续的 ASCII 字母数字或非 ASCII 字节 (例如 UTF-8 编码的汉字) 组成一个词，
+// ASCII 字母统一转成小写，其余字符作为分隔符。
+// 可以被多个线程同时查询；增删改和查询之间用读写锁互斥。
+class BookIndex {
+public:
+    using DocId = std::uint32_t;
+
+    struct Hit {
+        DocId doc;
+        double score;
+    };
+
+    struct Completion {
+        std::string term;
+        std::uint32_t docFreq; // 包含该词的书的数量
+    };
+
+    static constexpr std::size_t kTopCompletions = 8;
+    static constexpr std::uint16_t kTitleBoost = 2;   // 书名中的词比作者名中的词更重要
+    static constexpr std::size_t kMaxTermLength = 64; // 更长的词会被截断
+
+    // 加入一本书，返回它在索引中的编号 (从 0 开始递增，不会复用)
+    DocId add(std::string_view title, std::string_view author) {
+        std::unique_lock lock(mutex);
+        DocId doc = static_cast<DocId>(docs.size());
+        docs.emplace_back();
+        indexDocument(doc, title, author);
+        return doc;
+    }
+
+    // 书名或作者改变后调用: 先移除旧的词，再加入新的词
+    void update(DocId doc, std::string_view title, std::string_view author) {
+        std::unique_lock lock(mutex);
+        if (doc >= docs.size() || !docs[doc].alive) {
+            return;
+        }
+        unindexDocument(doc);
+        indexDocument(doc, title, author);
+    }
+
+    void remove(DocId doc) {
+        std::unique_lock lock(mutex);
+        if (doc >= docs.size() || !docs[doc].alive) {
+            return;
+        }
+        unindexDocument(doc);
+        docs[doc].alive = false;
+        docs[doc].terms.shrink_to_fit();
+    }
+
+    // 多词查询: 返回包含所有查询词的书，按 BM25 分数从高到低排列，最多 k 本
+    std::vector<Hit> search(std::string_view query, std::size_t k) const {
+        std::vector<TermId> queryTerms;
+        std::shared_lock lock(mutex);
+        bool missing = false;
+        tokenize(query, [&](std::string_view token) {
+            auto it = termIds.find(token);
+            if (it == termIds.end() || terms[it->second].postings.empty()) {
+                missing = true;
+            } else if (std::find(queryTerms.begin(), queryTerms.end(), it->second) == queryTerms.end()) {
+                queryTerms.push_back(it->second);
+            }
+        });
+        if (missing || queryTerms.empty() || k == 0) {
+            return {};
+        }
+        std::sort(queryTerms.begin(), queryTerms.end(), [&](TermId a, TermId b) {
+            return terms[a].postings.size() < terms[b].postings.size();
+        });
+
+        std::vector<double> idf(queryTerms.size());
+        for (std::size_t t = 0; t < queryTerms.size(); ++t) {
+            double df = static_cast<double>(terms[queryTerms[t]].postings.size());
+            idf[t] = std::log(1.0 + (static_cast<double>(liveDocs) - df + 0.5) / (df + 0.5));
+        }
+        double averageLength = liveDocs == 0 ? 1.0 : static_cast<double>(totalLength) / static_cast<double>(liveDocs);
+        auto blockBound = [&](std::size_t t, const BlockBound& block) {
+            return bm25(block.maxTf, block.minLength, averageLength, idf[t]);
+        };
+        // 除第一个词以外，其他词的分数上界之和
+        double restBound = 0;
+        for (std::size_t t = 1; t < queryTerms.size(); ++t) {
+            double termBound = 0;
+            for (const BlockBound& block : terms[queryTerms[t]].blocks) {
+                termBound = std::max(termBound, blockBound(t, block));
+            }
+            restBound += termBound;
+        }
+
+        // 小顶堆保存当前分数最高的 k 个结果
+        auto worse = [](const Hit& a, const Hit& b) { return a.score > b.score || (a.score == b.score && a.doc < b.doc); };
+        std::priority_queue<Hit, std::vector<Hit>, decltype(worse)> best(worse);
+        std::vector<std::size_t> cursor(queryTerms.size(), 0);
+        const Term& leadTerm = terms[queryTerms[0]];
+        for (std::size_t b = 0; b < leadTerm.blocks.size(); ++b) {
+            // 分数相同时编号小的书排在前面，而后面块里的书编号更大，所以上界等于门槛时也可以跳过
+            if (best.size() == k && blockBound(0, leadTerm.blocks[b]) + restBound <= best.top().score) {
+                continue;
+            }
+            std::size_t end = std::min(leadTerm.postings.size(), (b + 1) * kBlockSize);
+            for (std::size_t i = b * kBlockSize; i < end; ++i) {
+                const Posting& lead = leadTerm.postings[i];
+                double score = bm25(lead.tf, lead.length, averageLength, idf[0]);
+                bool all = true;
+                for (std::size_t t = 1; t < queryTerms.size() && all; ++t) {
+                    const std::vector<Posting>& list = terms[queryTerms[t]].postings;
+                    cursor[t] = gallop(list, cursor[t], lead.doc);
+                    all = cursor[t] < list.size() && list[cursor[t]].doc == lead.doc;
+                    if (all) {
+                        score += bm25(list[cursor[t]].tf, lead.length, averageLength, idf[t]);
+                    }
+                }
+                if (!all) {
+                    continue;
+                }
+                Hit hit{lead.doc, score};
+                if (best.size() < k) {
+                    best.push(hit);
+                } else if (worse(hit, best.top())) {
+                    best.pop();
+                    best.push(hit);
+                }
+            }
+        }
+
+        std::vector<Hit> result(best.size());
+        for (std::size_t i = result.size(); i > 0; --i) {
+            result[i - 1] = best.top();
+            best.pop();
+        }
+        return result;
+    }
+
+    // 自动补全: 返回以 prefix 开头、文档频率最高的最多 k 个词 (k 不超过 kTopCompletions)
+    std::vector<Completion> complete(std::string_view prefix, std::size_t k = kTopCompletions) const {
+        std::vector<Completion> result;
+        std::shared_lock lock(mutex);
+        std::uint32_t node = kRoot;
+        for (char c : prefix) {
+            node = child(node, static_cast<unsigned char>(toLower(c)));
+            if (node == kNoNode) {
+                return result;
+            }
+        }
+        const TrieNode& n = nodes[node];
+        for (std::size_t i = 0; i < n.topCount && i < k; ++i) {
+            result.push_back(Completion{terms[n.top[i].term].text, n.top[i].docFreq});
+        }
+        return result;
+    }
+
+    std::size_t documentCount() const {
+        std::shared_lock lock(mutex);
+        return liveDocs;
+    }
+
+    std::size_t termCount() const {
+        std::shared_lock lock(mutex);
+        return terms.size();
+    }
+
+    // 分词，对每个词调用 onToken(std::string_view)
+    template <class F>
+    static void tokenize(std::string_view text, F&& onToken) {
+        char buffer[kMaxTermLength];
+        std::size_t length = 0;
+        for (std::size_t i = 0; i <= text.size(); ++i) {
+            unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+            bool isWordByte = c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            if (isWordByte) {
+                if (length < kMaxTermLength) {
+                    buffer[length++] = toLower(static_cast<char>(c));
+                }
+            } else if (length > 0) {
+                onToken(std::string_view(buffer, length));
+                length = 0;
+            }
+        }
+    }
+
+private:
+    using TermId = std::uint32_t;
+
+    static constexpr std::uint32_t kRoot = 0;
+    static constexpr std::uint32_t kNoNode = UINT32_MAX;
+    static constexpr TermId kNoTerm = UINT32_MAX;
+
+    struct Posting {
+        DocId doc;
+        std::uint16_t tf;     // 加权后的出现次数
+        std::uint16_t length; // 该书加权后的词数 (放在这里省去查询时访问 docs)
+    };
+
+    // 倒排列表每 kBlockSize 项一块，记录块内最大的 tf 和最短的书。BM25 分数随 tf 增大、随长度减小，
+    // 所以 bm25(maxTf, minLength) 是块内所有分数的上界: 上界不超过当前第 k 名的分数时整块跳过 (block-max)。
+    static constexpr std::size_t kBlockSize = 128;
+
+    struct BlockBound {
+        std::uint16_t maxTf = 0;
+        std::uint16_t minLength = UINT16_MAX;
+    };
+
+    struct Term {
+        std::string text;
+        std::uint32_t node = 0;          // 该词在前缀树中的末尾节点
+        std::vector<Posting> postings;   // 按 doc 升序
+        std::vector<BlockBound> blocks;  // postings 的分块上界
+    };
+
+    struct Document {
+        std::uint16_t length = 0;   // 加权后的词数，用于 BM25 的长度归一化
+        bool alive = true;
+        std::vector<TermId> terms;  // 该书包含的词，更新/删除时用来找到倒排列表
+    };
+
+    // 缓存的词连同它的文档频率一起保存，比较时不用再去访问 terms (避免缓存未命中)。
+    // 一个词的文档频率变化时，所有缓存了它的节点都在 promote/demote 的路径上，会被一起更新。
+    struct Ranked {
+        std::uint32_t docFreq;
+        TermId term;
+    };
+
+    struct TrieNode {
+        std::vector<std::pair<unsigned char, std::uint32_t>> children; // 按字节排序
+        std::uint32_t parent = kNoNode;
+        TermId term = kNoTerm;      // 恰好在这个节点结束的词
+        std::uint8_t topCount = 0;
+        std::array<Ranked, kTopCompletions> top{}; // 子树中文档频率最高的词，从高到低
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    static char toLower(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    static double bm25(std::uint16_t tf, std::uint16_t length, double averageLength, double idf) {
+        constexpr double k1 = 1.2;
+        constexpr double b = 0.75;
+        double f = tf;
+        return idf * f * (k1 + 1.0) / (f + k1 * (1.0 - b + b * length / averageLength));
+    }
+
+    // 从 from 开始倍增步长，再二分，找到第一个 doc >= target 的位置
+    static std::size_t gallop(const std::vector<Posting>& list, std::size_t from, DocId target) {
+        std::size_t step = 1;
+        std::size_t high = from;
+        while (high < list.size() && list[high].doc < target) {
+            from = high + 1;
+            high += step;
+            step <<= 1;
+        }
+        high = std::min(high, list.size());
+        return static_cast<std::size_t>(std::lower_bound(list.begin() + from, list.begin() + high, target,
+            [](const Posting& p, DocId d) { return p.doc < d; }) - list.begin());
+    }
+
+    std::uint32_t docFreq(TermId term) const {
+        return static_cast<std::uint32_t>(terms[term].postings.size());
+    }
+
+    // 排序规则: 文档频率高的在前，相同时编号小的在前
+    static bool ranksBefore(const Ranked& a, const Ranked& b) {
+        return a.docFreq > b.docFreq || (a.docFreq == b.docFreq && a.term < b.term);
+    }
+
+    static std::size_t findRanked(const TrieNode& n, TermId term) {
+        std::size_t pos = 0;
+        while (pos < n.topCount && n.top[pos].term != term) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    std::uint32_t child(std::uint32_t node, unsigned char c) const {
+        const auto& children = nodes[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<unsigned char, std::uint32_t>& e, unsigned char key) { return e.first < key; });
+        return (it != children.end() && it->first == c) ? it->second : kNoNode;
+    }
+
+    // 查找或创建词条，新词插入前缀树
+    TermId internTerm(std::string_view text) {
+        auto it = termIds.find(text);
+        if (it != termIds.end()) {
+            return it->second;
+        }
+        TermId id = static_cast<TermId>(terms.size());
+        terms.push_back(Term{std::string(text), 0, {}, {}});
+        termIds.emplace(terms.back().text, id);
+        std::uint32_t node = kRoot;
+        for (char ch : text) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            std::uint32_t next = child(node, c);
+            if (next == kNoNode) {
+                next = static_cast<std::uint32_t>(nodes.size());
+                nodes.emplace_back();
+                nodes[next].parent = node;
+                auto& children = nodes[node].children;
+                auto pos = std::lower_bound(children.begin(), children.end(), c,
+                    [](const std::pair<unsigned char, std::uint32_t>& e, unsigned char key) { return e.first < key; });
+                children.insert(pos, {c, next});
+            }
+            node = next;
+        }
+        nodes[node].term = id;
+        terms[id].node = node;
+        return id;
+    }
+
+    // 以下两个函数从词末节点沿 parent 向根走。某个节点的缓存里没有这个词时，说明该子树里已经有
+    // kTopCompletions 个比它更靠前的词，祖先节点的缓存里也不会有它，可以提前停止。
+
+    // 文档频率增加: 该词只可能进入缓存或在缓存中前移，其他词的相对顺序不变
+    void promote(TermId term) {
+        Ranked entry{docFreq(term), term};
+        for (std::uint32_t node = terms[term].node; node != kNoNode; node = nodes[node].parent) {
+            TrieNode& n = nodes[node];
+            std::size_t pos = findRanked(n, term);
+            if (pos < n.topCount) {
+                n.top[pos] = entry;
+            } else if (n.topCount < kTopCompletions) {
+                pos = n.topCount++;
+                n.top[pos] = entry;
+            } else if (ranksBefore(entry, n.top[kTopCompletions - 1])) {
+                pos = kTopCompletions - 1;
+                n.top[pos] = entry;
+            } else {
+                return;
+            }
+            for (; pos > 0 && ranksBefore(n.top[pos], n.top[pos - 1]); --pos) {
+                std::swap(n.top[pos], n.top[pos - 1]);
+            }
+        }
+    }
+
+    // 文档频率减少: 自底向上，缓存里有这个词的节点用自身的词和子节点的缓存重新合并
+    void demote(TermId term) {
+        std::vector<Ranked> candidates;
+        for (std::uint32_t node = terms[term].node; node != kNoNode; node = nodes[node].parent) {
+            TrieNode& n = nodes[node];
+            if (findRanked(n, term) == n.topCount) {
+                return;
+            }
+            candidates.clear();
+            if (n.term != kNoTerm && docFreq(n.term) > 0) {
+                candidates.push_back(Ranked{docFreq(n.term), n.term});
+            }
+            for (const auto& [c, next] : n.children) {
+                const TrieNode& childNode = nodes[next];
+                candidates.insert(candidates.end(), childNode.top.begin(), childNode.top.begin() + childNode.topCount);
+            }
+            std::size_t keep = std::min(candidates.size(), kTopCompletions);
+            std::partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), ranksBefore);
+            n.topCount = static_cast<std::uint8_t>(keep);
+            std::copy(candidates.begin(), candidates.begin() + keep, n.top.begin());
+        }
+    }
+
+    static void widen(BlockBound& block, const Posting& posting) {
+        block.maxTf = std::max(block.maxTf, posting.tf);
+        block.minLength = std::min(block.minLength, posting.length);
+    }
+
+    // 在 index 处插入/删除之后，之后的元素都移动了一位，重新计算从 index 所在块开始的所有块
+    static void rebuildBlocks(Term& t, std::size_t index) {
+        std::size_t first = index / kBlockSize;
+        t.blocks.resize((t.postings.size() + kBlockSize - 1) / kBlockSize);
+        for (std::size_t b = first; b < t.blocks.size(); ++b) {
+            BlockBound bound;
+            std::size_t end = std::min(t.postings.size(), (b + 1) * kBlockSize);
+            for (std::size_t i = b * kBlockSize; i < end; ++i) {
+                widen(bound, t.postings[i]);
+            }
+            t.blocks[b] = bound;
+        }
+    }
+
+    void indexDocument(DocId doc, std::string_view title, std::string_view author) {
+        // 统计每个词的加权出现次数
+        std::vector<std::pair<TermId, std::uint32_t>> counts;
+        std::uint32_t length = 0;
+        auto count = [&](std::string_view token, std::uint32_t weight) {
+            TermId id = internTerm(token);
+            auto it = std::find_if(counts.begin(), counts.end(), [id](const auto& e) { return e.first == id; });
+            if (it == counts.end()) {
+                counts.emplace_back(id, weight);
+            } else {
+                it->second += weight;
+            }
+            length += weight;
+        };
+        tokenize(title, [&](std::string_view token) { count(token, kTitleBoost); });
+        tokenize(author, [&](std::string_view token) { count(token, 1); });
+
+        Document& d = docs[doc];
+        d.alive = true;
+        d.length = static_cast<std::uint16_t>(std::min<std::uint32_t>(length, UINT16_MAX));
+        d.terms.clear();
+        for (const auto& [term, tf] : counts) {
+            Term& t = terms[term];
+            Posting posting{doc, static_cast<std::uint16_t>(std::min<std::uint32_t>(tf, UINT16_MAX)), d.length};
+            if (t.postings.empty() || t.postings.back().doc < doc) {
+                t.postings.push_back(posting); // 新书的编号最大，通常直接追加
+                if (t.blocks.size() * kBlockSize < t.postings.size()) {
+                    t.blocks.emplace_back();
+                }
+                widen(t.blocks.back(), posting);
+            } else {
+                auto pos = std::lower_bound(t.postings.begin(), t.postings.end(), doc,
+                    [](const Posting& p, DocId id) { return p.doc < id; });
+                std::size_t index = static_cast<std::size_t>(pos - t.postings.begin());
+                t.postings.insert(pos, posting);
+                rebuildBlocks(t, index);
+            }
+            d.terms.push_back(term);
+            promote(term);
+        }
+        totalLength += d.length;
+        ++liveDocs;
+    }
+
+    void unindexDocument(DocId doc) {
+        Document& d = docs[doc];
+        for (TermId term : d.terms) {
+            Term& t = terms[term];
+            auto it = std::lower_bound(t.postings.begin(), t.postings.end(), doc,
+                [](const Posting& p, DocId id) { return p.doc < id; });
+            if (it != t.postings.end() && it->doc == doc) {
+                std::size_t index = static_cast<std::size_t>(it - t.postings.begin());
+                t.postings.erase(it);
+                rebuildBlocks(t, index);
+                demote(term);
+            }
+        }
+        d.terms.clear();
+        totalLength -= d.length;
+        --liveDocs;
+    }
+
+    mutable std::shared_mutex mutex;
+    std::vector<Document> docs;
+    std::vector<Term> terms;
+    std::unordered_map<std::string, TermId, StringHash, std::equal_to<>> termIds;
+    std::vector<TrieNode> nodes = std::vector<TrieNode>(1); // nodes[0] 是根节点
+    std::uint64_t totalLength = 0;
+    std::size_t liveDocs = 0;
+};
+
+#endif // BOOK_INDEX_H
@@ -0,0 +1,63 @@
+// Car.h
+#ifndef CAR_H
+#define CAR_H
+
+#include <type_traits>
+#include <utility>
+#include "Log.h" // 日志: 类的成员函数通过 LOG_xxx 输出
+#include "InternedString.h" // 驻留字符串: 相同的型号、颜色只保存一份
+#include "Engine.h" // Engine: 指向共享引擎规格的句柄
+
+// --- Car (汽车) 类定义 ---
+class Car {
+private:
+    // 型号和颜色的取值很少，用 InternedString 保存: 每个字段 4 字节，比较是否相同只需比较编号
+    InternedString model;  // 汽车型号
+    InternedString color;  // 汽车颜色
+    Engine carEngine;      // 对象组合: Car 类包含一个 Engine 对象作为成员 (4 字节的规格编号)
+
+public:
+    // Car 类的构造函数
+    // 参数按值传入再 std::move 到成员: 传入临时对象时直接移动，不会多拷贝一次。
+    // (这里的成员都只有 4 字节，移动和拷贝一样快；成员以后换成更大的类型时这个写法依然合适)
+    Car(InternedString carModel, InternedString carColor, Engine engineDetails)
+        : model(std::move(carModel)), color(std::move(carColor)), carEngine(std::move(engineDetails)) {
+        LOG_TRACE("Car constructor called: Model: ", model, ", Color: ", color);
+    }
+
+    // 另一个构造函数，允许直接传递引擎参数: 规格会登记到 EngineSpecRegistry (已有时直接复用)
+    Car(InternedString carModel, InternedString carColor, InternedString engineType, int engineHp)
+        : model(std::move(carModel)), color(std::move(carColor)), carEngine(std::move(engineType), engineHp) {
+         LOG_TRACE("Car constructor (with engine params) called: Model: ", model, ", Color: ", color);
+    }
+
+    InternedString getModel() const { return model; }
+    InternedString getColor() const { return color; }
+    const Engine& getEngine() const { return carEngine; }
+
+    // 启动汽车 (会调用其引擎的 start 方法)
+    void startCar() const { // const，因为它不直接修改 Car 的成员，但会调用 carEngine 的 const 方法
+        LOG_INFO(model, " is trying to start...");
+        carEngine.start(); // 调用其内部 Engine 对象的 start 方法
+    }
+
+    // 关闭汽车
+    void stopCar() const {
+        LOG_INFO(model, " is stopping...");
+        carEngine.stop();
+    }
+
+    // 显示汽车信息 (包括引擎信息)
+    void displayCarInfo() const {
+        LOG_INFO("\n--- Car Details ---");
+        LOG_INFO("Model: ", model);
+        LOG_INFO("Color: ", color);
+        carEngine.displayEngineInfo(); // 调用 Engine 对象的成员函数
+        LOG_INFO("-------------------");
+    }
+};
+
+static_assert(sizeof(Car) == 12);
+static_assert(std::is_trivially_copyable_v<Car>);
+
+#endif // CAR_H
@@ -0,0 +1,147 @@
+// Engine.h
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include "Log.h" // 日志: 类的成员函数通过 LOG_xxx 输出
+#include "InternedString.h" // 驻留字符串: 相同的型号、颜色只保存一份
+
+// --- EngineSpec (引擎规格) ---
+// 同一型号的引擎参数完全相同，成千上万辆车可以共用一份规格。规格创建后不可修改。
+struct EngineSpec {
+    InternedString type;  // 引擎类型, 例如 "V6", "Electric"
+    int horsepower = 0;   // 马力
+
+    friend bool operator==(const EngineSpec& a, const EngineSpec& b) {
+        return a.type == b.type && a.horsepower == b.horsepower;
+    }
+};
+
+template <>
+struct std::hash<EngineSpec> {
+    std::size_t operator()(const EngineSpec& spec) const noexcept {
+        return std::hash<InternedString>{}(spec.type) * 31 + static_cast<std::size_t>(spec.horsepower);
+    }
+};
+
+// --- EngineSpecRegistry (引擎规格登记表) ---
+// 享元 (flyweight) 模式: 每种不同的规格只保存一份，用一个 32 位编号引用。
+// 登记新规格时加锁 (很少发生)；按编号读取规格不加锁，规格表按块分配，已有的块不会移动。
+// 编号 0 固定是默认规格 ("Unknown", 0 马力)。
+class EngineSpecRegistry {
+public:
+    using Id = std::uint32_t;
+
+    // 进程内唯一的登记表，不销毁的理由与 InstanceCounter::registry() 相同: 其他静态对象析构时仍可能调用 Engine::spec()
+    static EngineSpecRegistry& global() {
+        static EngineSpecRegistry* instance = new EngineSpecRegistry;
+        return *instance;
+    }
+
+    // 返回规格的编号，第一次出现时登记
+    Id intern(const EngineSpec& spec) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(spec);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        Id id = nextId.load(std::memory_order_relaxed);
+        if (id >= kSpecsPerChunk * kMaxChunks) {
+            throw std::length_error("EngineSpecRegistry: too many specs");
+        }
+        specSlot(id) = spec;
+        ids.emplace(spec, id);
+        nextId.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // 编号必须来自 intern()。不加锁
+    const EngineSpec& get(Id id) const {
+        return chunks[id / kSpecsPerChunk].load(std::memory_order_acquire)[id % kSpecsPerChunk];
+    }
+
+    // 不同规格的数量 (包括默认规格)
+    std::size_t size() const { return nextId.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t kSpecsPerChunk = 4096;
+    static constexpr std::size_t kMaxChunks = 4096;
+
+    EngineSpecRegistry() {
+        intern(EngineSpec{"Unknown", 0});
+    }
+
+    // 编号所在的表项，所在块不存在时创建 (只在持有锁时调用)
+    EngineSpec& specSlot(Id id) {
+        std::atomic<EngineSpec*>& chunk = chunks[id / kSpecsPerChunk];
+        EngineSpec* specs = chunk.load(std::memory_order_relaxed);
+        if (specs == nullptr) {
+            specs = new EngineSpec[kSpecsPerChunk];
+            chunk.store(specs, std::memory_order_release);
+        }
+        return specs[id % kSpecsPerChunk];
+    }
+
+    std::mutex mutex;
+    std::unordered_map<EngineSpec, Id> ids;
+    std::atomic<Id> nextId{0};
+    std::array<std::atomic<EngineSpec*>, kMaxChunks> chunks{};
+};
+
+// --- Engine (引擎) 类定义 ---
+// Engine 只保存规格的编号 (4 字节)，类型和马力从登记表中读取。
+// 拷贝 Engine 就是拷贝编号，所有同型号的引擎共用同一份 EngineSpec。
+class Engine {
+private:
+    EngineSpecRegistry::Id specId = 0;
+
+public:
+    // 构造函数: 登记 (或找到已有的) 规格
+    Engine(InternedString engineType = "Unknown", int hp = 0)
+        : specId(EngineSpecRegistry::global().intern(EngineSpec{engineType, hp})) {
+        LOG_TRACE("Engine constructor called: Type: ", type(), ", HP: ", horsepower());
+    }
+
+    // 直接使用已经登记过的规格编号，不需要查表
+    explicit Engine(EngineSpecRegistry::Id id) : specId(id) {}
+
+    const EngineSpec& spec() const { return EngineSpecRegistry::global().get(specId); }
+    EngineSpecRegistry::Id id() const { return specId; }
+    InternedString type() const { return spec().type; }
+    int horsepower() const { return spec().horsepower; }
+
+    // 启动引擎的方法
+    void start() const { // const 因为它不修改 Engine 对象的状态
+        if (horsepower() > 0) {
+            LOG_INFO("Engine (", type(), ", ", horsepower(), "hp) started!");
+        } else {
+            LOG_WARN("Engine (", type(), ") cannot start (0 horsepower).");
+        }
+    }
+
+    // 关闭引擎的方法
+    void stop() const { // const
+        LOG_INFO("Engine (", type(), ") stopped.");
+    }
+
+    // 获取引擎信息的简单方法
+    void displayEngineInfo() const {
+        LOG_INFO("  Engine Type: ", type(), ", Horsepower: ", horsepower(), "hp");
+    }
+
+    // 同一规格的引擎编号相同
+    friend bool operator==(Engine a, Engine b) { return a.specId == b.specId; }
+};
+
+static_assert(sizeof(Engine) == 4);
+static_assert(std::is_trivially_copyable_v<Engine>);
+
+#endif // ENGINE_H
@@ -0,0 +1,463 @@
+// Fleet.h
+#ifndef FLEET_H
+#define FLEET_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// === Fleet (车队模拟引擎) 类定义 ===
+// Engine.cpp 里每个 Car 对象自己保存一个 Engine，模拟几百万辆车时这些对象分散在内存各处，
+// 每次更新都要逐个对象访问。Fleet 采用面向数据的布局:
+//  - 每辆车是一个实体 (EntityId)，它的各个属性 (引擎状态、马力、转速、油量……) 分别保存在连续的组件数组里，
+//    第 i 辆车的数据在每个数组的第 i 个位置；
+//  - 每个 "系统" 只读写自己需要的几个数组: 状态系统 (启动/熄火等状态转换)、转速系统、油耗系统；
+//  - tick() 以固定时间步长推进一步，车辆按块 (kChunkSize 辆) 分给多个工作线程，
+//    每个线程对自己领到的块依次运行三个系统 (数据还在缓存里)，各辆车之间没有依赖。
+//
+// 删除车辆时把最后一辆车移到空出的位置，组件数组始终是紧凑的。EntityId 带有代数，车辆被删除后旧的 id 失效。
+// start / stop / setThrottle 等命令和 tick 不能同时调用 (通常在两次 tick 之间由同一个线程下达)。
+class Fleet {
+public:
+    using EntityId = std::uint64_t; // 低 32 位是槽位，高 32 位是代数
+
+    enum class EngineState : std::uint8_t {
+        Off,      // 熄火
+        Starting, // 正在点火，持续 startDuration 秒后进入 Running
+        Running,
+        Stopping, // 正在熄火，转速降到很低后进入 Off
+        Stalled   // 没油熄火，加油后可以重新启动
+    };
+
+    struct Config {
+        float dt = 1.0f / 60.0f;        // 固定时间步长 (秒)
+        float idleRpm = 800.0f;         // 怠速转速
+        float maxRpm = 6500.0f;         // 油门全开时的目标转速
+        float crankRpm = 250.0f;        // 点火时的转速
+        float startDuration = 1.0f;     // 点火需要的时间 (秒)
+        float idleBurn = 0.0003f;       // 怠速油耗 (升/秒)
+        float loadBurn = 0.00004f;      // 满油门、最高转速时每马力的额外油耗 (升/秒)
+    };
+
+    // 一辆车当前的状态 (查询用的副本)
+    struct CarStatus {
+        EngineState state;
+        float horsepower;
+        float rpm;
+        float throttle;
+        float fuel;
+    };
+
+    // 各个系统累计耗用的时间 (所有线程的时间之和，单位秒)
+    struct SystemTimings {
+        double state = 0;
+        double rpm = 0;
+        double fuel = 0;
+    };
+
+    static constexpr std::size_t kChunkSize = 16384;
+
+    // threads 为 0 时使用 std::thread::hardware_concurrency() 个线程 (包括调用 tick 的线程)
+    explicit Fleet(unsigned threads = 0) : Fleet(Config{}, threads) {}
+
+    Fleet(Config config, unsigned threads) : config(config) {
+        unsigned threadCount = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+        timings = std::vector<ThreadTimings>(threadCount);
+        for (unsigned t = 1; t < threadCount; ++t) {
+            workers.emplace_back([this, t] { workerLoop(t); });
+        }
+    }
+
+    ~Fleet() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shuttingDown = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    Fleet(const Fleet&) = delete;
+    Fleet& operator=(const Fleet&) = delete;
+
+    // --- 实体管理 ---
+
+    EntityId addCar(float horsepower, float fuel) {
+        if (horsepower <= 0 || fuel < 0) {
+            throw std::invalid_argument("Fleet: horsepower must be positive and fuel non-negative");
+        }
+        std::uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            if (slotGeneration.size() >= UINT32_MAX) {
+                throw std::length_error("Fleet: too many cars");
+            }
+            slot = static_cast<std::uint32_t>(slotGeneration.size());
+            slotGeneration.push_back(0);
+            slotToDense.push_back(0);
+        }
+        slotToDense[slot] = static_cast<std::uint32_t>(denseToSlot.size());
+        denseToSlot.push_back(slot);
+        states.push_back(EngineState::Off);
+        horsepowers.push_back(horsepower);
+        // 马力越大转速变化越快: 每秒接近目标转速的比例在 0.5 到 4 之间
+        responses.push_back(std::min(1.0f, std::clamp(horsepower / 150.0f, 0.5f, 4.0f) * config.dt));
+        rpms.push_back(0.0f);
+        throttles.push_back(0.0f);
+        fuels.push_back(fuel);
+        timers.push_back(0.0f);
+        return makeId(slot, slotGeneration[slot]);
+    }
+
+    bool removeCar(EntityId id) {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index) {
+            return false;
+        }
+        std::uint32_t last = static_cast<std::uint32_t>(denseToSlot.size() - 1);
+        std::uint32_t slot = denseToSlot[*index];
+        moveLast(*index, last);
+        ++slotGeneration[slot]; // 旧的 id 失效
+        freeSlots.push_back(slot);
+        return true;
+    }
+
+    bool contains(EntityId id) const { return denseIndex(id).has_value(); }
+    std::size_t size() const { return denseToSlot.size(); }
+    const Config& configuration() const { return config; }
+    unsigned threadCount() const { return static_cast<unsigned>(timings.size()); }
+
+    std::optional<CarStatus> status(EntityId id) const {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index) {
+            return std::nullopt;
+        }
+        std::uint32_t i = *index;
+        return CarStatus{states[i], horsepowers[i], rpms[i], throttles[i], fuels[i]};
+    }
+
+    // --- 命令 ---
+
+    // 熄火或没油熄火 (已经加过油) 的车开始点火
+    bool start(EntityId id) {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index || fuels[*index] <= 0.0f
+            || (states[*index] != EngineState::Off && states[*index] != EngineState::Stalled)) {
+            return false;
+        }
+        states[*index] = EngineState::Starting;
+        timers[*index] = 0.0f;
+        return true;
+    }
+
+    bool stop(EntityId id) {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index || (states[*index] != EngineState::Starting && states[*index] != EngineState::Running)) {
+            return false;
+        }
+        states[*index] = EngineState::Stopping;
+        return true;
+    }
+
+    // 油门开度，限制在 0 到 1 之间
+    bool setThrottle(EntityId id, float throttle) {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index) {
+            return false;
+        }
+        throttles[*index] = std::clamp(throttle, 0.0f, 1.0f);
+        return true;
+    }
+
+    bool refuel(EntityId id, float litres) {
+        std::optional<std::uint32_t> index = denseIndex(id);
+        if (!index || litres < 0) {
+            return false;
+        }
+        fuels[*index] += litres;
+        return true;
+    }
+
+    // 对所有车下达同样的命令 (批量初始化时比逐个查 id 快)
+    void startAll() {
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (fuels[i] > 0.0f && (states[i] == EngineState::Off || states[i] == EngineState::Stalled)) {
+                states[i] = EngineState::Starting;
+                timers[i] = 0.0f;
+            }
+        }
+    }
+
+    // --- 模拟 ---
+
+    // 推进一个时间步长
+    void tick() {
+        std::size_t chunkCount = (size() + kChunkSize - 1) / kChunkSize;
+        auto start = std::chrono::steady_clock::now();
+        if (workers.empty() || chunkCount <= 1) {
+            for (std::size_t c = 0; c < chunkCount; ++c) {
+                runChunk(c, timings[0]);
+            }
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobChunks = chunkCount;
+                nextChunk.store(0, std::memory_order_relaxed);
+                busyWorkers = workers.size();
+                ++epoch;
+            }
+            wake.notify_all();
+            runChunks(timings[0]); // 当前线程也参与
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [this] { return busyWorkers == 0; });
+        }
+        wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ++tickCount;
+    }
+
+    void run(std::size_t ticks) {
+        for (std::size_t i = 0; i < ticks; ++i) {
+            tick();
+        }
+    }
+
+    std::uint64_t ticks() const { return tickCount; }
+    double simulatedSeconds() const { return static_cast<double>(tickCount) * config.dt; }
+    double elapsedSeconds() const { return wallSeconds; } // tick() 累计耗用的真实时间
+
+    SystemTimings systemTimings() const {
+        SystemTimings total;
+        for (const ThreadTimings& t : timings) {
+            total.state += t.state;
+            total.rpm += t.rpm;
+            total.fuel += t.fuel;
+        }
+        return total;
+    }
+
+    // --- 统计 ---
+
+    std::size_t countInState(EngineState state) const {
+        return static_cast<std::size_t>(std::count(states.begin(), states.end(), state));
+    }
+
+    double totalFuel() const {
+        double total = 0;
+        for (float f : fuels) {
+            total += f;
+        }
+        return total;
+    }
+
+    double averageRpm() const {
+        double total = 0;
+        for (float r : rpms) {
+            total += r;
+        }
+        return rpms.empty() ? 0.0 : total / static_cast<double>(rpms.size());
+    }
+
+private:
+    struct alignas(64) ThreadTimings {
+        double state = 0;
+        double rpm = 0;
+        double fuel = 0;
+    };
+
+    static EntityId makeId(std::uint32_t slot, std::uint32_t generation) {
+        return (static_cast<EntityId>(generation) << 32) | slot;
+    }
+
+    std::optional<std::uint32_t> denseIndex(EntityId id) const {
+        std::uint32_t slot = static_cast<std::uint32_t>(id);
+        if (slot >= slotGeneration.size() || slotGeneration[slot] != static_cast<std::uint32_t>(id >> 32)
+            || slotToDense[slot] >= denseToSlot.size() || denseToSlot[slotToDense[slot]] != slot) {
+            return std::nullopt;
+        }
+        return slotToDense[slot];
+    }
+
+    // 把最后一辆车的组件移到 index，然后删掉最后一个位置
+    void moveLast(std::uint32_t index, std::uint32_t last) {
+        if (index != last) {
+            states[index] = states[last];
+            horsepowers[index] = horsepowers[last];
+            responses[index] = responses[last];
+            rpms[index] = rpms[last];
+            throttles[index] = throttles[last];
+            fuels[index] = fuels[last];
+            timers[index] = timers[last];
+            denseToSlot[index] = denseToSlot[last];
+            slotToDense[denseToSlot[index]] = index;
+        }
+        states.pop_back();
+        horsepowers.pop_back();
+        responses.pop_back();
+        rpms.pop_back();
+        throttles.pop_back();
+        fuels.pop_back();
+        timers.pop_back();
+        denseToSlot.pop_back();
+    }
+
+    // --- 系统 ---
+    // 每个系统处理 [begin, end) 范围内的车，只访问自己需要的组件数组。
+
+    // 状态转换: 点火完成、没油熄火、熄火完成
+    void stateSystem(std::size_t begin, std::size_t end) {
+        const float dt = config.dt;
+        for (std::size_t i = begin; i < end; ++i) {
+            switch (states[i]) {
+                case EngineState::Starting:
+                    timers[i] += dt;
+                    if (fuels[i] <= 0.0f) {
+                        states[i] = EngineState::Stalled;
+                    } else if (timers[i] >= config.startDuration) {
+                        states[i] = EngineState::Running;
+                    }
+                    break;
+                case EngineState::Running:
+                    if (fuels[i] <= 0.0f) {
+                        states[i] = EngineState::Stalled;
+                    }
+                    break;
+                case EngineState::Stopping:
+                    if (rpms[i] < 50.0f) {
+                        states[i] = EngineState::Off;
+                        rpms[i] = 0.0f;
+                    }
+                    break;
+                case EngineState::Stalled:
+                    // 与熄火相同: 转速只会按比例衰减，低于 50 时直接归零
+                    if (rpms[i] < 50.0f) {
+                        rpms[i] = 0.0f;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // 转速按一阶响应接近目标转速: 运行时由油门决定，点火时是点火转速，其他状态为 0。
+    // 用 -O3 编译时 (见 fleet_bench.cpp) 转速和油耗系统会被向量化，每条指令处理多辆车。
+    // 浮点数的 ?: 在默认的 -ftrapping-math 下会留下分支 (循环就不能向量化)，所以目标转速用整数掩码选择
+    void rpmSystem(std::size_t begin, std::size_t end) {
+        const float idle = config.idleRpm;
+        const float range = config.maxRpm - config.idleRpm;
+        const float crank = config.crankRpm;
+        const EngineState* state = states.data();
+        const float* throttle = throttles.data();
+        const float* response = responses.data();
+        float* rpm = rpms.data();
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t isRunning = 0u - static_cast<std::uint32_t>(state[i] == EngineState::Running);
+            std::uint32_t isStarting = 0u - static_cast<std::uint32_t>(state[i] == EngineState::Starting);
+            float running = idle + throttle[i] * range;
+            float target = std::bit_cast<float>((std::bit_cast<std::uint32_t>(running) & isRunning) |
+                                                (std::bit_cast<std::uint32_t>(crank) & isStarting));
+            rpm[i] += (target - rpm[i]) * response[i];
+        }
+    }
+
+    // 油耗 = 怠速油耗 (随转速变化) + 负载油耗 (随马力、油门、转速变化)
+    void fuelSystem(std::size_t begin, std::size_t end) {
+        const float idleFactor = config.idleBurn * config.dt / config.idleRpm;
+        const float loadFactor = config.loadBurn * config.dt / config.maxRpm;
+        for (std::size_t i = begin; i < end; ++i) {
+            float burn = rpms[i] * (idleFactor + loadFactor * horsepowers[i] * throttles[i]);
+            fuels[i] = std::max(0.0f, fuels[i] - burn);
+        }
+    }
+
+    void runChunk(std::size_t chunk, ThreadTimings& timing) {
+        std::size_t begin = chunk * kChunkSize;
+        std::size_t end = std::min(size(), begin + kChunkSize);
+        auto t0 = std::chrono::steady_clock::now();
+        stateSystem(begin, end);
+        auto t1 = std::chrono::steady_clock::now();
+        rpmSystem(begin, end);
+        auto t2 = std::chrono::steady_clock::now();
+        fuelSystem(begin, end);
+        auto t3 = std::chrono::steady_clock::now();
+        timing.state += std::chrono::duration<double>(t1 - t0).count();
+        timing.rpm += std::chrono::duration<double>(t2 - t1).count();
+        timing.fuel += std::chrono::duration<double>(t3 - t2).count();
+    }
+
+    // 不断领取下一块，直到所有块都被领完
+    void runChunks(ThreadTimings& timing) {
+        for (std::size_t c = nextChunk.fetch_add(1, std::memory_order_relaxed); c < jobChunks;
+             c = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+            runChunk(c, timing);
+        }
+    }
+
+    // 工作线程: 等待下一次 tick (epoch 变化)，处理完后通知 tick
+    void workerLoop(unsigned index) {
+        std::uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return shuttingDown || epoch != seen; });
+                if (shuttingDown) {
+                    return;
+                }
+                seen = epoch;
+            }
+            runChunks(timings[index]);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyWorkers == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+    Config config;
+
+    // 组件数组 (第 i 个元素属于第 i 辆车)
+    std::vector<EngineState> states;
+    std::vector<float> horsepowers;
+    std::vector<float> responses;   // 每个时间步转速接近目标的比例，由马力决定
+    std::vector<float> rpms;
+    std::vector<float> throttles;
+    std::vector<float> fuels;       // 剩余油量 (升)
+    std::vector<float> timers;      // 点火已经持续的时间
+
+    // EntityId <-> 数组下标
+    std::vector<std::uint32_t> denseToSlot;
+    std::vector<std::uint32_t> slotToDense;
+    std::vector<std::uint32_t> slotGeneration;
+    std::vector<std::uint32_t> freeSlots;
+
+    // 工作线程
+    std::vector<std::thread> workers;
+    std::vector<ThreadTimings> timings; // 每个线程一份，避免共享缓存行
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::uint64_t epoch = 0;
+    std::size_t busyWorkers = 0;
+    std::size_t jobChunks = 0;
+    std::atomic<std::size_t> nextChunk{0};
+    bool shuttingDown = false;
+
+    std::uint64_t tickCount = 0;
+    double wallSeconds = 0;
+};
+
+#endif // FLEET_H
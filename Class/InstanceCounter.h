@@ -0,0 +1,125 @@
+// InstanceCounter.h
+#ifndef INSTANCE_COUNTER_H
+#define INSTANCE_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// === InstanceCounter (存活对象计数) ===
+// 用法: class Book : private InstanceCounter<Book> { ... };
+// 之后 InstanceCounter<Book>::liveCount() 返回当前存活的 Book 对象数量。
+//
+// static int 计数器在多线程下是数据竞争；改成一个 std::atomic 虽然正确，但所有线程的构造/析构
+// 都在同一条缓存行上做 lock 加减，线程越多越慢。这里每个线程有自己的计数槽 (独占一条缓存行)，
+// 构造/析构只修改本线程的槽，不需要原子读-改-写；读取时再把所有槽加起来。
+// 对象可以在一个线程创建、另一个线程销毁: 单个槽的值可能为负，但总和始终正确。
+//
+// 每个类型 T 有独立的一组计数槽。拷贝和移动构造也算新对象，赋值不改变数量。
+template <class T>
+class InstanceCounter {
+public:
+    // 当前存活的对象数量。需要加锁遍历所有槽，适合偶尔读取，不要放在热点路径上
+    static std::int64_t liveCount() {
+        return registry().sum();
+    }
+
+protected:
+    InstanceCounter() noexcept { add(1); }
+    InstanceCounter(const InstanceCounter&) noexcept { add(1); }
+    InstanceCounter(InstanceCounter&&) noexcept { add(1); }
+    InstanceCounter& operator=(const InstanceCounter&) noexcept { return *this; }
+    InstanceCounter& operator=(InstanceCounter&&) noexcept { return *this; }
+    ~InstanceCounter() { add(-1); }
+
+private:
+    // 一个线程的计数槽。只有所属线程写 value，读取方用 relaxed load，所以不需要 lock 前缀
+    struct alignas(64) Slot {
+        std::atomic<std::int64_t> value{0};
+        bool inUse = false;
+    };
+
+    // 管理所有槽。线程退出时把它的计数并入 retired，并把槽放回空闲列表供新线程复用，
+    // 所以频繁创建线程也不会让槽的数量无限增长。
+    class Registry {
+    public:
+        Slot* acquire() {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (Slot* slot : slots) {
+                if (!slot->inUse) {
+                    slot->inUse = true;
+                    return slot;
+                }
+            }
+            Slot* slot = new Slot;
+            slot->inUse = true;
+            slots.push_back(slot);
+            return slot;
+        }
+
+        void release(Slot* slot) {
+            std::lock_guard<std::mutex> lock(mutex);
+            retired.fetch_add(slot->value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            slot->value.store(0, std::memory_order_relaxed);
+            slot->inUse = false;
+        }
+
+        // 线程的槽已经释放之后 (例如 thread_local 析构之后才销毁的静态对象) 直接修改 retired
+        void addRetired(std::int64_t delta) {
+            retired.fetch_add(delta, std::memory_order_relaxed);
+        }
+
+        std::int64_t sum() {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::int64_t total = retired.load(std::memory_order_relaxed);
+            for (const Slot* slot : slots) {
+                total += slot->value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+    private:
+        std::mutex mutex;
+        std::vector<Slot*> slots;
+        std::atomic<std::int64_t> retired{0};
+    };
+
+    // 用 new 创建、从不 delete (进程退出时由操作系统回收)。不同编译单元的静态对象析构顺序不确定，
+    // 如果这里是普通的静态对象，它可能先于被计数的全局对象析构，而那些对象析构时还会调用 add()。
+    static Registry& registry() {
+        static Registry* instance = new Registry;
+        return *instance;
+    }
+
+    // 线程退出时归还本线程的槽
+    struct SlotReleaser {
+        ~SlotReleaser() {
+            if (localSlot != nullptr) {
+                registry().release(localSlot);
+                localSlot = nullptr;
+            }
+            threadExited = true;
+        }
+    };
+
+    static void add(std::int64_t delta) noexcept {
+        Slot* slot = localSlot;
+        if (slot == nullptr) [[unlikely]] {
+            if (threadExited) {
+                registry().addRetired(delta);
+                return;
+            }
+            slot = localSlot = registry().acquire();
+            thread_local SlotReleaser releaser;
+            (void)releaser;
+        }
+        slot->value.store(slot->value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    // 平凡类型的 thread_local 没有析构函数，SlotReleaser 析构之后仍然可以安全访问
+    static inline thread_local Slot* localSlot = nullptr;
+    static inline thread_local bool threadExited = false;
+};
+
+#endif // INSTANCE_COUNTER_H
@@ -0,0 +1,208 @@
+// InternedString.h
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// === StringPool (全局字符串池) ===
+// 每个不同的字符串只保存一份，用一个 32 位编号表示。字符串一旦加入就不再移动、也不会被释放，
+// 所以编号 -> 字符串的查询不需要加锁 (只是两次数组访问)。
+//  - 编号表按块分配，块指针是原子变量，追加新字符串时已有的块不会移动；
+//  - 字符串 -> 编号的哈希表按哈希值分成多个分片，每个分片有自己的锁和内存块，
+//    不同线程加入不同的字符串时基本不会争用同一把锁。
+// 编号 0 固定表示空字符串。
+class StringPool {
+public:
+    using Id = std::uint32_t;
+
+    // 进程内唯一的字符串池，永不销毁: 程序退出时析构的全局对象可能还持有 InternedString (日志、书名等)
+    static StringPool& global() {
+        static StringPool* instance = new StringPool;
+        return *instance;
+    }
+
+    // 返回字符串的编号，第一次出现时把它复制进池中
+    Id intern(std::string_view text) {
+        if (text.empty()) {
+            return 0;
+        }
+        std::size_t hash = std::hash<std::string_view>{}(text);
+        Shard& shard = shards[(hash >> 7) % kShardCount]; // 低位留给分片内的哈希表使用
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ids.find(text);
+        if (it != shard.ids.end()) {
+            return it->second;
+        }
+        if (text.size() > UINT32_MAX) {
+            throw std::length_error("StringPool: string too long");
+        }
+        // 先检查再递增: fetch_add 到 2^32 会回绕到 0，覆盖空字符串的表项
+        Id id = nextId.load(std::memory_order_relaxed);
+        do {
+            if (id == kMaxIds) {
+                throw std::length_error("StringPool: too many strings");
+            }
+        } while (!nextId.compare_exchange_weak(id, id + 1, std::memory_order_relaxed));
+        const char* stored = shard.copy(text);
+        entrySlot(id) = Entry{stored, static_cast<std::uint32_t>(text.size())};
+        // 其他线程从哈希表里查到这个编号时也持有同一把锁，所以一定能看到上面写入的 Entry
+        shard.ids.emplace(std::string_view(stored, text.size()), id);
+        shard.bytes += text.size() + 1;
+        return id;
+    }
+
+    // 编号必须来自 intern()。不加锁
+    std::string_view view(Id id) const {
+        const Entry& entry = chunks[id / kEntriesPerChunk].load(std::memory_order_acquire)[id % kEntriesPerChunk];
+        return std::string_view(entry.data, entry.size);
+    }
+
+    // 以 '\0' 结尾的字符串
+    const char* c_str(Id id) const {
+        return chunks[id / kEntriesPerChunk].load(std::memory_order_acquire)[id % kEntriesPerChunk].data;
+    }
+
+    // 不同字符串的数量 (包括空字符串)
+    std::size_t size() const {
+        return nextId.load(std::memory_order_relaxed);
+    }
+
+    // 字符串内容占用的字节数
+    std::size_t bytesUsed() {
+        std::size_t total = 0;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.bytes;
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::size_t kShardCount = 64;
+    static constexpr std::size_t kEntriesPerChunk = std::size_t{1} << 16;
+    static constexpr std::size_t kMaxChunks = std::size_t{1} << 16;
+    static constexpr std::size_t kBlockSize = 64 * 1024;
+    // 编号计数器的上限 (计数器本身是 Id，不能达到 kEntriesPerChunk * kMaxChunks = 2^32)
+    static constexpr Id kMaxIds = UINT32_MAX;
+
+    struct Entry {
+        const char* data;
+        std::uint32_t size;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string_view, Id> ids;
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char* cursor = nullptr;
+        std::size_t remaining = 0;
+        std::size_t bytes = 0;
+
+        // 复制到本分片的内存块中 (末尾加 '\0')，超过块大小四分之一的字符串单独分配
+        const char* copy(std::string_view text) {
+            std::size_t need = text.size() + 1;
+            char* out;
+            if (need > kBlockSize / 4) {
+                blocks.push_back(std::make_unique<char[]>(need));
+                out = blocks.back().get();
+            } else {
+                if (need > remaining) {
+                    blocks.push_back(std::make_unique<char[]>(kBlockSize));
+                    cursor = blocks.back().get();
+                    remaining = kBlockSize;
+                }
+                out = cursor;
+                cursor += need;
+                remaining -= need;
+            }
+            std::memcpy(out, text.data(), text.size());
+            out[text.size()] = '\0';
+            return out;
+        }
+    };
+
+    StringPool() {
+        entrySlot(0) = Entry{"", 0};
+    }
+
+    // 编号所在的表项，所在块不存在时用 CAS 创建 (失败的一方释放自己分配的块)
+    Entry& entrySlot(Id id) {
+        std::atomic<Entry*>& chunk = chunks[id / kEntriesPerChunk];
+        Entry* entries = chunk.load(std::memory_order_acquire);
+        if (entries == nullptr) {
+            Entry* fresh = new Entry[kEntriesPerChunk]();
+            if (chunk.compare_exchange_strong(entries, fresh, std::memory_order_acq_rel)) {
+                entries = fresh;
+            } else {
+                delete[] fresh;
+            }
+        }
+        return entries[id % kEntriesPerChunk];
+    }
+
+    std::array<Shard, kShardCount> shards;
+    std::atomic<Id> nextId{1};
+    std::array<std::atomic<Entry*>, kMaxChunks> chunks{};
+};
+
+// === InternedString (驻留字符串) ===
+// 4 字节的不可变字符串句柄，内容保存在 StringPool::global() 中。
+//  - 相同内容的字符串编号相同，所以 == 只比较编号，是 O(1) 的；
+//  - 拷贝、赋值、移动都只是复制 4 个字节，大量重复的作者名、颜色只占一份内存；
+//  - 构造时需要查一次哈希表 (已存在时不复制内容)，适合 "写少读多" 的字段。
+// 可以隐式地从字符串构造，也可以隐式地转换为 std::string_view。
+class InternedString {
+public:
+    InternedString() = default;
+    InternedString(std::string_view text) : id(StringPool::global().intern(text)) {}
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    std::string_view view() const { return StringPool::global().view(id); }
+    const char* c_str() const { return StringPool::global().c_str(id); }
+    std::string str() const { return std::string(view()); }
+    operator std::string_view() const { return view(); }
+
+    std::size_t size() const { return view().size(); }
+    bool empty() const { return id == 0; }
+    StringPool::Id poolId() const { return id; }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.id == b.id; }
+
+    // 按内容比较 (字典序)，用于排序
+    friend bool operator<(InternedString a, InternedString b) {
+        return a.id != b.id && a.view() < b.view();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, InternedString s) {
+        return os << s.view();
+    }
+
+private:
+    StringPool::Id id = 0;
+};
+
+template <>
+struct std::hash<InternedString> {
+    std::size_t operator()(InternedString s) const noexcept {
+        return std::hash<std::uint32_t>{}(s.poolId());
+    }
+};
+
+static_assert(sizeof(InternedString) == 4);
+
+#endif // INTERNED_STRING_H
@@ -0,0 +1,300 @@
+// Ledger.h
+#ifndef LEDGER_H
+#define LEDGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Money.h"
+#include "Txn.h"
+
+// 跨账户的一笔交易 (用于 Ledger::applyBatch)
+// accountNumber 只是一个视图，调用 applyBatch 期间它指向的字符串必须有效。
+struct LedgerTxn {
+    std::string_view accountNumber;
+    Txn txn;
+};
+
+// === LedgerJournal (账本日志接口) ===
+// Ledger 每次成功修改账户后，在仍然持有分片锁的情况下调用日志接口，
+// 这样日志中同一分片的记录顺序与实际修改顺序一致 (见 LedgerStore.h 中的预写日志)。
+class LedgerJournal {
+public:
+    virtual ~LedgerJournal() = default;
+    virtual void recordOpen(std::string_view accNum, std::string_view ownerName, Money initialBalance) = 0;
+    // delta 为正表示存款，为负表示取款
+    virtual void recordChange(std::string_view accNum, Money delta) = 0;
+    // 一个已提交的批次 (见 Ledger::applyBatch)。整批作为一个单元记录，恢复时要么全部重放，要么全部丢弃。
+    virtual void recordBatch(std::span<const LedgerTxn> txns) = 0;
+};
+
+// === Ledger (分片账本) 类定义 ===
+// 账户规则与 BankAccount 相同：存取款金额必须为正数，余额不足时取款失败，
+// 初始余额为负时按 0 处理。不同之处在于 Ledger 可以被多个线程同时调用：
+//  - 账户按 accountNumber 的哈希值分散到多个分片 (shard) 中；
+//  - 开户和批量交易需要拿到分片的写锁，单笔存取款只需要分片的读锁；
+//  - 余额以 Money 的 "分" 保存在原子整数里，存取款用原子操作完成，不需要互斥锁。
+// 这样不同线程操作不同分片时互不干扰，同一分片上的读者也不会互相阻塞。
+// 单笔存取款在整个原子操作期间都持有读锁，所以批量交易拿到写锁后，
+// 涉及的账户不会再被其他线程修改，可以 "全有或全无" 地提交。
+class Ledger {
+public:
+    // 分片数量会被向上取整为 2 的幂，方便用位运算代替取模
+    explicit Ledger(std::size_t shardCount = 256) {
+        std::size_t count = 1;
+        while (count < shardCount) {
+            count <<= 1;
+        }
+        shardMask = count - 1;
+        shards = std::make_unique<Shard[]>(count);
+    }
+
+    // 账户号码和持有人姓名的最大长度 (字节)，日志记录用 16 位整数保存它们的长度
+    static constexpr std::size_t kMaxNameLength = 0xFFFF;
+
+    // 开户: 账户号码已存在、账户号码或姓名超过 kMaxNameLength 时返回 false
+    bool openAccount(const std::string& accNum, const std::string& ownerName, Money initialBalance) {
+        if (accNum.size() > kMaxNameLength || ownerName.size() > kMaxNameLength) {
+            return false;
+        }
+        Shard& shard = shardFor(accNum);
+        std::unique_lock lock(shard.mutex);
+        auto [it, inserted] = shard.accounts.try_emplace(accNum);
+        if (!inserted) {
+            return false;
+        }
+        it->second = std::make_unique<Account>(ownerName, initialBalance.isNegative() ? Money() : initialBalance);
+        if (journal != nullptr) {
+            journal->recordOpen(accNum, ownerName, Money::fromCents(it->second->balance.load(std::memory_order_relaxed)));
+        }
+        return true;
+    }
+
+    // 存款: 账户不存在、金额不为正数或余额溢出时返回 false
+    bool deposit(const std::string& accNum, Money amount) {
+        if (!amount.isPositive()) {
+            return false;
+        }
+        Shard& shard = shardFor(accNum);
+        std::shared_lock lock(shard.mutex);
+        Account* account = find(shard, accNum);
+        if (account == nullptr) {
+            return false;
+        }
+        Money::Cents current = account->balance.load(std::memory_order_relaxed);
+        while (true) {
+            std::optional<Money> next = Money::fromCents(current).checkedAdd(amount);
+            if (!next) {
+                return false;
+            }
+            if (account->balance.compare_exchange_weak(current, next->cents(), std::memory_order_relaxed)) {
+                if (journal != nullptr) {
+                    journal->recordChange(accNum, amount);
+                }
+                return true;
+            }
+        }
+    }
+
+    // 取款: 用 compare_exchange 循环保证 "检查余额" 和 "扣款" 是一个原子步骤，
+    // 两个线程同时取款时不会把余额扣成负数。
+    bool withdraw(const std::string& accNum, Money amount) {
+        if (!amount.isPositive()) {
+            return false;
+        }
+        Shard& shard = shardFor(accNum);
+        std::shared_lock lock(shard.mutex);
+        Account* account = find(shard, accNum);
+        if (account == nullptr) {
+            return false;
+        }
+        Money::Cents current = account->balance.load(std::memory_order_relaxed);
+        while (amount.cents() <= current) {
+            // 0 < amount <= current，相减不会溢出
+            if (account->balance.compare_exchange_weak(current, current - amount.cents(), std::memory_order_relaxed)) {
+                if (journal != nullptr) {
+                    journal->recordChange(accNum, Money::fromCents(-amount.cents()));
+                }
+                return true;
+            }
+            // 失败时 current 已被更新为最新余额，重新检查即可
+        }
+        return false; // 余额不足
+    }
+
+    // 查询余额: 账户不存在时返回 std::nullopt
+    std::optional<Money> getBalance(const std::string& accNum) const {
+        Shard& shard = shardFor(accNum);
+        std::shared_lock lock(shard.mutex);
+        const Account* account = find(shard, accNum);
+        if (account == nullptr) {
+            return std::nullopt;
+        }
+        return Money::fromCents(account->balance.load(std::memory_order_relaxed));
+    }
+
+    // 批量交易 (跨账户，全有或全无)
+    //  1. 按分片编号从小到大拿到所有涉及分片的写锁 (固定顺序，避免两个批次互相死锁)；
+    //  2. 把每笔交易映射到一个局部余额槽位，在局部余额上按顺序试算整批交易；
+    //  3. 没有任何交易被拒绝时，才把局部余额写回账户。
+    // 返回的 BatchResult 用位图标出被拒绝的交易 (包括账户不存在的交易)。
+    BatchResult applyBatch(std::span<const LedgerTxn> txns) {
+        BatchResult result(txns.size());
+
+        std::vector<std::size_t> shardOfTxn(txns.size());
+        std::vector<bool> touched(shardCount(), false);
+        for (std::size_t i = 0; i < txns.size(); ++i) {
+            shardOfTxn[i] = shardIndex(txns[i].accountNumber);
+            touched[shardOfTxn[i]] = true;
+        }
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+        for (std::size_t i = 0; i < touched.size(); ++i) {
+            if (touched[i]) {
+                locks.emplace_back(shards[i].mutex);
+            }
+        }
+
+        // 槽位 0 留给不存在的账户: 它的试算结果会被丢弃，交易本身被标记为拒绝
+        std::vector<Account*> slotAccounts{nullptr};
+        std::vector<Money::Cents> slotBalances{0};
+        std::unordered_map<Account*, std::uint32_t> slotOfAccount;
+        std::vector<std::uint32_t> slotOfTxn(txns.size());
+        for (std::size_t i = 0; i < txns.size(); ++i) {
+            Account* account = find(shards[shardOfTxn[i]], txns[i].accountNumber);
+            if (account == nullptr) {
+                slotOfTxn[i] = 0;
+                continue;
+            }
+            auto [it, inserted] = slotOfAccount.try_emplace(account, static_cast<std::uint32_t>(slotAccounts.size()));
+            if (inserted) {
+                slotAccounts.push_back(account);
+                slotBalances.push_back(account->balance.load(std::memory_order_relaxed));
+            }
+            slotOfTxn[i] = it->second;
+        }
+
+        // 唯一的校验循环: 每 64 笔交易拼成一个位图字
+        std::uint64_t anyRejected = 0;
+        for (std::size_t base = 0; base < txns.size(); base += 64) {
+            std::size_t end = std::min(txns.size(), base + 64);
+            std::uint64_t word = 0;
+            for (std::size_t i = base; i < end; ++i) {
+                std::uint32_t slot = slotOfTxn[i];
+                bool rejected = tryApplyTxn(slotBalances[slot], txns[i].txn) | (slot == 0);
+                word |= static_cast<std::uint64_t>(rejected) << (i - base);
+            }
+            result.setWord(base / 64, word);
+            anyRejected |= word;
+        }
+
+        if (anyRejected == 0) {
+            for (std::size_t slot = 1; slot < slotAccounts.size(); ++slot) {
+                slotAccounts[slot]->balance.store(slotBalances[slot], std::memory_order_relaxed);
+            }
+            if (journal != nullptr && !txns.empty()) {
+                journal->recordBatch(txns);
+            }
+        }
+        return result;
+    }
+
+    // 直接调整余额，不做任何校验，也不写日志。只用于从日志恢复 (重放已经成功过的修改)。
+    bool adjustBalance(std::string_view accNum, Money delta) {
+        Shard& shard = shardFor(accNum);
+        std::shared_lock lock(shard.mutex);
+        Account* account = find(shard, accNum);
+        if (account == nullptr) {
+            return false;
+        }
+        account->balance.fetch_add(delta.cents(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // 设置日志接口 (传 nullptr 关闭日志)。应在其他线程开始使用 Ledger 之前调用。
+    void setJournal(LedgerJournal* newJournal) { journal = newJournal; }
+
+    // 持有第 index 个分片的写锁，先调用一次 onLocked()，
+    // 再对分片中的每个账户调用 onAccount(accountNumber, owner, balance)。
+    // 写锁期间该分片不会有任何修改，用于生成一致的快照。
+    template <class OnLocked, class OnAccount>
+    void visitShard(std::size_t index, OnLocked&& onLocked, OnAccount&& onAccount) const {
+        std::unique_lock lock(shards[index].mutex);
+        onLocked();
+        for (const auto& [accNum, account] : shards[index].accounts) {
+            onAccount(std::string_view(accNum), std::string_view(account->owner),
+                      Money::fromCents(account->balance.load(std::memory_order_relaxed)));
+        }
+    }
+
+    // 分片编号用固定的 64 位 FNV-1a，而不是 std::hash (不同的标准库、32/64 位平台结果不同):
+    // LedgerStore 的快照按分片记录日志截止点，换一个编译环境后账户也必须落在同一个分片
+    std::size_t shardIndex(std::string_view accNum) const {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : accNum) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash & shardMask);
+    }
+
+    std::size_t accountCount() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i <= shardMask; ++i) {
+            std::shared_lock lock(shards[i].mutex);
+            total += shards[i].accounts.size();
+        }
+        return total;
+    }
+
+    std::size_t shardCount() const { return shardMask + 1; }
+
+private:
+    struct Account {
+        Account(const std::string& ownerName, Money initialBalance)
+            : owner(ownerName), balance(initialBalance.cents()) {}
+
+        std::string owner;                   // 账户持有人姓名
+        std::atomic<Money::Cents> balance;   // 账户余额，单位为分 (原子变量)
+    };
+
+    // 透明哈希: 允许直接用 std::string_view 查找，不必先构造 std::string
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const {
+            return std::hash<std::string_view>{}(text);
+        }
+    };
+
+    // alignas(64): 每个分片独占缓存行，避免相邻分片的锁产生伪共享
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        // Account 放在 unique_ptr 里，rehash 时地址不变
+        std::unordered_map<std::string, std::unique_ptr<Account>, StringHash, std::equal_to<>> accounts;
+    };
+
+    Shard& shardFor(std::string_view accNum) const {
+        return shards[shardIndex(accNum)];
+    }
+
+    // 调用者必须已经持有 shard 的读锁或写锁
+    static Account* find(Shard& shard, std::string_view accNum) {
+        auto it = shard.accounts.find(accNum);
+        return it == shard.accounts.end() ? nullptr : it->second.get();
+    }
+
+    std::size_t shardMask = 0;
+    std::unique_ptr<Shard[]> shards;
+    LedgerJournal* journal = nullptr;
+};
+
+#endif // LEDGER_H
@@ -0,0 +1,710 @@
+// LedgerStore.h
+#ifndef LEDGER_STORE_H
+#define LEDGER_STORE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 预写日志和快照直接使用 POSIX 文件接口 (open/write/fdatasync/mmap)，需要 Linux 环境
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Ledger.h"
+
+// ===================================================================
+// I. 文件格式
+// ===================================================================
+
+// 日志记录类型
+enum class WalRecordKind : std::uint8_t {
+    Open = 1,    // 开户，cents 为初始余额
+    Change = 2,  // 存取款，cents 为余额变化量 (正数存款，负数取款)
+    Batch = 3    // 批次开始，cents 为批次中的记录数，后面紧跟这么多条 Change 记录
+};
+
+// 每条日志记录的固定头部，后面紧跟账户号码和 (开户记录的) 持有人姓名
+struct WalRecordHeader {
+    std::uint64_t lsn;          // 日志序号 (log sequence number)，从 1 开始严格递增
+    std::int64_t cents;
+    std::uint32_t checksum;     // 头部 (checksum 字段置 0) 加上后续数据的 FNV-1a 校验和
+    std::uint16_t accLength;
+    std::uint16_t ownerLength;
+    WalRecordKind kind;
+    std::uint8_t reserved[7];
+};
+static_assert(sizeof(WalRecordHeader) == 32);
+
+// 快照文件头部，后面依次是:
+//   std::uint64_t shardLsn[shardCount]              该分片中 lsn >= shardLsn 的修改不在快照里
+//   std::uint64_t shardFirstRecord[shardCount + 1]  每个分片的账户记录范围
+//   SnapshotAccount accounts[accountCount]
+//   char strings[stringBytes]                       账户号码和持有人姓名
+struct SnapshotHeader {
+    char magic[8];
+    std::uint64_t shardCount;
+    std::uint64_t accountCount;
+    std::uint64_t stringBytes;
+};
+
+struct SnapshotAccount {
+    std::int64_t balance;
+    std::uint64_t stringOffset; // 账户号码在字符串区的偏移，持有人姓名紧随其后
+    std::uint32_t accLength;
+    std::uint32_t ownerLength;
+};
+
+// 版本 2: 分片编号改用固定的 FNV-1a (Ledger::shardIndex)。版本 1 的快照按 std::hash 分片，不能再使用
+inline constexpr char kSnapshotMagic[8] = {'L', 'E', 'D', 'G', 'S', 'N', 'P', '2'};
+
+inline std::uint32_t fnv1a(const void* data, std::size_t size, std::uint32_t hash = 2166136261u) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+[[noreturn]] inline void throwSystemError(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline void writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwSystemError("write");
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+// 新建、重命名或删除文件后，同步目录本身，保证目录项也落盘
+inline void syncDirectory(const std::filesystem::path& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0) {
+        throwSystemError("open " + directory.string());
+    }
+    ::fsync(fd);
+    ::close(fd);
+}
+
+// 只读映射一个文件，析构时自动解除映射
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throwSystemError("open " + path.string());
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throwSystemError("fstat " + path.string());
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length > 0) {
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throwSystemError("mmap " + path.string());
+            }
+            bytes = static_cast<const char*>(address);
+            ::madvise(address, length, MADV_SEQUENTIAL);
+        }
+        ::close(fd); // 映射建立后文件描述符就可以关闭了
+    }
+
+    ~MappedFile() {
+        if (bytes != nullptr) {
+            ::munmap(const_cast<char*>(bytes), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+};
+
+// ===================================================================
+// II. WriteAheadLog (预写日志，组提交)
+// ===================================================================
+
+// Ledger 在持有分片锁时调用 recordOpen / recordChange，这里只把记录追加到内存缓冲区，
+// 由后台线程批量 write + fdatasync。多个线程的记录共用一次 fdatasync (组提交)，
+// 需要持久化保证的调用者在释放分片锁之后再用 waitDurable 等待。
+// 日志按段存放: 目录下的 wal-<第一条记录的 lsn>.log，做快照时切换到新段，旧段可以删除。
+class WriteAheadLog : public LedgerJournal {
+public:
+    WriteAheadLog(std::filesystem::path walDirectory, std::uint64_t firstLsn)
+        : directory(std::move(walDirectory)), next(firstLsn), durableLsn(firstLsn - 1) {
+        fd = openSegment(firstLsn);
+        flusher = std::thread([this] { flushLoop(); });
+    }
+
+    // 析构时把缓冲区中剩余的记录全部写入磁盘
+    ~WriteAheadLog() override {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        hasWork.notify_one();
+        flusher.join();
+        ::close(fd);
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    void recordOpen(std::string_view accNum, std::string_view ownerName, Money initialBalance) override {
+        append(WalRecordKind::Open, accNum, ownerName, initialBalance.cents());
+    }
+
+    void recordChange(std::string_view accNum, Money delta) override {
+        append(WalRecordKind::Change, accNum, {}, delta.cents());
+    }
+
+    // 在一次加锁中追加 Batch 记录和所有 Change 记录，它们在日志中是连续的。
+    // 后台线程可能把它们分两次写盘，所以恢复时只有整批记录都完整有效才会重放。
+    void recordBatch(std::span<const LedgerTxn> txns) override {
+        for (const LedgerTxn& txn : txns) {
+            checkLength(txn.accountNumber);
+        }
+        bool wasEmpty;
+        {
+            std::lock_guard lock(mutex);
+            wasEmpty = pending.empty();
+            encode(WalRecordKind::Batch, {}, {}, static_cast<std::int64_t>(txns.size()));
+            for (const LedgerTxn& txn : txns) {
+                Money::Cents amount = txn.txn.amount.cents();
+                encode(WalRecordKind::Change, txn.accountNumber, {}, txn.txn.type == TxnType::Withdraw ? -amount : amount);
+            }
+            threadLastLsn = next - 1;
+        }
+        if (wasEmpty) {
+            hasWork.notify_one();
+        }
+    }
+
+    // 当前线程最近一次追加的记录的 lsn
+    static std::uint64_t lastLsnOfThisThread() { return threadLastLsn; }
+
+    // 下一条记录将要使用的 lsn
+    std::uint64_t nextLsn() {
+        std::lock_guard lock(mutex);
+        return next;
+    }
+
+    // 阻塞直到 lsn (含) 之前的所有记录都已经 fdatasync 到磁盘
+    void waitDurable(std::uint64_t lsn) {
+        std::unique_lock lock(mutex);
+        durable.wait(lock, [&] { return durableLsn >= lsn || failed; });
+        if (failed) {
+            throw std::runtime_error("WriteAheadLog: 写入日志失败");
+        }
+    }
+
+    // 等待目前为止追加的所有记录落盘
+    void sync() { waitDurable(nextLsn() - 1); }
+
+    // 切换到新的日志段，返回新段第一条记录的 lsn。返回时旧段已全部落盘。
+    std::uint64_t rotate() {
+        std::unique_lock lock(mutex);
+        rotateRequested = true;
+        hasWork.notify_one();
+        durable.wait(lock, [&] { return !rotateRequested || failed; });
+        if (failed) {
+            throw std::runtime_error("WriteAheadLog: 切换日志段失败");
+        }
+        return rotatedAt;
+    }
+
+    static std::filesystem::path segmentPath(const std::filesystem::path& walDirectory, std::uint64_t firstLsn) {
+        std::string digits = std::to_string(firstLsn);
+        return walDirectory / ("wal-" + std::string(20 - digits.size(), '0') + digits + ".log");
+    }
+
+    // 目录下所有日志段，按第一条记录的 lsn 从小到大排列
+    static std::vector<std::pair<std::uint64_t, std::filesystem::path>> segments(const std::filesystem::path& walDirectory) {
+        std::vector<std::pair<std::uint64_t, std::filesystem::path>> result;
+        for (const auto& entry : std::filesystem::directory_iterator(walDirectory)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() == 28 && name.starts_with("wal-") && name.ends_with(".log")) {
+                result.emplace_back(std::stoull(name.substr(4, 20)), entry.path());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    // 长度超过 16 位的字符串会让头部与数据不一致，恢复时之后的记录全部被丢弃。
+    // Ledger::openAccount 已经拒绝这样的账户，这里只是防御。
+    static void checkLength(std::string_view text) {
+        if (text.size() > Ledger::kMaxNameLength) {
+            throw std::length_error("WriteAheadLog: 账户号码或姓名过长");
+        }
+    }
+
+    void append(WalRecordKind kind, std::string_view accNum, std::string_view ownerName, std::int64_t cents) {
+        checkLength(accNum);
+        checkLength(ownerName);
+        bool wasEmpty;
+        {
+            std::lock_guard lock(mutex);
+            wasEmpty = pending.empty();
+            threadLastLsn = encode(kind, accNum, ownerName, cents);
+        }
+        if (wasEmpty) {
+            hasWork.notify_one(); // 只在缓冲区从空变为非空时唤醒后台线程
+        }
+    }
+
+    // 分配 lsn 并把一条记录追加到 pending，返回它的 lsn。调用者必须持有 mutex。
+    std::uint64_t encode(WalRecordKind kind, std::string_view accNum, std::string_view ownerName, std::int64_t cents) {
+        WalRecordHeader header{};
+        header.lsn = next++;
+        header.cents = cents;
+        header.accLength = static_cast<std::uint16_t>(accNum.size());
+        header.ownerLength = static_cast<std::uint16_t>(ownerName.size());
+        header.kind = kind;
+        std::uint32_t checksum = fnv1a(&header, sizeof(header));
+        checksum = fnv1a(accNum.data(), accNum.size(), checksum);
+        header.checksum = fnv1a(ownerName.data(), ownerName.size(), checksum);
+
+        const char* raw = reinterpret_cast<const char*>(&header);
+        pending.insert(pending.end(), raw, raw + sizeof(header));
+        pending.insert(pending.end(), accNum.begin(), accNum.end());
+        pending.insert(pending.end(), ownerName.begin(), ownerName.end());
+        return header.lsn;
+    }
+
+    void flushLoop() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            hasWork.wait(lock, [&] { return !pending.empty() || rotateRequested || stopping; });
+            if (pending.empty() && !rotateRequested && stopping) {
+                break;
+            }
+            // 交换缓冲区后立即释放锁，写盘期间其他线程可以继续追加记录 (它们会进入下一批)
+            std::swap(pending, writing);
+            std::uint64_t batchLast = next - 1;
+            bool rotateAfter = rotateRequested;
+            lock.unlock();
+
+            bool ok = true;
+            try {
+                if (!writing.empty()) {
+                    writeAll(fd, writing.data(), writing.size());
+                    if (::fdatasync(fd) != 0) {
+                        throwSystemError("fdatasync");
+                    }
+                    writing.clear();
+                }
+                if (rotateAfter) {
+                    ::close(fd);
+                    fd = openSegment(batchLast + 1);
+                }
+            } catch (const std::exception&) {
+                ok = false;
+            }
+
+            lock.lock();
+            if (!ok) {
+                failed = true;
+                durable.notify_all();
+                break;
+            }
+            durableLsn = batchLast;
+            if (rotateAfter) {
+                rotateRequested = false;
+                rotatedAt = batchLast + 1;
+            }
+            durable.notify_all();
+        }
+    }
+
+    // 段文件已经存在时清空它: 恢复时 firstLsn 大于所有有效记录的 lsn，
+    // 所以同名的段里只可能是崩溃留下的不完整记录，不能在它后面继续追加。
+    int openSegment(std::uint64_t firstLsn) {
+        std::filesystem::path path = segmentPath(directory, firstLsn);
+        int segmentFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+        if (segmentFd < 0) {
+            throwSystemError("open " + path.string());
+        }
+        syncDirectory(directory);
+        return segmentFd;
+    }
+
+    std::filesystem::path directory;
+    int fd = -1;
+
+    std::mutex mutex;
+    std::condition_variable hasWork;  // 通知后台线程有新记录
+    std::condition_variable durable;  // 通知等待者有新记录落盘
+    std::vector<char> pending;        // 正在追加的缓冲区
+    std::vector<char> writing;        // 后台线程正在写盘的缓冲区 (只由后台线程访问)
+    std::uint64_t next;               // 下一条记录的 lsn
+    std::uint64_t durableLsn;         // 已经落盘的最大 lsn
+    std::uint64_t rotatedAt = 0;
+    bool rotateRequested = false;
+    bool stopping = false;
+    bool failed = false;
+    std::thread flusher;
+
+    static inline thread_local std::uint64_t threadLastLsn = 0;
+};
+
+// ===================================================================
+// III. LedgerStore (可持久化的账本)
+// ===================================================================
+
+// 在 Ledger 上加上预写日志和快照:
+//  - deposit / withdraw / openAccount / applyBatch 在日志落盘后才返回 (持久化)；
+//  - checkpoint() 切换日志段、写出新的快照，然后删除快照已经覆盖的旧日志段；
+//  - open() 映射最新的快照并行重建账户，再只重放快照之后的日志。
+class LedgerStore {
+public:
+    // 打开 (或新建) directory 中的账本。已有快照的分片数量必须与 shardCount 一致。
+    static std::unique_ptr<LedgerStore> open(const std::filesystem::path& directory, std::size_t shardCount = 256) {
+        std::filesystem::create_directories(directory);
+        std::unique_ptr<LedgerStore> store(new LedgerStore(directory, shardCount));
+        store->recover();
+        return store;
+    }
+
+    ~LedgerStore() {
+        if (ledger) {
+            ledger->setJournal(nullptr);
+        }
+    }
+
+    LedgerStore(const LedgerStore&) = delete;
+    LedgerStore& operator=(const LedgerStore&) = delete;
+
+    bool openAccount(const std::string& accNum, const std::string& ownerName, Money initialBalance) {
+        return waitIf(ledger->openAccount(accNum, ownerName, initialBalance));
+    }
+
+    bool deposit(const std::string& accNum, Money amount) {
+        return waitIf(ledger->deposit(accNum, amount));
+    }
+
+    bool withdraw(const std::string& accNum, Money amount) {
+        return waitIf(ledger->withdraw(accNum, amount));
+    }
+
+    BatchResult applyBatch(std::span<const LedgerTxn> txns) {
+        BatchResult result = ledger->applyBatch(txns);
+        waitIf(result.committed() && !txns.empty());
+        return result;
+    }
+
+    // 不等待落盘的访问 (例如批量导入后再统一调用 sync)
+    Ledger& accounts() { return *ledger; }
+
+    void sync() { wal->sync(); }
+
+    // 生成快照并删除不再需要的日志段。同一时间只允许一个 checkpoint。
+    void checkpoint() {
+        std::lock_guard lock(checkpointMutex);
+        std::uint64_t segmentStart = wal->rotate();
+        writeSnapshot();
+        // 每个分片的 shardLsn 都 >= segmentStart，所以旧日志段中的修改都已经包含在快照里
+        for (const auto& [firstLsn, path] : WriteAheadLog::segments(directory)) {
+            if (firstLsn < segmentStart) {
+                std::filesystem::remove(path);
+            }
+        }
+        syncDirectory(directory);
+    }
+
+    // 最近一次 open() 的恢复统计
+    struct RecoveryStats {
+        std::size_t snapshotAccounts = 0;
+        std::size_t replayedRecords = 0;
+        std::size_t skippedRecords = 0;   // 已经包含在快照中的日志记录
+    };
+    const RecoveryStats& recoveryStats() const { return stats; }
+
+private:
+    LedgerStore(std::filesystem::path storeDirectory, std::size_t shardCount)
+        : directory(std::move(storeDirectory)), ledger(std::make_unique<Ledger>(shardCount)) {}
+
+    std::filesystem::path snapshotPath() const { return directory / "snapshot.bin"; }
+
+    bool waitIf(bool changed) {
+        if (changed) {
+            wal->waitDurable(WriteAheadLog::lastLsnOfThisThread());
+        }
+        return changed;
+    }
+
+    void recover() {
+        std::vector<std::uint64_t> shardLsn(ledger->shardCount(), 0);
+        if (std::filesystem::exists(snapshotPath())) {
+            loadSnapshot(shardLsn);
+        }
+
+        std::uint64_t lastLsn = 0;
+        for (const auto& segment : WriteAheadLog::segments(directory)) {
+            lastLsn = std::max(lastLsn, replaySegment(segment.second, shardLsn));
+        }
+        // shardLsn 记录的是快照时 "下一条" 记录的 lsn，新的 lsn 不能小于它
+        std::uint64_t firstLsn = std::max(lastLsn + 1, *std::max_element(shardLsn.begin(), shardLsn.end()));
+
+        // 恢复完成后才挂上日志，之后的修改从新的日志段开始记录
+        wal = std::make_unique<WriteAheadLog>(directory, firstLsn);
+        ledger->setJournal(wal.get());
+    }
+
+    // 映射快照文件，按分片并行重建账户 (不同分片的开户互不阻塞)
+    void loadSnapshot(std::vector<std::uint64_t>& shardLsn) {
+        MappedFile file(snapshotPath());
+        const char* base = file.data();
+        SnapshotHeader header;
+        if (file.size() < sizeof(header)) {
+            throw std::runtime_error("快照文件已损坏: " + snapshotPath().string());
+        }
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic) - 1) != 0) {
+            throw std::runtime_error("不是有效的快照文件: " + snapshotPath().string());
+        }
+        if (header.magic[7] != kSnapshotMagic[7]) {
+            throw std::runtime_error("快照的格式版本 (分片方式) 与当前程序不同: " + snapshotPath().string());
+        }
+        if (header.shardCount != ledger->shardCount()) {
+            throw std::runtime_error("快照的分片数量与 Ledger 不一致");
+        }
+        std::size_t shards = header.shardCount;
+        std::size_t expected = sizeof(header) + sizeof(std::uint64_t) * (2 * shards + 1)
+                             + sizeof(SnapshotAccount) * header.accountCount + header.stringBytes;
+        // 先检查数量本身，避免计算 expected 时溢出
+        if (header.accountCount > file.size() / sizeof(SnapshotAccount) || header.stringBytes > file.size() ||
+            shards > file.size() / sizeof(std::uint64_t) || file.size() != expected) {
+            throw std::runtime_error("快照文件大小不正确: " + snapshotPath().string());
+        }
+
+        const char* cursor = base + sizeof(header);
+        std::memcpy(shardLsn.data(), cursor, sizeof(std::uint64_t) * shards);
+        cursor += sizeof(std::uint64_t) * shards;
+        std::vector<std::uint64_t> firstRecord(shards + 1);
+        std::memcpy(firstRecord.data(), cursor, sizeof(std::uint64_t) * (shards + 1));
+        cursor += sizeof(std::uint64_t) * (shards + 1);
+        const char* records = cursor;
+        const char* strings = records + sizeof(SnapshotAccount) * header.accountCount;
+
+        // 在启动工作线程之前检查所有范围 (线程里不能抛出异常)，损坏的快照不能让我们读到映射之外
+        auto corrupt = [&] { throw std::runtime_error("快照文件已损坏: " + snapshotPath().string()); };
+        if (firstRecord[0] != 0 || firstRecord[shards] != header.accountCount) {
+            corrupt();
+        }
+        for (std::size_t shard = 0; shard < shards; ++shard) {
+            if (firstRecord[shard] > firstRecord[shard + 1]) {
+                corrupt();
+            }
+        }
+        for (std::uint64_t i = 0; i < header.accountCount; ++i) {
+            SnapshotAccount record;
+            std::memcpy(&record, records + i * sizeof(SnapshotAccount), sizeof(record));
+            if (record.stringOffset > header.stringBytes ||
+                std::uint64_t{record.accLength} + record.ownerLength > header.stringBytes - record.stringOffset) {
+                corrupt();
+            }
+        }
+
+        unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            workers.emplace_back([&, t] {
+                std::string accNum;
+                std::string ownerName;
+                for (std::size_t shard = t; shard < shards; shard += threadCount) {
+                    for (std::uint64_t i = firstRecord[shard]; i < firstRecord[shard + 1]; ++i) {
+                        SnapshotAccount record;
+                        std::memcpy(&record, records + i * sizeof(SnapshotAccount), sizeof(record));
+                        accNum.assign(strings + record.stringOffset, record.accLength);
+                        ownerName.assign(strings + record.stringOffset + record.accLength, record.ownerLength);
+                        ledger->openAccount(accNum, ownerName, Money::fromCents(record.balance));
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        stats.snapshotAccounts = header.accountCount;
+    }
+
+    // 读取 offset 处的一条记录: 不完整或校验失败时返回 false，否则把 offset 移到下一条记录
+    static bool readRecord(const MappedFile& file, std::size_t& offset, WalRecordHeader& header, const char*& payload) {
+        if (offset + sizeof(WalRecordHeader) > file.size()) {
+            return false;
+        }
+        std::memcpy(&header, file.data() + offset, sizeof(header));
+        std::size_t length = header.accLength + header.ownerLength;
+        if (offset + sizeof(header) + length > file.size()) {
+            return false;
+        }
+        payload = file.data() + offset + sizeof(header);
+        std::uint32_t stored = header.checksum;
+        header.checksum = 0;
+        if (fnv1a(payload, length, fnv1a(&header, sizeof(header))) != stored) {
+            return false;
+        }
+        offset += sizeof(header) + length;
+        return true;
+    }
+
+    // 重放一条 Open / Change 记录 (快照已经包含的跳过)
+    void replayRecord(const WalRecordHeader& header, const char* payload, const std::vector<std::uint64_t>& shardLsn) {
+        std::string_view accNum(payload, header.accLength);
+        if (header.lsn < shardLsn[ledger->shardIndex(accNum)]) {
+            ++stats.skippedRecords;
+            return;
+        }
+        if (header.kind == WalRecordKind::Open) {
+            ledger->openAccount(std::string(accNum), std::string(payload + header.accLength, header.ownerLength),
+                                Money::fromCents(header.cents));
+        } else {
+            ledger->adjustBalance(accNum, Money::fromCents(header.cents));
+        }
+        ++stats.replayedRecords;
+    }
+
+    // 重放一个日志段中快照之后的记录，返回段内最后一条被接受的记录的 lsn。
+    // 遇到不完整或校验失败的记录 (例如写到一半时断电) 就停止；
+    // 批次先检查后面的所有记录，只要有一条不完整，整批都不重放 (全有或全无)。
+    std::uint64_t replaySegment(const std::filesystem::path& path, const std::vector<std::uint64_t>& shardLsn) {
+        MappedFile file(path);
+        std::uint64_t lastLsn = 0;
+        std::size_t offset = 0;
+        WalRecordHeader header;
+        const char* payload = nullptr;
+        while (readRecord(file, offset, header, payload)) {
+            if (header.kind != WalRecordKind::Batch) {
+                lastLsn = header.lsn;
+                replayRecord(header, payload, shardLsn);
+                continue;
+            }
+            std::uint64_t count = static_cast<std::uint64_t>(header.cents);
+            std::size_t end = offset;
+            bool complete = true;
+            WalRecordHeader member;
+            const char* memberPayload = nullptr;
+            for (std::uint64_t i = 0; i < count && complete; ++i) {
+                complete = readRecord(file, end, member, memberPayload) && member.kind == WalRecordKind::Change;
+            }
+            if (!complete) {
+                break;
+            }
+            for (std::uint64_t i = 0; i < count; ++i) {
+                readRecord(file, offset, member, memberPayload);
+                replayRecord(member, memberPayload, shardLsn);
+            }
+            lastLsn = count == 0 ? header.lsn : member.lsn;
+        }
+        return lastLsn;
+    }
+
+    // 逐个分片在写锁下复制账户，记录该分片的 shardLsn，然后写入临时文件的映射并原子替换旧快照
+    void writeSnapshot() {
+        std::size_t shards = ledger->shardCount();
+        std::vector<std::uint64_t> shardLsn(shards);
+        std::vector<std::uint64_t> firstRecord(shards + 1, 0);
+        std::vector<SnapshotAccount> records;
+        std::vector<char> strings;
+        for (std::size_t shard = 0; shard < shards; ++shard) {
+            firstRecord[shard] = records.size();
+            ledger->visitShard(shard,
+                [&] { shardLsn[shard] = wal->nextLsn(); },
+                [&](std::string_view accNum, std::string_view ownerName, Money balance) {
+                    SnapshotAccount record{};
+                    record.balance = balance.cents();
+                    record.stringOffset = strings.size();
+                    record.accLength = static_cast<std::uint32_t>(accNum.size());
+                    record.ownerLength = static_cast<std::uint32_t>(ownerName.size());
+                    records.push_back(record);
+                    strings.insert(strings.end(), accNum.begin(), accNum.end());
+                    strings.insert(strings.end(), ownerName.begin(), ownerName.end());
+                });
+        }
+        firstRecord[shards] = records.size();
+
+        SnapshotHeader header{};
+        std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+        header.shardCount = shards;
+        header.accountCount = records.size();
+        header.stringBytes = strings.size();
+        std::size_t totalSize = sizeof(header) + sizeof(std::uint64_t) * (2 * shards + 1)
+                              + sizeof(SnapshotAccount) * records.size() + strings.size();
+
+        std::filesystem::path tempPath = directory / "snapshot.bin.tmp";
+        int fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throwSystemError("open " + tempPath.string());
+        }
+        if (::ftruncate(fd, static_cast<off_t>(totalSize)) != 0) {
+            ::close(fd);
+            throwSystemError("ftruncate " + tempPath.string());
+        }
+        void* address = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throwSystemError("mmap " + tempPath.string());
+        }
+        char* cursor = static_cast<char*>(address);
+        auto put = [&cursor](const void* data, std::size_t size) {
+            if (size > 0) {
+                std::memcpy(cursor, data, size);
+                cursor += size;
+            }
+        };
+        put(&header, sizeof(header));
+        put(shardLsn.data(), sizeof(std::uint64_t) * shards);
+        put(firstRecord.data(), sizeof(std::uint64_t) * (shards + 1));
+        put(records.data(), sizeof(SnapshotAccount) * records.size());
+        put(strings.data(), strings.size());
+
+        bool synced = ::msync(address, totalSize, MS_SYNC) == 0;
+        ::munmap(address, totalSize);
+        ::close(fd);
+        if (!synced) {
+            throwSystemError("msync " + tempPath.string());
+        }
+        std::filesystem::rename(tempPath, snapshotPath()); // rename 是原子的，崩溃时要么是旧快照，要么是新快照
+        syncDirectory(directory);
+    }
+
+    std::filesystem::path directory;
+    std::unique_ptr<Ledger> ledger;
+    std::unique_ptr<WriteAheadLog> wal;   // 声明在 ledger 之后，先于 ledger 析构
+    std::mutex checkpointMutex;
+    RecoveryStats stats;
+};
+
+#endif // LEDGER_STORE_H
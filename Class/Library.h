@@ -0,0 +1,374 @@
+// Library.h
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// === Library (图书馆借还引擎) 类定义 ===
+// 每个书目 (title) 可以有多本副本，读者 (patron) 借书时:
+//  - 有空闲副本并且没有人排队: 用一次 CAS 把空闲数量减一，不加锁；
+//  - 否则进入该书目的等候队列 (只锁这一个书目)；
+// 还书时如果有人排队，副本直接转借给队首的读者，否则空闲数量加一 (同样是一次 CAS)。
+// 每个书目的 "空闲数量 + 排队人数" 打包在一个 64 位原子变量里，
+// 所以 "有空闲副本时不会有人在排队" 这个条件可以被原子地检查。
+//
+// 借阅记录按 (书目, 读者) 哈希到多个分片，每个分片有自己的锁、借阅表和时间轮 (timer wheel)。
+// 到期日以 "天" 为单位，时间轮有 kWheelSize 个桶，第 d 天到期的借阅放在 d % kWheelSize 号桶里，
+// 扫描逾期时只访问经过的那几天对应的桶，而不是遍历所有借阅。
+// 整个引擎没有全局互斥锁: 不同书目、不同分片上的操作互不阻塞。
+//
+// 同一读者同一时间对同一书目只能借一本，排队时会线性查找等候队列 (适合较短的队列)。
+// 时间由调用者传入 (Day)，便于测试和模拟。
+class Library {
+public:
+    using TitleId = std::uint32_t;
+    using PatronId = std::uint32_t;
+    using Day = std::uint32_t;
+
+    struct Loan {
+        TitleId title;
+        PatronId patron;
+        Day due;
+    };
+
+    enum class CheckoutResult {
+        Borrowed,        // 借到了
+        Waitlisted,      // 没有空闲副本，已进入等候队列
+        AlreadyBorrowed, // 该读者已经借了这本书
+        AlreadyWaiting,  // 该读者已经在等候队列里
+        UnknownTitle
+    };
+
+    struct ReturnResult {
+        bool returned = false;            // 该读者确实借了这本书
+        std::optional<PatronId> handedTo; // 副本被直接转借给了排队的读者
+    };
+
+    static constexpr std::size_t kWheelSize = 256;   // 时间轮的桶数 (天)
+    static constexpr std::size_t kChunkSize = 4096;  // 书目表每块的书目数量
+    static constexpr std::size_t kMaxChunks = 4096;  // 最多 kChunkSize * kMaxChunks 个书目
+
+    // 分片数量会被向上取整为 2 的幂
+    explicit Library(Day loanDays = 14, std::size_t shardCount = 256) : loanDays(loanDays) {
+        std::size_t count = 1;
+        while (count < shardCount) {
+            count <<= 1;
+        }
+        shardMask = count - 1;
+        shards = std::make_unique<LoanShard[]>(count);
+    }
+
+    // 新增一个书目，返回它的编号。可以和借还操作并发调用
+    TitleId addTitle(std::uint32_t copies) {
+        std::lock_guard<std::mutex> lock(growMutex);
+        std::size_t id = publishedTitles.load(std::memory_order_relaxed);
+        if (id >= kChunkSize * kMaxChunks) {
+            throw std::length_error("Library: too many titles");
+        }
+        std::size_t chunk = id / kChunkSize;
+        if (chunks[chunk].load(std::memory_order_relaxed) == nullptr) {
+            chunks[chunk].store(new TitleChunk, std::memory_order_release);
+        }
+        TitleState& title = chunks[chunk].load(std::memory_order_relaxed)->titles[id % kChunkSize];
+        title.copies.store(copies, std::memory_order_relaxed);
+        title.state.store(copies, std::memory_order_relaxed);
+        publishedTitles.store(id + 1, std::memory_order_release); // 发布: 之后其他线程才能看到这个书目
+        return static_cast<TitleId>(id);
+    }
+
+    ~Library() {
+        for (std::atomic<TitleChunk*>& chunk : chunks) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    Library(const Library&) = delete;
+    Library& operator=(const Library&) = delete;
+
+    // 增加副本: 如果有人排队，新副本直接借给队首读者
+    void addCopies(TitleId id, std::uint32_t count, Day today) {
+        TitleState* title = find(id);
+        if (title == nullptr) {
+            return;
+        }
+        title->copies.fetch_add(count, std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            releaseCopy(id, *title, today);
+        }
+    }
+
+    CheckoutResult checkout(TitleId id, PatronId patron, Day today) {
+        TitleState* title = find(id);
+        if (title == nullptr) {
+            return CheckoutResult::UnknownTitle;
+        }
+        // 快速路径: 有空闲副本且无人排队
+        std::uint64_t state = title->state.load(std::memory_order_relaxed);
+        while (available(state) > 0 && waiting(state) == 0) {
+            if (title->state.compare_exchange_weak(state, state - 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                return recordLoan(id, *title, patron, today);
+            }
+        }
+        // 慢速路径: 锁住这个书目，再检查一次，仍然借不到就排队
+        std::unique_lock lock(title->waitMutex);
+        state = title->state.load(std::memory_order_relaxed);
+        while (true) {
+            if (available(state) > 0 && waiting(state) == 0) {
+                if (title->state.compare_exchange_weak(state, state - 1, std::memory_order_acquire,
+                                                       std::memory_order_relaxed)) {
+                    lock.unlock();
+                    return recordLoan(id, *title, patron, today);
+                }
+            } else if (std::find(title->waitlist.begin(), title->waitlist.end(), patron) != title->waitlist.end()) {
+                return CheckoutResult::AlreadyWaiting;
+            } else if (findLoan(id, patron)) {
+                return CheckoutResult::AlreadyBorrowed;
+            } else if (title->state.compare_exchange_weak(state, state + kWaiterUnit, std::memory_order_relaxed)) {
+                title->waitlist.push_back(patron);
+                return CheckoutResult::Waitlisted;
+            }
+        }
+    }
+
+    // 还书。读者没有借这本书时 returned 为 false
+    ReturnResult returnBook(TitleId id, PatronId patron, Day today) {
+        ReturnResult result;
+        TitleState* title = find(id);
+        if (title == nullptr || !eraseLoan(id, patron)) {
+            return result;
+        }
+        result.returned = true;
+        result.handedTo = releaseCopy(id, *title, today);
+        return result;
+    }
+
+    // 退出等候队列，读者不在队列里时返回 false
+    bool cancelWait(TitleId id, PatronId patron) {
+        TitleState* title = find(id);
+        if (title == nullptr) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(title->waitMutex);
+        auto it = std::find(title->waitlist.begin(), title->waitlist.end(), patron);
+        if (it == title->waitlist.end()) {
+            return false;
+        }
+        title->waitlist.erase(it);
+        title->state.fetch_sub(kWaiterUnit, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 推进时间轮: 返回到期日早于 today、且上次调用之后才变成逾期的借阅 (每笔逾期借阅只报告一次)。
+    // 已经归还的借阅会在扫描时被顺便清理掉。
+    std::vector<Loan> collectOverdue(Day today) {
+        std::vector<Loan> overdue;
+        for (std::size_t s = 0; s <= shardMask; ++s) {
+            LoanShard& shard = shards[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (today <= shard.cursor) {
+                continue;
+            }
+            if (today - shard.cursor >= kWheelSize) {
+                for (std::vector<WheelEntry>& bucket : shard.wheel) {
+                    fireBucket(shard, bucket, today, overdue);
+                }
+            } else {
+                for (Day d = shard.cursor; d < today; ++d) {
+                    fireBucket(shard, shard.wheel[d % kWheelSize], today, overdue);
+                }
+            }
+            shard.cursor = today;
+        }
+        return overdue;
+    }
+
+    // 以下查询用于统计和校验，返回的是调用时刻的近似值
+    std::uint32_t availableCopies(TitleId id) const {
+        const TitleState* title = find(id);
+        return title == nullptr ? 0 : available(title->state.load(std::memory_order_relaxed));
+    }
+
+    std::uint32_t totalCopies(TitleId id) const {
+        const TitleState* title = find(id);
+        return title == nullptr ? 0 : title->copies.load(std::memory_order_relaxed);
+    }
+
+    std::uint32_t waitlistLength(TitleId id) const {
+        const TitleState* title = find(id);
+        return title == nullptr ? 0 : waiting(title->state.load(std::memory_order_relaxed));
+    }
+
+    std::optional<Loan> findLoan(TitleId id, PatronId patron) const {
+        const LoanShard& shard = shardFor(id, patron);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.loans.find(loanKey(id, patron));
+        if (it == shard.loans.end()) {
+            return std::nullopt;
+        }
+        return Loan{id, patron, it->second.due};
+    }
+
+    std::size_t activeLoans() const {
+        std::size_t total = 0;
+        for (std::size_t s = 0; s <= shardMask; ++s) {
+            std::lock_guard<std::mutex> lock(shards[s].mutex);
+            total += shards[s].loans.size();
+        }
+        return total;
+    }
+
+    std::size_t titleCount() const {
+        return publishedTitles.load(std::memory_order_acquire);
+    }
+
+private:
+    // state 的低 32 位是空闲副本数，高 32 位是排队人数
+    static constexpr std::uint64_t kWaiterUnit = std::uint64_t{1} << 32;
+
+    static std::uint32_t available(std::uint64_t state) {
+        return static_cast<std::uint32_t>(state);
+    }
+
+    static std::uint32_t waiting(std::uint64_t state) {
+        return static_cast<std::uint32_t>(state >> 32);
+    }
+
+    // 每个书目独占一条缓存行的开头，热门书目之间不会伪共享
+    struct alignas(64) TitleState {
+        std::atomic<std::uint64_t> state{0};
+        std::atomic<std::uint32_t> copies{0};
+        std::mutex waitMutex;           // 只保护 waitlist
+        std::deque<PatronId> waitlist;
+    };
+
+    struct TitleChunk {
+        std::array<TitleState, kChunkSize> titles;
+    };
+
+    struct ActiveLoan {
+        Day due;
+        std::uint64_t sequence; // 区分同一 (书目, 读者) 先后的多次借阅
+    };
+
+    struct WheelEntry {
+        std::uint64_t key;
+        std::uint64_t sequence;
+        Day due;
+    };
+
+    struct alignas(64) LoanShard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::uint64_t, ActiveLoan> loans;
+        std::array<std::vector<WheelEntry>, kWheelSize> wheel;
+        std::uint64_t nextSequence = 0;
+        Day cursor = 0; // 到期日早于 cursor 的借阅都已经报告过
+    };
+
+    static std::uint64_t loanKey(TitleId id, PatronId patron) {
+        return (std::uint64_t{id} << 32) | patron;
+    }
+
+    TitleState* find(TitleId id) const {
+        if (id >= publishedTitles.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &chunks[id / kChunkSize].load(std::memory_order_acquire)->titles[id % kChunkSize];
+    }
+
+    LoanShard& shardFor(TitleId id, PatronId patron) const {
+        std::uint64_t h = loanKey(id, patron) * 0x9E3779B97F4A7C15ull; // 乘法哈希，取高位
+        return shards[(h >> 40) & shardMask];
+    }
+
+    // 已经拿到一本副本，记录借阅。该读者已借过这本书时把副本还回去
+    CheckoutResult recordLoan(TitleId id, TitleState& title, PatronId patron, Day today) {
+        if (insertLoan(id, patron, today)) {
+            return CheckoutResult::Borrowed;
+        }
+        releaseCopy(id, title, today);
+        return CheckoutResult::AlreadyBorrowed;
+    }
+
+    bool insertLoan(TitleId id, PatronId patron, Day today) {
+        LoanShard& shard = shardFor(id, patron);
+        Day due = today + loanDays;
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::uint64_t key = loanKey(id, patron);
+        std::uint64_t sequence = shard.nextSequence++;
+        if (!shard.loans.try_emplace(key, ActiveLoan{due, sequence}).second) {
+            return false;
+        }
+        shard.wheel[due % kWheelSize].push_back(WheelEntry{key, sequence, due});
+        return true;
+    }
+
+    // 时间轮里的条目不在还书时删除，扫描到时发现借阅已不存在再丢弃
+    bool eraseLoan(TitleId id, PatronId patron) {
+        LoanShard& shard = shardFor(id, patron);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.loans.erase(loanKey(id, patron)) > 0;
+    }
+
+    // 归还一本副本: 有人排队就转借给队首读者，否则空闲数量加一
+    std::optional<PatronId> releaseCopy(TitleId id, TitleState& title, Day today) {
+        std::uint64_t state = title.state.load(std::memory_order_relaxed);
+        while (waiting(state) == 0) {
+            if (title.state.compare_exchange_weak(state, state + 1, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+        }
+        std::unique_lock lock(title.waitMutex);
+        // 加锁期间排队人数只会增加 (减少都在锁内)，但可能在加锁前已被别人清空
+        if (title.waitlist.empty()) {
+            title.state.fetch_add(1, std::memory_order_release);
+            return std::nullopt;
+        }
+        PatronId next = title.waitlist.front();
+        title.waitlist.pop_front();
+        title.state.fetch_sub(kWaiterUnit, std::memory_order_relaxed);
+        lock.unlock();
+        if (recordLoan(id, title, next, today) != CheckoutResult::Borrowed) {
+            return std::nullopt; // 不会发生: 排队前已经检查过该读者没有借这本书
+        }
+        return next;
+    }
+
+    // 处理一个桶: 到期日早于 today 的条目报告为逾期 (若借阅仍存在) 并移除，其余条目属于以后的轮次，保留
+    static void fireBucket(LoanShard& shard, std::vector<WheelEntry>& bucket, Day today, std::vector<Loan>& overdue) {
+        std::size_t kept = 0;
+        for (const WheelEntry& entry : bucket) {
+            if (entry.due >= today) {
+                bucket[kept++] = entry;
+                continue;
+            }
+            auto it = shard.loans.find(entry.key);
+            if (it != shard.loans.end() && it->second.sequence == entry.sequence) {
+                overdue.push_back(Loan{static_cast<TitleId>(entry.key >> 32), static_cast<PatronId>(entry.key), entry.due});
+            }
+        }
+        bucket.resize(kept);
+    }
+
+    Day loanDays;
+    std::size_t shardMask;
+    std::unique_ptr<LoanShard[]> shards;
+
+    std::mutex growMutex; // 只在新增书目时使用
+    std::atomic<std::size_t> publishedTitles{0};
+    std::array<std::atomic<TitleChunk*>, kMaxChunks> chunks{};
+};
+
+#endif // LIBRARY_H
@@ -0,0 +1,434 @@
+// Log.h
+#ifndef LOG_H
+#define LOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// ===================================================================
+// 日志级别与编译期开关
+// ===================================================================
+// 编译时定义 LOG_ACTIVE_LEVEL 可以把低于该级别的日志语句完全去掉，例如:
+//   g++ BankAccount.cpp -DLOG_ACTIVE_LEVEL=LOG_LEVEL_WARN     (只保留警告和错误)
+//   g++ BankAccount.cpp -DLOG_ACTIVE_LEVEL=LOG_LEVEL_OFF      (所有日志都不参与编译)
+// 被去掉的日志语句连参数都不会求值。
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   5
+
+#ifndef LOG_ACTIVE_LEVEL
+#define LOG_ACTIVE_LEVEL LOG_LEVEL_TRACE
+#endif
+
+enum class LogLevel : std::uint8_t {
+    Trace = LOG_LEVEL_TRACE,   // 构造、拷贝、析构等细节跟踪
+    Debug = LOG_LEVEL_DEBUG,
+    Info = LOG_LEVEL_INFO,     // 正常的业务事件 (存款成功、书被借出……)
+    Warn = LOG_LEVEL_WARN,     // 输入无效等可以继续运行的问题
+    Error = LOG_LEVEL_ERROR,
+    Off = LOG_LEVEL_OFF
+};
+
+inline const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO ";
+        case LogLevel::Warn:  return "WARN ";
+        case LogLevel::Error: return "ERROR";
+        default:              return "OFF  ";
+    }
+}
+
+// ===================================================================
+// LogRecord (一条日志记录)
+// ===================================================================
+// 日志参数不会在调用线程上格式化，而是按二进制编码到 payload 中:
+//  - 字符串 (std::string / std::string_view / const char*): 复制长度和内容；
+//  - 可平凡复制的类型 (整数、浮点数、枚举、Money……): 直接复制字节，到输出时才调用 operator<<；
+//  - 其他类型: 先在调用线程上格式化成字符串再复制。
+// format 函数指针知道参数类型，负责把 payload 还原并输出，
+// 它可能在后台线程上被调用 (见 AsyncLogSink)。
+struct LogRecord {
+    static constexpr std::size_t kPayloadSize = 224;
+
+    LogLevel level = LogLevel::Info;
+    std::uint16_t size = 0;
+    std::int64_t timestampMicros = 0;   // 自 1970-01-01 起的微秒数
+    void (*format)(std::ostream&, const unsigned char*) = nullptr;
+    unsigned char payload[kPayloadSize];
+
+    void writeTo(std::ostream& os, bool showMetadata) const {
+        if (showMetadata) {
+            std::int64_t seconds = timestampMicros / 1000000;
+            std::int64_t micros = timestampMicros % 1000000;
+            char prefix[48];
+            std::size_t length = 0;
+            std::string secondsText = std::to_string(seconds);
+            std::memcpy(prefix, secondsText.data(), secondsText.size());
+            length += secondsText.size();
+            prefix[length++] = '.';
+            for (std::int64_t divisor = 100000; divisor > 0; divisor /= 10) {
+                prefix[length++] = static_cast<char>('0' + micros / divisor % 10);
+            }
+            prefix[length++] = ' ';
+            std::memcpy(prefix + length, logLevelName(level), 5);
+            length += 5;
+            prefix[length++] = ' ';
+            os.write(prefix, static_cast<std::streamsize>(length));
+        }
+        format(os, payload);
+        os.put('\n');
+    }
+};
+
+// ===================================================================
+// LogSink (日志输出端)
+// ===================================================================
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    virtual void submit(const LogRecord& record) = 0;
+    // 返回 false 的 sink (例如 NullLogSink) 会让日志语句在编码参数之前就直接返回
+    virtual bool acceptsRecords() const { return true; }
+    virtual void flush() {}
+};
+
+// 丢弃所有日志。安装后每条日志语句只剩一次原子读和一次比较。
+class NullLogSink : public LogSink {
+public:
+    void submit(const LogRecord&) override {}
+    bool acceptsRecords() const override { return false; }
+};
+
+// 同步输出到 std::ostream (默认 std::cout)。每条记录以 '\n' 结尾，不会像 std::endl 那样每次都刷新缓冲区。
+class ConsoleLogSink : public LogSink {
+public:
+    explicit ConsoleLogSink(std::ostream& stream = std::cout, bool showMetadata = false)
+        : out(stream), metadata(showMetadata) {}
+
+    void submit(const LogRecord& record) override {
+        std::lock_guard lock(mutex);
+        record.writeTo(out, metadata);
+    }
+
+    void flush() override {
+        std::lock_guard lock(mutex);
+        out.flush();
+    }
+
+private:
+    std::ostream& out;
+    bool metadata;
+    std::mutex mutex;
+};
+
+// 异步输出: 调用线程只把 LogRecord 复制进一个无锁环形队列 (多生产者、单消费者)，
+// 由后台线程取出记录、格式化并写入 stream。队列满时丢弃新记录并计数，绝不阻塞调用者。
+class AsyncLogSink : public LogSink {
+public:
+    // capacity 会被向上取整为 2 的幂
+    explicit AsyncLogSink(std::ostream& stream = std::cout, std::size_t capacity = 8192, bool showMetadata = true)
+        : out(stream), metadata(showMetadata) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        consumer = std::thread([this] { consumeLoop(); });
+    }
+
+    // 析构前会输出队列中剩余的全部记录
+    ~AsyncLogSink() override {
+        stopping.store(true, std::memory_order_release);
+        consumer.join();
+    }
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void submit(const LogRecord& record) override {
+        std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed); // 队列已满
+                return;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        // 只复制实际用到的 payload 字节
+        std::memcpy(&cell->record, &record, offsetof(LogRecord, payload) + record.size);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    // 等待此前提交的记录全部输出
+    void flush() override {
+        std::size_t target = enqueuePos.load(std::memory_order_acquire);
+        while (processed.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    std::uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    // 单消费者，不需要 CAS
+    bool consumeOne() {
+        Cell& cell = cells[dequeuePos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            return false;
+        }
+        cell.record.writeTo(out, metadata);
+        cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        processed.store(dequeuePos, std::memory_order_release);
+        return true;
+    }
+
+    void consumeLoop() {
+        while (true) {
+            bool any = false;
+            while (consumeOne()) {
+                any = true;
+            }
+            if (any) {
+                out.flush(); // 一批记录只刷新一次
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire)) {
+                // 生产者已经停止，最后再清空一次
+                while (consumeOne()) {
+                }
+                out.flush();
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::ostream& out;
+    bool metadata;
+    std::size_t mask = 0;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> processed{0};
+    std::size_t dequeuePos = 0;   // 只由后台线程访问
+    std::atomic<std::uint64_t> droppedCount{0};
+    std::atomic<bool> stopping{false};
+    std::thread consumer;
+};
+
+// ===================================================================
+// Log (全局日志入口)
+// ===================================================================
+class Log {
+public:
+    // 运行时级别: 低于该级别的日志直接返回
+    static void setLevel(LogLevel level) {
+        minLevel.store(level, std::memory_order_relaxed);
+        updateThreshold();
+    }
+
+    // 安装新的 sink (调用者负责其生命周期，传 nullptr 恢复默认的控制台输出)。
+    // 旧 sink 会先被 flush。
+    static void setSink(LogSink* newSink) {
+        LogSink* old = currentSink.exchange(newSink, std::memory_order_acq_rel);
+        (old != nullptr ? *old : defaultSink()).flush();
+        updateThreshold();
+    }
+
+    static LogSink& sink() {
+        LogSink* current = currentSink.load(std::memory_order_acquire);
+        return current != nullptr ? *current : defaultSink();
+    }
+
+    static bool enabled(LogLevel level) {
+        return level >= threshold.load(std::memory_order_relaxed);
+    }
+
+    template <class... Args>
+    static void write(LogLevel level, const Args&... args) {
+        LogRecord record;
+        record.level = level;
+        record.timestampMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::size_t offset = 0;
+        if ((encode(record.payload, offset, args) && ...)) {
+            record.format = &formatArgs<std::decay_t<Args>...>;
+        } else {
+            // 参数太长放不下: 在调用线程上格式化成一个字符串，截断后保存
+            std::ostringstream text;
+            (appendTo(text, args), ...);
+            std::string message = std::move(text).str();
+            message.resize(std::min(message.size(), LogRecord::kPayloadSize - sizeof(std::uint16_t)));
+            offset = 0;
+            encode(record.payload, offset, std::string_view(message));
+            record.format = &formatArgs<std::string_view>;
+        }
+        record.size = static_cast<std::uint16_t>(offset);
+        sink().submit(record);
+    }
+
+private:
+    template <class T>
+    static constexpr bool isStringArg = std::is_convertible_v<const T&, std::string_view>;
+
+    template <class T>
+    static constexpr bool isTrivialArg = !isStringArg<T> && std::is_trivially_copyable_v<T>
+                                      && sizeof(T) <= LogRecord::kPayloadSize;
+
+    // 把一个参数编码进 payload；空间不够时返回 false
+    template <class T>
+    static bool encode(unsigned char* payload, std::size_t& offset, const T& value) {
+        using Decayed = std::decay_t<T>;
+        if constexpr (isTrivialArg<Decayed>) {
+            if (offset + sizeof(Decayed) > LogRecord::kPayloadSize) {
+                return false;
+            }
+            const Decayed& decayed = value; // 数组参数在这里退化为指针，与 formatArgs 的类型一致
+            std::memcpy(payload + offset, &decayed, sizeof(Decayed));
+            offset += sizeof(Decayed);
+            return true;
+        } else if constexpr (isStringArg<T>) {
+            std::string_view text(value);
+            std::uint16_t length = static_cast<std::uint16_t>(text.size());
+            if (text.size() > 0xFFFF || offset + sizeof(length) + text.size() > LogRecord::kPayloadSize) {
+                return false;
+            }
+            std::memcpy(payload + offset, &length, sizeof(length));
+            std::memcpy(payload + offset + sizeof(length), text.data(), text.size());
+            offset += sizeof(length) + text.size();
+            return true;
+        } else {
+            std::ostringstream text;
+            text << value;
+            return encode(payload, offset, std::string_view(text.view()));
+        }
+    }
+
+    // 与 encode 对应: 从 payload 读出一个参数并输出
+    template <class T>
+    static void decode(std::ostream& os, const unsigned char*& cursor) {
+        if constexpr (isTrivialArg<T>) {
+            T value;
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            if constexpr (std::is_enum_v<T>) {
+                os << static_cast<std::underlying_type_t<T>>(value);
+            } else {
+                os << value;
+            }
+        } else {
+            std::uint16_t length;
+            std::memcpy(&length, cursor, sizeof(length));
+            os.write(reinterpret_cast<const char*>(cursor + sizeof(length)), length);
+            cursor += sizeof(length) + length;
+        }
+    }
+
+    template <class... Args>
+    static void formatArgs(std::ostream& os, const unsigned char* payload) {
+        const unsigned char* cursor = payload;
+        (decode<Args>(os, cursor), ...);
+    }
+
+    template <class T>
+    static void appendTo(std::ostringstream& os, const T& value) {
+        if constexpr (std::is_enum_v<T>) {
+            os << static_cast<std::underlying_type_t<T>>(value);
+        } else {
+            os << value;
+        }
+    }
+
+    static LogSink& defaultSink() {
+        static ConsoleLogSink console;
+        return console;
+    }
+
+    // threshold = 运行时级别；当前 sink 不接收记录时为 Off
+    static void updateThreshold() {
+        threshold.store(sink().acceptsRecords() ? minLevel.load(std::memory_order_relaxed) : LogLevel::Off,
+                        std::memory_order_relaxed);
+    }
+
+    static inline std::atomic<LogLevel> minLevel{LogLevel::Trace};
+    static inline std::atomic<LogLevel> threshold{LogLevel::Trace};
+    static inline std::atomic<LogSink*> currentSink{nullptr};   // nullptr 表示默认的控制台输出
+};
+
+// ===================================================================
+// 日志宏
+// ===================================================================
+// 用法: LOG_INFO("存款 ", amount, " 成功。");  各参数依次输出，末尾自动换行。
+#define LOG_AT(level, ...)                         \
+    do {                                           \
+        if (Log::enabled(level)) {                 \
+            Log::write(level, __VA_ARGS__);        \
+        }                                          \
+    } while (0)
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) LOG_AT(LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_AT(LogLevel::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_ACTIVE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#endif // LOG_H
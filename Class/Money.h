@@ -0,0 +1,138 @@
+// Money.h
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+// === Money (定点数金额) 类定义 ===
+// 用 int64 整数保存 "分" (最小货币单位)，而不是用 double 保存 "元"。
+//  - double 无法精确表示 0.1 这样的小数，多次加减后会出现 1000.4999999 这样的误差；
+//  - 整数加减是精确的，而且比浮点运算更便宜；
+//  - 所有运算都是 constexpr 的，可以在编译期计算。
+class Money {
+public:
+    using Cents = std::int64_t;
+
+    // 格式化结果的最大长度: 符号 + 17 位整数 + 小数点 + 2 位小数
+    static constexpr std::size_t kMaxFormattedSize = 21;
+
+    constexpr Money() = default;
+
+    // 从 "分" 构造，例如 Money::fromCents(100050) 表示 1000.50
+    static constexpr Money fromCents(Cents cents) {
+        return Money(cents);
+    }
+
+    // 从 double 构造，四舍五入到分。只用于输入边界 (例如用户输入)，内部计算不要使用 double。
+    static Money fromDouble(double amount) {
+        return Money(static_cast<Cents>(std::llround(amount * 100.0)));
+    }
+
+    constexpr Cents cents() const { return value; }
+
+    // 转换为 double，仅用于显示或与旧接口对接
+    constexpr double toDouble() const { return static_cast<double>(value) / 100.0; }
+
+    constexpr bool isPositive() const { return value > 0; }
+    constexpr bool isNegative() const { return value < 0; }
+
+    // --- 带溢出检查的加减法 ---
+    // checkedAdd / checkedSub 在溢出时返回 std::nullopt，适合热路径中不想抛异常的场景。
+    constexpr std::optional<Money> checkedAdd(Money other) const {
+        if ((other.value > 0 && value > std::numeric_limits<Cents>::max() - other.value) ||
+            (other.value < 0 && value < std::numeric_limits<Cents>::min() - other.value)) {
+            return std::nullopt;
+        }
+        return Money(value + other.value);
+    }
+
+    constexpr std::optional<Money> checkedSub(Money other) const {
+        if ((other.value < 0 && value > std::numeric_limits<Cents>::max() + other.value) ||
+            (other.value > 0 && value < std::numeric_limits<Cents>::min() + other.value)) {
+            return std::nullopt;
+        }
+        return Money(value - other.value);
+    }
+
+    // 运算符版本在溢出时抛出 std::overflow_error
+    constexpr Money operator+(Money other) const {
+        std::optional<Money> result = checkedAdd(other);
+        if (!result) {
+            throw std::overflow_error("Money: 加法溢出");
+        }
+        return *result;
+    }
+
+    constexpr Money operator-(Money other) const {
+        std::optional<Money> result = checkedSub(other);
+        if (!result) {
+            throw std::overflow_error("Money: 减法溢出");
+        }
+        return *result;
+    }
+
+    constexpr Money& operator+=(Money other) { return *this = *this + other; }
+    constexpr Money& operator-=(Money other) { return *this = *this - other; }
+
+    constexpr auto operator<=>(const Money&) const = default;
+
+    // --- 格式化 ---
+    // 把金额写成 "1234.56" 的形式，返回写入的字符数 (不写结尾的 '\0')。
+    // out 至少需要 kMaxFormattedSize 个字符。不经过 iostream，也不分配内存。
+    constexpr std::size_t format(char* out) const {
+        // 用无符号数处理，避免对 INT64_MIN 取负时溢出
+        std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value)
+                                            : static_cast<std::uint64_t>(value);
+        char digits[kMaxFormattedSize] = {};
+        std::size_t length = 0;
+
+        // 先从低位开始逆序写入: 两位小数、小数点、整数部分
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+        digits[length++] = '.';
+        do {
+            digits[length++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) {
+            digits[length++] = '-';
+        }
+
+        for (std::size_t i = 0; i < length; ++i) {
+            out[i] = digits[length - 1 - i];
+        }
+        return length;
+    }
+
+    std::string toString() const {
+        char buffer[kMaxFormattedSize];
+        return std::string(buffer, format(buffer));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, Money money) {
+        char buffer[kMaxFormattedSize];
+        return os.write(buffer, static_cast<std::streamsize>(money.format(buffer)));
+    }
+
+private:
+    constexpr explicit Money(Cents cents) : value(cents) {}
+
+    Cents value = 0; // 金额，单位为分
+};
+
+// 编译期自检
+static_assert(Money::fromCents(150) + Money::fromCents(275) == Money::fromCents(425));
+static_assert(!Money::fromCents(std::numeric_limits<Money::Cents>::max()).checkedAdd(Money::fromCents(1)));
+static_assert(!Money::fromCents(std::numeric_limits<Money::Cents>::min()).checkedSub(Money::fromCents(1)));
+
+#endif // MONEY_H
@@ -0,0 +1,602 @@
+// SpatialIndex.h
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Vector2D.h"
+
+// === 空间索引 ===
+// 对大量二维点 (Vector2D) 做最近邻、半径、矩形查询，不再逐个比较所有点。
+//  - UniformGrid: 均匀哈希网格，重建只需要两遍线性扫描，适合每帧都在移动的点；
+//  - KdTree: 静态 k-d 树，节点隐含在重新排列过的数组里 (没有指针)，适合不常变化的点。
+// 两者的查询接口相同，结果用点在 build 时的下标 (id) 表示。
+// 单个查询是 const 的，可以被多个线程同时调用；批量查询 (xxxBatch) 会把查询分给多个线程。
+// 所有类型都在 spatial 命名空间中 (Txn.h 中已有全局的 BatchResult)。
+
+namespace spatial {
+
+// 最近邻查询的一个结果
+struct Neighbor {
+    std::uint32_t id;
+    double distanceSquared;
+
+    // 按距离排序，距离相同时按 id 排序，保证结果是确定的
+    friend bool operator<(const Neighbor& a, const Neighbor& b) {
+        return a.distanceSquared < b.distanceSquared || (a.distanceSquared == b.distanceSquared && a.id < b.id);
+    }
+};
+
+// 批量查询的结果: 第 q 个查询的结果是 ids[offsets[q]] 到 ids[offsets[q + 1]] (不含)
+struct BatchResult {
+    std::vector<std::size_t> offsets;
+    std::vector<std::uint32_t> ids;
+
+    std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    std::span<const std::uint32_t> operator[](std::size_t q) const {
+        return std::span<const std::uint32_t>(ids.data() + offsets[q], offsets[q + 1] - offsets[q]);
+    }
+};
+
+namespace detail {
+
+// 保留距离最小的 k 个点: 用最大堆，堆顶是目前第 k 近的点
+class KBest {
+public:
+    KBest(std::vector<Neighbor>& heap, std::size_t k) : heap(heap), k(k) { heap.clear(); }
+
+    bool full() const { return heap.size() == k; }
+
+    // 新的点至少要比这个距离近才可能进入结果
+    double worst() const { return full() ? heap.front().distanceSquared : INFINITY; }
+
+    void offer(std::uint32_t id, double distanceSquared) {
+        Neighbor candidate{id, distanceSquared};
+        if (!full()) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    // 结束查询: 按距离从近到远排序
+    void finish() { std::sort_heap(heap.begin(), heap.end()); }
+
+private:
+    std::vector<Neighbor>& heap;
+    std::size_t k;
+};
+
+inline unsigned resolveThreads(unsigned threads) {
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// 把 [0, chunkCount) 分给多个线程执行 body(chunk, scratch)。
+// 线程用一个原子计数器领取下一块，查询代价不均匀时 (例如点分布不均匀) 也不会有线程空等。
+// 每个线程有自己的 scratch，kNN 查询用它做堆，不需要每次分配内存。
+template <class Body>
+void parallelChunks(std::size_t chunkCount, unsigned threads, Body&& body) {
+    unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(resolveThreads(threads), chunkCount));
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        std::vector<Neighbor> scratch;
+        for (std::size_t chunk = next.fetch_add(1); chunk < chunkCount; chunk = next.fetch_add(1)) {
+            body(chunk, scratch);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        workers.emplace_back(work);
+    }
+    work(); // 当前线程也参与
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+inline constexpr std::size_t kQueriesPerChunk = 1024;
+
+// 并行执行 count 个查询，query(q, out, scratch) 把第 q 个查询的结果追加到 out。
+// 每块查询先写入自己的缓冲区，全部完成后按顺序拼接，所以结果顺序与线程数无关。
+template <class Query>
+BatchResult runBatch(std::size_t count, unsigned threads, Query&& query) {
+    struct Chunk {
+        std::vector<std::uint32_t> ids;
+        std::vector<std::size_t> ends; // 每个查询的结果在 ids 中的结束位置
+    };
+    std::size_t chunkCount = (count + kQueriesPerChunk - 1) / kQueriesPerChunk;
+    std::vector<Chunk> chunks(chunkCount);
+    parallelChunks(chunkCount, threads, [&](std::size_t c, std::vector<Neighbor>& scratch) {
+        Chunk& chunk = chunks[c];
+        std::size_t end = std::min(count, (c + 1) * kQueriesPerChunk);
+        chunk.ends.reserve(end - c * kQueriesPerChunk);
+        for (std::size_t q = c * kQueriesPerChunk; q < end; ++q) {
+            query(q, chunk.ids, scratch);
+            chunk.ends.push_back(chunk.ids.size());
+        }
+    });
+
+    BatchResult result;
+    result.offsets.reserve(count + 1);
+    result.offsets.push_back(0);
+    std::size_t total = 0;
+    for (const Chunk& chunk : chunks) {
+        total += chunk.ids.size();
+    }
+    result.ids.reserve(total);
+    for (const Chunk& chunk : chunks) {
+        std::size_t base = result.ids.size();
+        for (std::size_t end : chunk.ends) {
+            result.offsets.push_back(base + end);
+        }
+        result.ids.insert(result.ids.end(), chunk.ids.begin(), chunk.ids.end());
+    }
+    return result;
+}
+
+} // namespace detail
+
+// === SpatialBatchQueries (批量查询) ===
+// CRTP 基类: 派生类提供单个查询 radius / countRadius / box / nearest，这里把它们扩展成多线程的批量版本。
+// threads 为 0 时使用 std::thread::hardware_concurrency() 个线程。
+template <class Index>
+class SpatialBatchQueries {
+public:
+    // 每个中心点半径 radius 以内的点
+    BatchResult radiusBatch(std::span<const Vector2D> centers, double radius, unsigned threads = 0) const {
+        return detail::runBatch(centers.size(), threads,
+            [&](std::size_t q, std::vector<std::uint32_t>& out, std::vector<Neighbor>&) {
+                self().radius(centers[q], radius, out);
+            });
+    }
+
+    // 只统计数量，不保存结果
+    std::vector<std::uint32_t> countRadiusBatch(std::span<const Vector2D> centers, double radius,
+                                                unsigned threads = 0) const {
+        std::vector<std::uint32_t> counts(centers.size());
+        std::size_t chunkCount = (centers.size() + detail::kQueriesPerChunk - 1) / detail::kQueriesPerChunk;
+        detail::parallelChunks(chunkCount, threads, [&](std::size_t c, std::vector<Neighbor>&) {
+            std::size_t end = std::min(centers.size(), (c + 1) * detail::kQueriesPerChunk);
+            for (std::size_t q = c * detail::kQueriesPerChunk; q < end; ++q) {
+                counts[q] = static_cast<std::uint32_t>(self().countRadius(centers[q], radius));
+            }
+        });
+        return counts;
+    }
+
+    // 每个查询点最近的 k 个点，按距离从近到远排列
+    BatchResult nearestBatch(std::span<const Vector2D> queries, std::size_t k, unsigned threads = 0) const {
+        return detail::runBatch(queries.size(), threads,
+            [&](std::size_t q, std::vector<std::uint32_t>& out, std::vector<Neighbor>& scratch) {
+                self().nearest(queries[q], k, scratch);
+                for (const Neighbor& n : scratch) {
+                    out.push_back(n.id);
+                }
+            });
+    }
+
+    // 每个矩形 [mins[q], maxs[q]] 内的点
+    BatchResult boxBatch(std::span<const Vector2D> mins, std::span<const Vector2D> maxs, unsigned threads = 0) const {
+        if (mins.size() != maxs.size()) {
+            throw std::invalid_argument("SpatialIndex: box corner count mismatch");
+        }
+        return detail::runBatch(mins.size(), threads,
+            [&](std::size_t q, std::vector<std::uint32_t>& out, std::vector<Neighbor>&) {
+                self().box(mins[q], maxs[q], out);
+            });
+    }
+
+private:
+    const Index& self() const { return static_cast<const Index&>(*this); }
+};
+
+// === UniformGrid (均匀哈希网格) 类定义 ===
+// 平面被分成边长为 cellSize 的正方形格子，格子 (cx, cy) 放在 (hash(cy) + cx) % 桶数 号桶里，桶数约等于点数。
+// 所有点按桶排好序存放在一个连续数组里 (计数排序，与 CSR 格式相同)，同一个桶的点是连续的。
+// 同一行相邻的格子落在相邻的桶里，所以查询时每一行格子只是数组中的一段连续区间。
+// 不同格子可能落到同一个桶，所以每个点还记录了自己的格子坐标，查询时跳过别的格子的点。
+//
+// 只有点所在的格子占用空间，点可以分布在任意大的范围内。
+// cellSize 取常用查询半径左右时效果最好: 半径查询只需要检查 3x3 个左右的格子。
+// build 会复用上一次的内存，每帧重建时不会重新分配。
+class UniformGrid : public SpatialBatchQueries<UniformGrid> {
+public:
+    explicit UniformGrid(double cellSize) : cell(cellSize), inverseCell(1.0 / cellSize) {
+        if (!(cellSize > 0.0) || !std::isfinite(cellSize)) {
+            throw std::invalid_argument("UniformGrid: cell size must be positive");
+        }
+    }
+
+    UniformGrid(double cellSize, std::span<const Vector2D> points) : UniformGrid(cellSize) {
+        build(points);
+    }
+
+    void build(std::span<const Vector2D> points) {
+        std::size_t n = points.size();
+        if (n >= UINT32_MAX) {
+            throw std::length_error("UniformGrid: too many points");
+        }
+        bucketBits = 4;
+        while ((std::size_t{1} << bucketBits) < n) {
+            ++bucketBits;
+        }
+        std::size_t buckets = std::size_t{1} << bucketBits;
+        bucketStart.assign(buckets + 1, 0);
+        bucketOf.resize(n);
+        minCx = minCy = INT32_MAX;
+        maxCx = maxCy = INT32_MIN;
+
+        // 第一遍: 计算每个点的格子和桶，统计每个桶的点数
+        for (std::size_t i = 0; i < n; ++i) {
+            std::int32_t cx = cellCoord(points[i].getX());
+            std::int32_t cy = cellCoord(points[i].getY());
+            minCx = std::min(minCx, cx);
+            maxCx = std::max(maxCx, cx);
+            minCy = std::min(minCy, cy);
+            maxCy = std::max(maxCy, cy);
+            bucketOf[i] = bucketIndex(cx, cy);
+            ++bucketStart[bucketOf[i] + 1];
+        }
+        for (std::size_t b = 0; b < buckets; ++b) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+
+        // 第二遍: 按桶放入连续数组
+        cursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+        entries.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            double x = points[i].getX();
+            double y = points[i].getY();
+            entries[cursor[bucketOf[i]]++] = Entry{x, y, cellCoord(x), cellCoord(y), static_cast<std::uint32_t>(i)};
+        }
+    }
+
+    std::size_t size() const { return entries.size(); }
+    double cellSize() const { return cell; }
+
+    // 把距离 center 不超过 r 的点的 id 追加到 out (顺序不确定)
+    void radius(const Vector2D& center, double r, std::vector<std::uint32_t>& out) const {
+        forEachInRadius(center, r, [&](const Entry& e) { out.push_back(e.id); });
+    }
+
+    std::size_t countRadius(const Vector2D& center, double r) const {
+        std::size_t count = 0;
+        forEachInRadius(center, r, [&](const Entry&) { ++count; });
+        return count;
+    }
+
+    // 把 min.x <= x <= max.x 且 min.y <= y <= max.y 的点的 id 追加到 out
+    void box(const Vector2D& min, const Vector2D& max, std::vector<std::uint32_t>& out) const {
+        forEachCandidate(min.getX(), min.getY(), max.getX(), max.getY(), [&](const Entry& e) {
+            if (e.x >= min.getX() && e.x <= max.getX() && e.y >= min.getY() && e.y <= max.getY()) {
+                out.push_back(e.id);
+            }
+        });
+    }
+
+    // 最近的 k 个点，按距离从近到远写入 out (原有内容被清除)。
+    // 从查询点所在的格子开始一圈一圈向外扩展，直到剩下的格子不可能比第 k 近的点更近。
+    void nearest(const Vector2D& query, std::size_t k, std::vector<Neighbor>& out) const {
+        detail::KBest best(out, std::min(k, entries.size()));
+        if (k == 0 || entries.empty()) {
+            return;
+        }
+        double qx = query.getX(), qy = query.getY();
+        std::int64_t cx = cellCoord(qx), cy = cellCoord(qy);
+        // 与已占用区域不相交的内圈可以直接跳过
+        std::int64_t first = std::max({std::int64_t{0}, minCx - cx, cx - maxCx, minCy - cy, cy - maxCy});
+        for (std::int64_t d = first;; ++d) {
+            auto offer = [&](const Entry& e) { best.offer(e.id, squaredDistance(e, qx, qy)); };
+            std::int64_t x0 = std::max<std::int64_t>(cx - d, minCx), x1 = std::min<std::int64_t>(cx + d, maxCx);
+            std::int64_t y0 = std::max<std::int64_t>(cy - d, minCy), y1 = std::min<std::int64_t>(cy + d, maxCy);
+            for (std::int64_t y = y0; y <= y1; ++y) {
+                if (y == cy - d || y == cy + d) {
+                    visitRow(y, x0, x1, offer);
+                } else {
+                    if (cx - d >= minCx) {
+                        visitRow(y, cx - d, cx - d, offer);
+                    }
+                    if (d != 0 && cx + d <= maxCx) {
+                        visitRow(y, cx + d, cx + d, offer);
+                    }
+                }
+            }
+            if (cx - d <= minCx && cx + d >= maxCx && cy - d <= minCy && cy + d >= maxCy) {
+                break; // 已经覆盖了所有点
+            }
+            // 查询点到第 d 圈外边界的最短距离，圈外的点不会比它更近
+            double reach = std::min({qx - static_cast<double>(cx - d) * cell, static_cast<double>(cx + d + 1) * cell - qx,
+                                     qy - static_cast<double>(cy - d) * cell, static_cast<double>(cy + d + 1) * cell - qy});
+            if (best.full() && best.worst() <= reach * reach) {
+                break;
+            }
+        }
+        best.finish();
+    }
+
+private:
+    struct Entry {
+        double x;
+        double y;
+        std::int32_t cx; // 所在格子，用来排除落到同一个桶的其他格子
+        std::int32_t cy;
+        std::uint32_t id;
+    };
+
+    // 坐标很大时把格子坐标限制在 int32 的一半以内，查询时的加减不会溢出
+    std::int32_t cellCoord(double v) const {
+        double c = std::floor(v * inverseCell);
+        constexpr double kLimit = static_cast<double>(INT32_MAX / 2);
+        return static_cast<std::int32_t>(std::clamp(c, -kLimit, kLimit));
+    }
+
+    // 行号哈希后加上列号: 同一行相邻的格子在相邻的桶里
+    std::uint32_t bucketIndex(std::int64_t cx, std::int64_t cy) const {
+        std::uint64_t row = (static_cast<std::uint64_t>(cy) * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits);
+        return static_cast<std::uint32_t>((row + static_cast<std::uint64_t>(cx)) & ((std::uint64_t{1} << bucketBits) - 1));
+    }
+
+    static double squaredDistance(const Entry& e, double qx, double qy) {
+        double dx = e.x - qx;
+        double dy = e.y - qy;
+        return dx * dx + dy * dy;
+    }
+
+    // 第 cy 行中 cx0 到 cx1 的格子。这些格子的桶是连续的 (最多在桶数组末尾绕回一次)，
+    // 格子数不少于桶数时每个桶都可能包含这一行的点，直接扫描所有点
+    template <class Visit>
+    void visitRow(std::int64_t cy, std::int64_t cx0, std::int64_t cx1, Visit&& visit) const {
+        std::size_t buckets = bucketStart.size() - 1;
+        std::size_t first = bucketIndex(cx0, cy);
+        std::size_t last = first + static_cast<std::size_t>(cx1 - cx0); // 可能超出桶数
+        auto scan = [&](std::uint32_t begin, std::uint32_t end) {
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const Entry& e = entries[i];
+                if (e.cy == cy && e.cx >= cx0 && e.cx <= cx1) {
+                    visit(e);
+                }
+            }
+        };
+        if (cx1 - cx0 + 1 >= static_cast<std::int64_t>(buckets)) {
+            scan(0, static_cast<std::uint32_t>(entries.size()));
+        } else if (last < buckets) {
+            scan(bucketStart[first], bucketStart[last + 1]);
+        } else {
+            scan(bucketStart[first], bucketStart[buckets]);
+            scan(bucketStart[0], bucketStart[last - buckets + 1]);
+        }
+    }
+
+    // 对矩形覆盖的每个格子里的点调用 visit (调用者自己做精确判断)。
+    // 格子数比桶数还多时 (查询范围相对格子太大)，直接扫描所有点更快。
+    template <class Visit>
+    void forEachCandidate(double x0, double y0, double x1, double y1, Visit&& visit) const {
+        if (entries.empty() || !(x0 <= x1) || !(y0 <= y1)) {
+            return;
+        }
+        std::int64_t cx0 = std::max<std::int64_t>(cellCoord(x0), minCx), cx1 = std::min<std::int64_t>(cellCoord(x1), maxCx);
+        std::int64_t cy0 = std::max<std::int64_t>(cellCoord(y0), minCy), cy1 = std::min<std::int64_t>(cellCoord(y1), maxCy);
+        if (cx0 > cx1 || cy0 > cy1) {
+            return;
+        }
+        if ((cx1 - cx0 + 1) * (cy1 - cy0 + 1) > static_cast<std::int64_t>(bucketStart.size() - 1)) {
+            for (const Entry& e : entries) {
+                visit(e);
+            }
+            return;
+        }
+        for (std::int64_t cy = cy0; cy <= cy1; ++cy) {
+            visitRow(cy, cx0, cx1, visit);
+        }
+    }
+
+    template <class Visit>
+    void forEachInRadius(const Vector2D& center, double r, Visit&& visit) const {
+        double qx = center.getX(), qy = center.getY();
+        double r2 = r * r;
+        forEachCandidate(qx - r, qy - r, qx + r, qy + r, [&](const Entry& e) {
+            if (squaredDistance(e, qx, qy) <= r2) {
+                visit(e);
+            }
+        });
+    }
+
+    double cell;
+    double inverseCell;
+    unsigned bucketBits = 4;
+    std::int32_t minCx = 0, maxCx = -1, minCy = 0, maxCy = -1; // 已占用格子的范围
+    std::vector<Entry> entries;             // 按桶排序的点
+    std::vector<std::uint32_t> bucketStart; // 第 b 个桶的点是 entries[bucketStart[b] .. bucketStart[b + 1])
+    std::vector<std::uint32_t> bucketOf;    // build 用的临时数组，保留下来供下一次 build 复用
+    std::vector<std::uint32_t> cursor;
+};
+
+// === KdTree (静态 k-d 树) 类定义 ===
+// build 把点重新排列，使树的结构隐含在数组下标里: 区间 [lo, hi) 的根是中间的元素 mid，
+// 左子树是 [lo, mid)，右子树是 [mid + 1, hi)；深度为偶数的节点按 x 划分，奇数按 y 划分。
+// 不需要存储任何指针或节点，坐标按 x、y 分成两个连续数组，元素不超过 kLeafSize 的区间直接线性扫描。
+// 建树是 O(n log n)，之后不能增删点 (点变化后需要重新 build)。
+class KdTree : public SpatialBatchQueries<KdTree> {
+public:
+    static constexpr std::size_t kLeafSize = 16;
+
+    KdTree() = default;
+    explicit KdTree(std::span<const Vector2D> points) { build(points); }
+
+    void build(std::span<const Vector2D> points) {
+        std::size_t n = points.size();
+        if (n >= UINT32_MAX) {
+            throw std::length_error("KdTree: too many points");
+        }
+        ids.resize(n);
+        std::iota(ids.begin(), ids.end(), 0u);
+        partition(points, 0, n, 0);
+        xs.resize(n);
+        ys.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] = points[ids[i]].getX();
+            ys[i] = points[ids[i]].getY();
+        }
+    }
+
+    std::size_t size() const { return ids.size(); }
+
+    // 把距离 center 不超过 r 的点的 id 追加到 out (顺序不确定)
+    void radius(const Vector2D& center, double r, std::vector<std::uint32_t>& out) const {
+        if (r >= 0.0) {
+            radiusNode(0, ids.size(), 0, center.getX(), center.getY(), r * r, [&](std::size_t i) { out.push_back(ids[i]); });
+        }
+    }
+
+    std::size_t countRadius(const Vector2D& center, double r) const {
+        std::size_t count = 0;
+        if (r >= 0.0) {
+            radiusNode(0, ids.size(), 0, center.getX(), center.getY(), r * r, [&](std::size_t) { ++count; });
+        }
+        return count;
+    }
+
+    // 把 min.x <= x <= max.x 且 min.y <= y <= max.y 的点的 id 追加到 out
+    void box(const Vector2D& min, const Vector2D& max, std::vector<std::uint32_t>& out) const {
+        boxNode(0, ids.size(), 0, min.getX(), min.getY(), max.getX(), max.getY(), out);
+    }
+
+    // 最近的 k 个点，按距离从近到远写入 out (原有内容被清除)
+    void nearest(const Vector2D& query, std::size_t k, std::vector<Neighbor>& out) const {
+        detail::KBest best(out, std::min(k, ids.size()));
+        if (k != 0) {
+            nearestNode(0, ids.size(), 0, query.getX(), query.getY(), best);
+        }
+        best.finish();
+    }
+
+private:
+    // 用 nth_element 把区间的中位数放到中间，左边的坐标都不大于它，右边的都不小于它
+    void partition(std::span<const Vector2D> points, std::size_t lo, std::size_t hi, unsigned depth) {
+        while (hi - lo > kLeafSize) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (depth % 2 == 0) {
+                std::nth_element(ids.begin() + lo, ids.begin() + mid, ids.begin() + hi,
+                                 [&](std::uint32_t a, std::uint32_t b) { return points[a].getX() < points[b].getX(); });
+            } else {
+                std::nth_element(ids.begin() + lo, ids.begin() + mid, ids.begin() + hi,
+                                 [&](std::uint32_t a, std::uint32_t b) { return points[a].getY() < points[b].getY(); });
+            }
+            partition(points, lo, mid, depth + 1);
+            lo = mid + 1; // 右子树用循环代替递归
+            ++depth;
+        }
+    }
+
+    double squaredDistance(std::size_t i, double qx, double qy) const {
+        double dx = xs[i] - qx;
+        double dy = ys[i] - qy;
+        return dx * dx + dy * dy;
+    }
+
+    // 先进入查询点所在的一侧；另一侧只有在分割线离查询点足够近时才需要访问
+    template <class Visit>
+    void radiusNode(std::size_t lo, std::size_t hi, unsigned depth, double qx, double qy, double r2, Visit&& visit) const {
+        while (hi - lo > kLeafSize) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            double diff = depth % 2 == 0 ? qx - xs[mid] : qy - ys[mid];
+            if (squaredDistance(mid, qx, qy) <= r2) {
+                visit(mid);
+            }
+            if (diff * diff <= r2) {
+                if (diff < 0) {
+                    radiusNode(mid + 1, hi, depth + 1, qx, qy, r2, visit);
+                    hi = mid;
+                } else {
+                    radiusNode(lo, mid, depth + 1, qx, qy, r2, visit);
+                    lo = mid + 1;
+                }
+            } else if (diff < 0) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+            ++depth;
+        }
+        for (std::size_t i = lo; i < hi; ++i) {
+            if (squaredDistance(i, qx, qy) <= r2) {
+                visit(i);
+            }
+        }
+    }
+
+    void boxNode(std::size_t lo, std::size_t hi, unsigned depth, double x0, double y0, double x1, double y1,
+                 std::vector<std::uint32_t>& out) const {
+        while (hi - lo > kLeafSize) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (xs[mid] >= x0 && xs[mid] <= x1 && ys[mid] >= y0 && ys[mid] <= y1) {
+                out.push_back(ids[mid]);
+            }
+            double split = depth % 2 == 0 ? xs[mid] : ys[mid];
+            double low = depth % 2 == 0 ? x0 : y0;
+            double high = depth % 2 == 0 ? x1 : y1;
+            bool goLeft = low <= split;
+            bool goRight = high >= split;
+            if (goLeft && goRight) {
+                boxNode(lo, mid, depth + 1, x0, y0, x1, y1, out);
+                lo = mid + 1;
+            } else if (goLeft) {
+                hi = mid;
+            } else if (goRight) {
+                lo = mid + 1;
+            } else {
+                return; // 矩形无效 (min > max 或 NaN)
+            }
+            ++depth;
+        }
+        for (std::size_t i = lo; i < hi; ++i) {
+            if (xs[i] >= x0 && xs[i] <= x1 && ys[i] >= y0 && ys[i] <= y1) {
+                out.push_back(ids[i]);
+            }
+        }
+    }
+
+    void nearestNode(std::size_t lo, std::size_t hi, unsigned depth, double qx, double qy,
+                     detail::KBest& best) const {
+        if (hi - lo <= kLeafSize) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                best.offer(ids[i], squaredDistance(i, qx, qy));
+            }
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        best.offer(ids[mid], squaredDistance(mid, qx, qy));
+        double diff = depth % 2 == 0 ? qx - xs[mid] : qy - ys[mid];
+        if (diff < 0) {
+            nearestNode(lo, mid, depth + 1, qx, qy, best);
+            if (diff * diff <= best.worst()) {
+                nearestNode(mid + 1, hi, depth + 1, qx, qy, best);
+            }
+        } else {
+            nearestNode(mid + 1, hi, depth + 1, qx, qy, best);
+            if (diff * diff <= best.worst()) {
+                nearestNode(lo, mid, depth + 1, qx, qy, best);
+            }
+        }
+    }
+
+    std::vector<double> xs;          // 重新排列后的坐标
+    std::vector<double> ys;
+    std::vector<std::uint32_t> ids;  // 重新排列后第 i 个点原来的下标
+};
+
+} // namespace spatial
+
+#endif // SPATIAL_INDEX_H
@@ -0,0 +1,75 @@
+// Txn.h
+#ifndef TXN_H
+#define TXN_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Money.h"
+
+// 交易类型
+enum class TxnType : std::uint8_t {
+    Deposit,   // 存款
+    Withdraw   // 取款
+};
+
+// 一笔交易 (不包含账户信息，用于 BankAccount::apply)
+struct Txn {
+    TxnType type;
+    Money amount;
+};
+
+// 在余额 running 上试算一笔交易: 被拒绝时返回 true 且 running 不变，否则更新 running。
+// 只用比较和条件选择，没有分支，批量校验循环里编译器可以生成 cmov 而不是跳转。
+// running 始终非负，所以取款的减法不会溢出；存款需要检查是否超过上限。
+inline bool tryApplyTxn(Money::Cents& running, const Txn& txn) {
+    Money::Cents amount = txn.amount.cents();
+    bool isWithdraw = txn.type == TxnType::Withdraw;
+    bool rejected = (amount <= 0)
+                  | (isWithdraw & (amount > running))
+                  | (!isWithdraw & (amount > std::numeric_limits<Money::Cents>::max() - running));
+    Money::Cents delta = isWithdraw ? -amount : amount;
+    running += rejected ? 0 : delta;
+    return rejected;
+}
+
+// === BatchResult (批量交易结果) ===
+// 用位图记录每一笔交易是否被拒绝: 第 i 位为 1 表示第 i 笔交易被拒绝
+// (余额不足、金额不为正数、余额溢出或账户不存在)。
+// 批量交易是 "全有或全无" 的: 只要有一笔被拒绝，整批都不会生效。
+class BatchResult {
+public:
+    explicit BatchResult(std::size_t txnCount)
+        : count(txnCount), words((txnCount + 63) / 64, 0) {}
+
+    // 整批交易是否已提交
+    bool committed() const { return rejectedCount() == 0; }
+
+    std::size_t size() const { return count; }
+
+    bool isRejected(std::size_t index) const {
+        return (words[index / 64] >> (index % 64)) & 1u;
+    }
+
+    std::size_t rejectedCount() const {
+        std::size_t total = 0;
+        for (std::uint64_t word : words) {
+            total += static_cast<std::size_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    // 原始位图，每个 uint64_t 保存 64 笔交易的结果
+    const std::vector<std::uint64_t>& bitmap() const { return words; }
+
+    // 校验循环按 64 笔一组生成结果，整字写入，避免逐位修改
+    void setWord(std::size_t wordIndex, std::uint64_t word) { words[wordIndex] = word; }
+
+private:
+    std::size_t count;
+    std::vector<std::uint64_t> words;
+};
+
+#endif // TXN_H
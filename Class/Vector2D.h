@@ -0,0 +1,169 @@
+// Vector2D.h
+#ifndef VECTOR2D_H
+#define VECTOR2D_H
+
+#include <iostream>
+#include <cmath> // 为了使用 sqrt (平方根)
+#include <iomanip> // 为了 std::fixed 和 std::setprecision
+#include <type_traits> // 为了 std::is_constant_evaluated 和下面的 static_assert
+
+// --- 可选的跟踪日志 ---
+// 默认不输出任何日志，构造向量没有任何额外开销。
+// 编译时加 -DVECTOR2D_TRACE 会通过 LOG_TRACE 记录构造和加法 (常量求值时不会记录)。
+#ifdef VECTOR2D_TRACE
+#include "Log.h"
+#define VECTOR2D_LOG(...)                      \
+    do {                                       \
+        if (!std::is_constant_evaluated()) {   \
+            LOG_TRACE(__VA_ARGS__);            \
+        }                                      \
+    } while (0)
+#else
+#define VECTOR2D_LOG(...) ((void)0)
+#endif
+
+// Vector2D 是一个值类型:
+//  - 拷贝构造、拷贝赋值、析构都由编译器生成 (平凡的)，容器可以直接 memcpy，编译器可以向量化循环；
+//  - 所有运算都是 constexpr，可以在编译期计算 (magnitude 除外，std::sqrt 在 C++20 中不是 constexpr)。
+class Vector2D {
+private:
+    double x; // x分量
+    double y; // y分量
+
+public:
+    // --- 1. 构造函数 ---
+
+    // (a) 默认构造函数
+    constexpr Vector2D() : x(0.0), y(0.0) { // 使用成员初始化列表
+        VECTOR2D_LOG("默认构造函数: Vector2D(0, 0) 已创建.");
+    }
+
+    // (b) 参数化构造函数
+    constexpr Vector2D(double x_val, double y_val) : x(x_val), y(y_val) { // 成员初始化列表
+        VECTOR2D_LOG("参数化构造函数: Vector2D(", x, ", ", y, ") 已创建.");
+    }
+
+    // (c) 拷贝构造函数、拷贝赋值运算符、析构函数
+    // 不显式定义，由编译器生成。对于只有简单数据成员的类，编译器生成的版本就是逐个成员拷贝，
+    // 而且是 "平凡的" (trivial): 拷贝等价于 memcpy，析构什么也不做。
+    // 一旦自己写了其中任何一个 (哪怕内容一样)，类型就不再平凡，std::vector 扩容时只能逐个调用。
+
+    // --- 2. 成员函数 ---
+
+    // Getter 方法 (const 表示它们不修改对象状态)
+    constexpr double getX() const { return x; }
+    constexpr double getY() const { return y; }
+
+    // Setter 方法
+    constexpr void setX(double newX) { this->x = newX; } // this->x 明确指向成员变量 x
+    constexpr void setY(double newY) { this->y = newY; }
+
+    // 模的平方，不需要开方，比较长度时优先使用
+    constexpr double magnitudeSquared() const {
+        return x * x + y * y;
+    }
+
+    // 计算向量的模（长度）
+    double magnitude() const {
+        return std::sqrt(magnitudeSquared());
+    }
+
+    // 点积: |a||b|cos(θ)
+    constexpr double dot(const Vector2D& other) const {
+        return x * other.x + y * other.y;
+    }
+
+    // 叉积 (二维时是一个标量，即三维叉积的 z 分量): |a||b|sin(θ)，
+    // 大于 0 表示 other 在当前向量的逆时针方向
+    constexpr double cross(const Vector2D& other) const {
+        return x * other.y - y * other.x;
+    }
+
+    // 近似相等: 每个分量的差不超过 epsilon 乘以分量的量级 (量级小于 1 时按 1 计算，即绝对误差)
+    constexpr bool approxEqual(const Vector2D& other, double epsilon = 1e-9) const {
+        auto abs = [](double v) { return v < 0 ? -v : v; };
+        auto close = [&](double a, double b) {
+            double scale = abs(a) > abs(b) ? abs(a) : abs(b);
+            return abs(a - b) <= epsilon * (scale > 1.0 ? scale : 1.0);
+        };
+        return close(x, other.x) && close(y, other.y);
+    }
+
+    // --- 3. 运算符重载 ---
+
+    // (a) 复合赋值运算符 (+= -= *= /=)
+    // 修改当前对象并返回对自身的引用，二元运算符基于它们实现。
+    constexpr Vector2D& operator+=(const Vector2D& other) {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
+
+    constexpr Vector2D& operator-=(const Vector2D& other) {
+        x -= other.x;
+        y -= other.y;
+        return *this;
+    }
+
+    constexpr Vector2D& operator*=(double s) {
+        x *= s;
+        y *= s;
+        return *this;
+    }
+
+    // 除以 0 的结果遵循浮点规则 (inf 或 nan)，和 double 本身的除法一致
+    constexpr Vector2D& operator/=(double s) {
+        x /= s;
+        y /= s;
+        return *this;
+    }
+
+    // (b) 取负 (-v)
+    constexpr Vector2D operator-() const {
+        return Vector2D(-x, -y);
+    }
+
+    // (c) 向量加减法、数乘、数除
+    // 写成友元函数，左右操作数都允许隐式转换，数乘也可以写成 2.0 * v。
+    friend constexpr Vector2D operator+(Vector2D a, const Vector2D& b) {
+        VECTOR2D_LOG("调用 operator+ for Vector2D(", a.x, ", ", a.y,
+                     ") + Vector2D(", b.x, ", ", b.y, ")");
+        return a += b; // a 是按值传入的副本，直接在上面修改
+    }
+
+    friend constexpr Vector2D operator-(Vector2D a, const Vector2D& b) { return a -= b; }
+    friend constexpr Vector2D operator*(Vector2D v, double s) { return v *= s; }
+    friend constexpr Vector2D operator*(double s, Vector2D v) { return v *= s; }
+    friend constexpr Vector2D operator/(Vector2D v, double s) { return v /= s; }
+
+    // (d) 向量相等性比较 (== 和 !=)
+    // 精确比较每个分量。浮点计算的结果通常有舍入误差，比较计算结果时应该用 approxEqual。
+    // C++20 中 != 由 == 自动生成。
+    constexpr bool operator==(const Vector2D& other) const = default;
+
+
+    // --- 友元函数 (用于重载 <<) ---
+    // `std::ostream& operator<<` 通常被重载为友元函数或非成员函数，
+    // 因为它的左操作数是 `std::ostream` 对象 (例如 `std::cout`)，而不是 `Vector2D` 对象。
+    // 友元函数可以访问类的私有成员。
+    friend std::ostream& operator<<(std::ostream& os, const Vector2D& vec);
+};
+
+// 重载输出流运算符 << 的定义 (作为友元函数)
+// 定义在头文件中的非成员函数需要加 inline，否则多个 .cpp 包含时会重复定义
+inline std::ostream& operator<<(std::ostream& os, const Vector2D& vec) {
+    os << "Vector(" << std::fixed << std::setprecision(2) << vec.x
+       << ", " << std::fixed << std::setprecision(2) << vec.y << ")";
+    return os;
+}
+
+// 编译期检查: 平凡可拷贝、大小就是两个 double、可以在常量表达式中使用
+static_assert(std::is_trivially_copyable_v<Vector2D>);
+static_assert(std::is_trivially_destructible_v<Vector2D>);
+static_assert(sizeof(Vector2D) == 2 * sizeof(double));
+static_assert(Vector2D(1.0, 2.0) + Vector2D(3.0, 4.0) == Vector2D(4.0, 6.0));
+static_assert((Vector2D(4.0, 6.0) - Vector2D(1.0, 2.0)) * 2.0 / 3.0 == Vector2D(2.0, 8.0 / 3.0));
+static_assert(Vector2D(1.0, 0.0).cross(Vector2D(0.0, 1.0)) == 1.0);
+static_assert(Vector2D(0.1 + 0.2, 1.0).approxEqual(Vector2D(0.3, 1.0)));
+
+#endif // VECTOR2D_H
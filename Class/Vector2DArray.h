@@ -0,0 +1,480 @@
+// Vector2DArray.h
+#ifndef VECTOR2D_ARRAY_H
+#define VECTOR2D_ARRAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "Vector2D.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VECTOR2D_ARRAY_X86 1
+#else
+#define VECTOR2D_ARRAY_X86 0
+#endif
+
+// 批量运算使用的指令集。运行时按 CPU 支持情况选择最高的一级
+enum class SimdLevel {
+    Scalar, // 普通循环 (编译器默认的指令集，x86-64 上是 SSE2)
+    Avx2,   // 每条指令处理 4 个 double
+    Avx512  // 每条指令处理 8 个 double
+};
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "AVX-512";
+        case SimdLevel::Avx2:   return "AVX2";
+        default:                return "Scalar";
+    }
+}
+
+// 当前 CPU 支持的最高级别
+inline SimdLevel detectSimdLevel() {
+#if VECTOR2D_ARRAY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::Avx2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+// ===================================================================
+// 批量运算内核
+// ===================================================================
+// 所有内核都按 SoA 布局工作: x 分量和 y 分量分别是连续的 double 数组。
+// 输出数组可以与输入数组相同 (原地运算)，因为每个元素只读写自己的位置。
+// 每个指令集一组实现: 用 target 属性让编译器只为这些函数生成 AVX2 / AVX-512 指令，
+// 程序的其他部分仍按默认指令集编译，所以同一个可执行文件可以在旧 CPU 上运行 (走 Scalar 路径)。
+namespace vector2d_kernels {
+
+struct Scalar {
+    static void add(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* ox, double* oy, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ox[i] = ax[i] + bx[i];
+            oy[i] = ay[i] + by[i];
+        }
+    }
+
+    static void scale(const double* ax, const double* ay, double s, double* ox, double* oy, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ox[i] = ax[i] * s;
+            oy[i] = ay[i] * s;
+        }
+    }
+
+    static void dot(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = ax[i] * bx[i] + ay[i] * by[i];
+        }
+    }
+
+    static void magnitude(const double* ax, const double* ay, double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i]);
+        }
+    }
+
+    // 长度为 0 的向量保持为 0
+    static void normalize(const double* ax, const double* ay, double* ox, double* oy, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            double length = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i]);
+            double inverse = length > 0.0 ? 1.0 / length : 0.0;
+            ox[i] = ax[i] * inverse;
+            oy[i] = ay[i] * inverse;
+        }
+    }
+
+    static void distance(const double* ax, const double* ay, const double* bx, const double* by,
+                         double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            double dx = ax[i] - bx[i];
+            double dy = ay[i] - by[i];
+            out[i] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    // 表达式模板的融合循环 (见 Vector2DExpr.h): 表达式的各个节点内联进来之后，由编译器向量化整个循环。
+    // -O2 只做代价极低的向量化，要向量化这些循环需要用 -O3 编译 (见 vector2d_expr_bench.cpp)。
+    template <class E>
+    static void evaluate(const E& expr, double* ox, double* oy, std::size_t n) {
+#pragma GCC ivdep
+        for (std::size_t i = 0; i < n; ++i) {
+            ox[i] = expr.x(i);
+            oy[i] = expr.y(i);
+        }
+    }
+};
+
+#if VECTOR2D_ARRAY_X86
+
+// 主循环每次处理 4 个元素，剩下不足 4 个的交给 Scalar
+struct Avx2 {
+    static constexpr std::size_t kLanes = 4;
+
+    [[gnu::target("avx2,fma")]]
+    static void add(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* ox, double* oy, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            _mm256_storeu_pd(ox + i, _mm256_add_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i)));
+            _mm256_storeu_pd(oy + i, _mm256_add_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i)));
+        }
+        Scalar::add(ax + i, ay + i, bx + i, by + i, ox + i, oy + i, n - i);
+    }
+
+    [[gnu::target("avx2,fma")]]
+    static void scale(const double* ax, const double* ay, double s, double* ox, double* oy, std::size_t n) {
+        __m256d factor = _mm256_set1_pd(s);
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            _mm256_storeu_pd(ox + i, _mm256_mul_pd(_mm256_loadu_pd(ax + i), factor));
+            _mm256_storeu_pd(oy + i, _mm256_mul_pd(_mm256_loadu_pd(ay + i), factor));
+        }
+        Scalar::scale(ax + i, ay + i, s, ox + i, oy + i, n - i);
+    }
+
+    [[gnu::target("avx2,fma")]]
+    static void dot(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            __m256d xx = _mm256_mul_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i));
+            _mm256_storeu_pd(out + i, _mm256_fmadd_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i), xx));
+        }
+        Scalar::dot(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+    }
+
+    [[gnu::target("avx2,fma")]]
+    static void magnitude(const double* ax, const double* ay, double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            __m256d x = _mm256_loadu_pd(ax + i);
+            __m256d y = _mm256_loadu_pd(ay + i);
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_fmadd_pd(y, y, _mm256_mul_pd(x, x))));
+        }
+        Scalar::magnitude(ax + i, ay + i, out + i, n - i);
+    }
+
+    [[gnu::target("avx2,fma")]]
+    static void normalize(const double* ax, const double* ay, double* ox, double* oy, std::size_t n) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            __m256d x = _mm256_loadu_pd(ax + i);
+            __m256d y = _mm256_loadu_pd(ay + i);
+            __m256d length = _mm256_sqrt_pd(_mm256_fmadd_pd(y, y, _mm256_mul_pd(x, x)));
+            // 长度为 0 的分量: 1/0 = inf，再用比较掩码清零
+            __m256d inverse = _mm256_and_pd(_mm256_div_pd(one, length), _mm256_cmp_pd(length, zero, _CMP_GT_OQ));
+            _mm256_storeu_pd(ox + i, _mm256_mul_pd(x, inverse));
+            _mm256_storeu_pd(oy + i, _mm256_mul_pd(y, inverse));
+        }
+        Scalar::normalize(ax + i, ay + i, ox + i, oy + i, n - i);
+    }
+
+    [[gnu::target("avx2,fma")]]
+    static void distance(const double* ax, const double* ay, const double* bx, const double* by,
+                         double* out, std::size_t n) {
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(ax + i), _mm256_loadu_pd(bx + i));
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ay + i), _mm256_loadu_pd(by + i));
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx))));
+        }
+        Scalar::distance(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+    }
+
+    template <class E>
+    [[gnu::target("avx2,fma")]]
+    static void evaluate(const E& expr, double* ox, double* oy, std::size_t n) {
+#pragma GCC ivdep
+        for (std::size_t i = 0; i < n; ++i) {
+            ox[i] = expr.x(i);
+            oy[i] = expr.y(i);
+        }
+    }
+};
+
+// 主循环每次处理 8 个元素，剩下的用掩码加载/存储一次处理完
+struct Avx512 {
+    static constexpr std::size_t kLanes = 8;
+
+    [[gnu::target("avx512f")]]
+    static __mmask8 tailMask(std::size_t remaining) {
+        return static_cast<__mmask8>((1u << remaining) - 1);
+    }
+
+    // GCC 12 的 _mm512_sqrt_pd 会触发误报的 -Wmaybe-uninitialized，改用等价的全掩码版本
+    [[gnu::target("avx512f")]]
+    static __m512d sqrt(__m512d v) {
+        return _mm512_maskz_sqrt_pd(0xFF, v);
+    }
+
+    [[gnu::target("avx512f")]]
+    static void add(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* ox, double* oy, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            _mm512_mask_storeu_pd(ox + i, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, ax + i), _mm512_maskz_loadu_pd(m, bx + i)));
+            _mm512_mask_storeu_pd(oy + i, m, _mm512_add_pd(_mm512_maskz_loadu_pd(m, ay + i), _mm512_maskz_loadu_pd(m, by + i)));
+        }
+    }
+
+    [[gnu::target("avx512f")]]
+    static void scale(const double* ax, const double* ay, double s, double* ox, double* oy, std::size_t n) {
+        __m512d factor = _mm512_set1_pd(s);
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            _mm512_mask_storeu_pd(ox + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, ax + i), factor));
+            _mm512_mask_storeu_pd(oy + i, m, _mm512_mul_pd(_mm512_maskz_loadu_pd(m, ay + i), factor));
+        }
+    }
+
+    [[gnu::target("avx512f")]]
+    static void dot(const double* ax, const double* ay, const double* bx, const double* by,
+                    double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            __m512d xx = _mm512_mul_pd(_mm512_maskz_loadu_pd(m, ax + i), _mm512_maskz_loadu_pd(m, bx + i));
+            _mm512_mask_storeu_pd(out + i, m, _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, ay + i), _mm512_maskz_loadu_pd(m, by + i), xx));
+        }
+    }
+
+    [[gnu::target("avx512f")]]
+    static void magnitude(const double* ax, const double* ay, double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            __m512d x = _mm512_maskz_loadu_pd(m, ax + i);
+            __m512d y = _mm512_maskz_loadu_pd(m, ay + i);
+            _mm512_mask_storeu_pd(out + i, m, sqrt(_mm512_fmadd_pd(y, y, _mm512_mul_pd(x, x))));
+        }
+    }
+
+    [[gnu::target("avx512f")]]
+    static void normalize(const double* ax, const double* ay, double* ox, double* oy, std::size_t n) {
+        const __m512d zero = _mm512_setzero_pd();
+        const __m512d one = _mm512_set1_pd(1.0);
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            __m512d x = _mm512_maskz_loadu_pd(m, ax + i);
+            __m512d y = _mm512_maskz_loadu_pd(m, ay + i);
+            __m512d length = sqrt(_mm512_fmadd_pd(y, y, _mm512_mul_pd(x, x)));
+            // 只对长度大于 0 的分量做除法，其余分量的倒数为 0
+            __mmask8 nonZero = _mm512_cmp_pd_mask(length, zero, _CMP_GT_OQ);
+            __m512d inverse = _mm512_maskz_div_pd(nonZero, one, length);
+            _mm512_mask_storeu_pd(ox + i, m, _mm512_mul_pd(x, inverse));
+            _mm512_mask_storeu_pd(oy + i, m, _mm512_mul_pd(y, inverse));
+        }
+    }
+
+    [[gnu::target("avx512f")]]
+    static void distance(const double* ax, const double* ay, const double* bx, const double* by,
+                         double* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; i += kLanes) {
+            __mmask8 m = n - i >= kLanes ? 0xFF : tailMask(n - i);
+            __m512d dx = _mm512_sub_pd(_mm512_maskz_loadu_pd(m, ax + i), _mm512_maskz_loadu_pd(m, bx + i));
+            __m512d dy = _mm512_sub_pd(_mm512_maskz_loadu_pd(m, ay + i), _mm512_maskz_loadu_pd(m, by + i));
+            _mm512_mask_storeu_pd(out + i, m, sqrt(_mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx))));
+        }
+    }
+
+    template <class E>
+    [[gnu::target("avx512f")]]
+    static void evaluate(const E& expr, double* ox, double* oy, std::size_t n) {
+#pragma GCC ivdep
+        for (std::size_t i = 0; i < n; ++i) {
+            ox[i] = expr.x(i);
+            oy[i] = expr.y(i);
+        }
+    }
+};
+
+#endif // VECTOR2D_ARRAY_X86
+
+} // namespace vector2d_kernels
+
+// 可以逐个元素求值的向量表达式，由 Vector2DExpr.h 中的运算符生成
+template <class E>
+concept Vector2DExpression = requires(const E& expr, std::size_t i) {
+    { expr.size() } -> std::convertible_to<std::size_t>;
+    { expr.x(i) } -> std::convertible_to<double>;
+    { expr.y(i) } -> std::convertible_to<double>;
+};
+
+// === Vector2DArray (SoA 向量数组) 类定义 ===
+// std::vector<Vector2D> 把每个向量的 x、y 放在一起 (AoS: x0 y0 x1 y1 ...)，
+// Vector2DArray 把所有 x 放在一个数组、所有 y 放在另一个数组 (SoA: x0 x1 ... / y0 y1 ...)，
+// 一条 SIMD 指令可以直接加载 4 或 8 个连续的 x 分量，不需要重新排列数据。
+//
+// 批量运算 (add、scale、dot、magnitude、normalize、distance) 按运行时检测到的指令集分派:
+// 第一次调用时检测 CPU，之后每次调用只多一次分支。setSimdLevel 可以强制使用较低的级别 (用于测试和对比)。
+// 包含 Vector2DExpr.h 之后还可以直接写 r = a + b * s - c，整个表达式在一个循环里求值。
+class Vector2DArray {
+public:
+    Vector2DArray() = default;
+    explicit Vector2DArray(std::size_t n) : xs(n, 0.0), ys(n, 0.0) {}
+
+    explicit Vector2DArray(std::span<const Vector2D> vectors) {
+        xs.reserve(vectors.size());
+        ys.reserve(vectors.size());
+        for (const Vector2D& v : vectors) {
+            xs.push_back(v.getX());
+            ys.push_back(v.getY());
+        }
+    }
+
+    // 从向量表达式构造或赋值 (见 Vector2DExpr.h): 整个表达式在一个循环里求值，没有中间数组。
+    // 表达式可以引用被赋值的数组本身 (例如 a = a + b * s)，因为每个元素只读取输入中同一位置的元素。
+    template <Vector2DExpression E>
+    Vector2DArray(const E& expr) {
+        assign(expr);
+    }
+
+    template <Vector2DExpression E>
+    Vector2DArray& operator=(const E& expr) {
+        assign(expr);
+        return *this;
+    }
+
+    std::size_t size() const { return xs.size(); }
+    bool empty() const { return xs.empty(); }
+
+    void resize(std::size_t n) {
+        xs.resize(n, 0.0);
+        ys.resize(n, 0.0);
+    }
+
+    void reserve(std::size_t n) {
+        xs.reserve(n);
+        ys.reserve(n);
+    }
+
+    void push_back(double x, double y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    void set(std::size_t i, double x, double y) {
+        xs[i] = x;
+        ys[i] = y;
+    }
+
+    Vector2D get(std::size_t i) const { return Vector2D(xs[i], ys[i]); }
+
+    std::span<double> x() { return xs; }
+    std::span<double> y() { return ys; }
+    std::span<const double> x() const { return xs; }
+    std::span<const double> y() const { return ys; }
+
+    // --- 批量运算 ---
+    // 输出会被调整为与输入相同的长度；输出可以是输入本身 (例如 add(a, b, a) 即 a += b)。
+    // 两个输入的长度必须相同，否则抛出 std::invalid_argument。
+
+    static void add(const Vector2DArray& a, const Vector2DArray& b, Vector2DArray& out) {
+        requireSameSize(a, b);
+        out.resize(a.size());
+        dispatch([&](auto kernels) {
+            kernels.add(a.xs.data(), a.ys.data(), b.xs.data(), b.ys.data(), out.xs.data(), out.ys.data(), a.size());
+        });
+    }
+
+    static void scale(const Vector2DArray& a, double s, Vector2DArray& out) {
+        out.resize(a.size());
+        dispatch([&](auto kernels) {
+            kernels.scale(a.xs.data(), a.ys.data(), s, out.xs.data(), out.ys.data(), a.size());
+        });
+    }
+
+    // out[i] = a[i] · b[i]
+    static void dot(const Vector2DArray& a, const Vector2DArray& b, std::vector<double>& out) {
+        requireSameSize(a, b);
+        out.resize(a.size());
+        dispatch([&](auto kernels) {
+            kernels.dot(a.xs.data(), a.ys.data(), b.xs.data(), b.ys.data(), out.data(), a.size());
+        });
+    }
+
+    static void magnitude(const Vector2DArray& a, std::vector<double>& out) {
+        out.resize(a.size());
+        dispatch([&](auto kernels) { kernels.magnitude(a.xs.data(), a.ys.data(), out.data(), a.size()); });
+    }
+
+    // 单位向量；长度为 0 的向量结果为 (0, 0)
+    static void normalize(const Vector2DArray& a, Vector2DArray& out) {
+        out.resize(a.size());
+        dispatch([&](auto kernels) {
+            kernels.normalize(a.xs.data(), a.ys.data(), out.xs.data(), out.ys.data(), a.size());
+        });
+    }
+
+    // out[i] = |a[i] - b[i]|
+    static void distance(const Vector2DArray& a, const Vector2DArray& b, std::vector<double>& out) {
+        requireSameSize(a, b);
+        out.resize(a.size());
+        dispatch([&](auto kernels) {
+            kernels.distance(a.xs.data(), a.ys.data(), b.xs.data(), b.ys.data(), out.data(), a.size());
+        });
+    }
+
+    // --- 指令集选择 ---
+    static SimdLevel supportedSimdLevel() {
+        static const SimdLevel detected = detectSimdLevel();
+        return detected;
+    }
+
+    static SimdLevel simdLevel() {
+        return activeLevel().load(std::memory_order_relaxed);
+    }
+
+    // 设置为高于 CPU 支持的级别时按 CPU 支持的最高级别处理
+    static void setSimdLevel(SimdLevel level) {
+        activeLevel().store(std::min(level, supportedSimdLevel()), std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<double> xs;
+    std::vector<double> ys;
+
+    template <class E>
+    void assign(const E& expr) {
+        resize(expr.size()); // 表达式引用了自身时长度相同，不会重新分配
+        dispatch([&](auto kernels) { kernels.evaluate(expr, xs.data(), ys.data(), xs.size()); });
+    }
+
+    static void requireSameSize(const Vector2DArray& a, const Vector2DArray& b) {
+        if (a.size() != b.size()) {
+            throw std::invalid_argument("Vector2DArray: size mismatch");
+        }
+    }
+
+    static std::atomic<SimdLevel>& activeLevel() {
+        static std::atomic<SimdLevel> level{supportedSimdLevel()};
+        return level;
+    }
+
+    // 以对应的内核类型 (一个空结构体) 调用 run
+    template <class F>
+    static void dispatch(F&& run) {
+        switch (simdLevel()) {
+#if VECTOR2D_ARRAY_X86
+            case SimdLevel::Avx512: run(vector2d_kernels::Avx512{}); break;
+            case SimdLevel::Avx2:   run(vector2d_kernels::Avx2{}); break;
+#endif
+            default:                run(vector2d_kernels::Scalar{}); break;
+        }
+    }
+};
+
+#endif // VECTOR2D_ARRAY_H
@@ -0,0 +1,196 @@
+// Vector2DExpr.h
+#ifndef VECTOR2D_EXPR_H
+#define VECTOR2D_EXPR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "Vector2DArray.h"
+
+// === Vector2DArray 的表达式模板 (expression templates) ===
+// 包含这个头文件后，Vector2DArray 之间可以直接用运算符计算:
+//     Vector2DArray r = a + b * s - c;
+// 运算符不立即计算，而是返回一个描述表达式的小对象 (只保存数组指针和标量)，
+// 赋值给 Vector2DArray 时才在一个循环里逐个元素求值 (按 Vector2DArray 当前的指令集级别):
+// 没有中间数组，不分配内存，每个输入数组只读一遍。
+//
+// 支持: 数组 ± 数组、数组 ± Vector2D (常量向量加到每个元素上)、-数组、数组 * 标量、标量 * 数组、数组 / 标量，
+// 以及它们的任意组合。参与运算的数组长度必须相同，否则抛出 std::invalid_argument。
+// 单个 Vector2D 不需要表达式模板: 它是平凡可拷贝的 constexpr 类型，临时对象直接放在寄存器里。
+//
+// 表达式对象引用了参与运算的数组，所以不要保存到数组销毁之后 (例如不要从函数返回 auto 表达式)。
+
+namespace vector2d_expr {
+
+inline constexpr std::size_t kAnySize = SIZE_MAX; // 常量向量可以与任意长度的表达式一起运算
+
+// 所有表达式节点的基类 (CRTP)，用于识别节点类型，并提供按下标取值 (调试时方便查看单个元素)
+template <class Derived>
+struct Expr {
+    Vector2D operator[](std::size_t i) const {
+        const Derived& self = static_cast<const Derived&>(*this);
+        return Vector2D(self.x(i), self.y(i));
+    }
+};
+
+// 叶子节点: 数组
+class ArrayRef : public Expr<ArrayRef> {
+public:
+    explicit ArrayRef(const Vector2DArray& array)
+        : xs(array.x().data()), ys(array.y().data()), n(array.size()) {}
+
+    std::size_t size() const { return n; }
+    double x(std::size_t i) const { return xs[i]; }
+    double y(std::size_t i) const { return ys[i]; }
+
+private:
+    const double* xs;
+    const double* ys;
+    std::size_t n;
+};
+
+// 叶子节点: 常量向量，每个下标的值都相同
+class Constant : public Expr<Constant> {
+public:
+    explicit Constant(const Vector2D& v) : cx(v.getX()), cy(v.getY()) {}
+
+    std::size_t size() const { return kAnySize; }
+    double x(std::size_t) const { return cx; }
+    double y(std::size_t) const { return cy; }
+
+private:
+    double cx;
+    double cy;
+};
+
+struct Plus {
+    static double apply(double a, double b) { return a + b; }
+};
+
+struct Minus {
+    static double apply(double a, double b) { return a - b; }
+};
+
+struct Times {
+    static double apply(double a, double b) { return a * b; }
+};
+
+struct DividedBy {
+    static double apply(double a, double b) { return a / b; }
+};
+
+// 两个表达式逐元素运算
+template <class Op, class L, class R>
+class Binary : public Expr<Binary<Op, L, R>> {
+public:
+    Binary(const L& l, const R& r) : left(l), right(r), n(l.size()) {
+        if (n == kAnySize) {
+            n = r.size();
+        } else if (r.size() != kAnySize && r.size() != n) {
+            throw std::invalid_argument("Vector2DArray: size mismatch");
+        }
+    }
+
+    std::size_t size() const { return n; }
+    double x(std::size_t i) const { return Op::apply(left.x(i), right.x(i)); }
+    double y(std::size_t i) const { return Op::apply(left.y(i), right.y(i)); }
+
+private:
+    L left;
+    R right;
+    std::size_t n;
+};
+
+// 表达式的每个分量与同一个标量运算 (乘或除)
+template <class Op, class E>
+class WithScalar : public Expr<WithScalar<Op, E>> {
+public:
+    WithScalar(const E& e, double s) : expr(e), scalar(s) {}
+
+    std::size_t size() const { return expr.size(); }
+    double x(std::size_t i) const { return Op::apply(expr.x(i), scalar); }
+    double y(std::size_t i) const { return Op::apply(expr.y(i), scalar); }
+
+private:
+    E expr;
+    double scalar;
+};
+
+template <class E>
+class Negate : public Expr<Negate<E>> {
+public:
+    explicit Negate(const E& e) : expr(e) {}
+
+    std::size_t size() const { return expr.size(); }
+    double x(std::size_t i) const { return -expr.x(i); }
+    double y(std::size_t i) const { return -expr.y(i); }
+
+private:
+    E expr;
+};
+
+template <class T>
+concept Node = std::is_base_of_v<Expr<T>, T>;
+
+// 可以得到一个数组长度的操作数 (数组或表达式)
+template <class T>
+concept ArrayOperand = Node<T> || std::same_as<T, Vector2DArray>;
+
+template <class T>
+concept Operand = ArrayOperand<T> || std::same_as<T, Vector2D>;
+
+// 把操作数转换为表达式节点: 节点按值保存 (都只有几个指针和标量)，数组和常量向量包装成叶子节点
+template <Node E>
+const E& asExpr(const E& e) { return e; }
+
+inline ArrayRef asExpr(const Vector2DArray& a) { return ArrayRef(a); }
+inline Constant asExpr(const Vector2D& v) { return Constant(v); }
+
+template <class T>
+using ExprOf = std::remove_cvref_t<decltype(asExpr(std::declval<const T&>()))>;
+
+} // namespace vector2d_expr
+
+// --- 运算符 ---
+// 至少一个操作数是数组或表达式; 两个 Vector2D 之间的运算仍然使用 Vector2D 自己的运算符。
+
+template <vector2d_expr::Operand L, vector2d_expr::Operand R>
+    requires(vector2d_expr::ArrayOperand<L> || vector2d_expr::ArrayOperand<R>)
+auto operator+(const L& l, const R& r) {
+    using namespace vector2d_expr;
+    return Binary<Plus, ExprOf<L>, ExprOf<R>>(asExpr(l), asExpr(r));
+}
+
+template <vector2d_expr::Operand L, vector2d_expr::Operand R>
+    requires(vector2d_expr::ArrayOperand<L> || vector2d_expr::ArrayOperand<R>)
+auto operator-(const L& l, const R& r) {
+    using namespace vector2d_expr;
+    return Binary<Minus, ExprOf<L>, ExprOf<R>>(asExpr(l), asExpr(r));
+}
+
+template <vector2d_expr::ArrayOperand E>
+auto operator-(const E& e) {
+    using namespace vector2d_expr;
+    return Negate<ExprOf<E>>(asExpr(e));
+}
+
+template <vector2d_expr::ArrayOperand E>
+auto operator*(const E& e, double s) {
+    using namespace vector2d_expr;
+    return WithScalar<Times, ExprOf<E>>(asExpr(e), s);
+}
+
+template <vector2d_expr::ArrayOperand E>
+auto operator*(double s, const E& e) {
+    using namespace vector2d_expr;
+    return WithScalar<Times, ExprOf<E>>(asExpr(e), s);
+}
+
+template <vector2d_expr::ArrayOperand E>
+auto operator/(const E& e, double s) {
+    using namespace vector2d_expr;
+    return WithScalar<DividedBy, ExprOf<E>>(asExpr(e), s);
+}
+
+#endif // VECTOR2D_EXPR_H
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BookIndex.h"
+
+// g++ book_index_bench.cpp -o book_index_bench -std=c++20 -O2
+// 用法: ./book_index_bench [书籍数量] [查询次数]
+// 生成随机书名/作者建立索引，统计多词查询、自动补全和更新的延迟分布 (p50/p99/max)。
+// 10M 本书建索引需要几 GB 内存和一两分钟。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 由音节拼出的单词，每个编号对应一个不同的词
+static std::string makeWord(std::uint64_t id) {
+    static const char* syllables[] = {"ka", "ra", "to", "mi", "su", "ne", "lo", "vi", "den", "mar",
+                                      "qui", "sha", "bel", "tor", "an", "ex", "on", "pli", "gra", "zu"};
+    std::string word;
+    do {
+        word += syllables[id % 20];
+        id /= 20;
+    } while (id > 0);
+    return word;
+}
+
+// [0, range) 中的随机编号，u^3 使小编号远比大编号常见 (近似 Zipf 分布)
+static std::uint64_t skewed(std::uint64_t& state, std::uint64_t range) {
+    double u = static_cast<double>(nextRandom(state) % 1000000) / 1000000.0;
+    return static_cast<std::uint64_t>(u * u * u * static_cast<double>(range));
+}
+
+struct Latency {
+    std::vector<double> micros;
+
+    template <class F>
+    void measure(F&& run) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    void report(const char* name) {
+        std::sort(micros.begin(), micros.end());
+        auto at = [&](double q) { return micros[static_cast<std::size_t>(q * static_cast<double>(micros.size() - 1))]; };
+        std::cout << name << ": p50 " << at(0.5) << " us, p99 " << at(0.99) << " us, max " << micros.back() << " us\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000;
+    const std::uint64_t vocabulary = 200000;
+    const std::uint64_t authors = 50000;
+    if (n == 0 || queries == 0) {
+        std::cerr << "书籍数量和查询次数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    std::uint64_t state = 88172645463325252ull;
+    auto randomTitle = [&] {
+        std::string title;
+        std::uint64_t words = 2 + nextRandom(state) % 5;
+        for (std::uint64_t w = 0; w < words; ++w) {
+            title += (w == 0 ? "" : " ") + makeWord(skewed(state, vocabulary));
+        }
+        return title;
+    };
+    auto randomAuthor = [&] {
+        return makeWord(nextRandom(state) % authors) + " " + makeWord(nextRandom(state) % authors);
+    };
+
+    // 1. 建立索引
+    BookIndex index;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        index.add(randomTitle(), randomAuthor());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "建立索引: " << n << " 本书, " << index.termCount() << " 个词, 耗时 " << elapsed.count()
+              << " 秒 (" << static_cast<std::uint64_t>(n / elapsed.count()) << " 本/秒)\n";
+
+    // 2. 多词查询: 1~3 个词，按常用程度抽取
+    Latency search;
+    std::size_t totalHits = 0;
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::string query = makeWord(skewed(state, vocabulary));
+        for (std::uint64_t extra = nextRandom(state) % 3; extra > 0; --extra) {
+            query += " " + makeWord(skewed(state, vocabulary));
+        }
+        search.measure([&] { totalHits += index.search(query, 10).size(); });
+    }
+    search.report("多词查询 (top 10)");
+    std::cout << "  平均每次返回 " << static_cast<double>(totalHits) / static_cast<double>(queries) << " 条结果\n";
+
+    // 3. 自动补全: 随机单词的 1~4 字节前缀
+    Latency complete;
+    for (std::size_t q = 0; q < queries; ++q) {
+        std::string word = makeWord(nextRandom(state) % vocabulary);
+        std::size_t length = std::min<std::size_t>(word.size(), 1 + nextRandom(state) % 4);
+        complete.measure([&] { (void)index.complete(std::string_view(word).substr(0, length)); });
+    }
+    complete.report("自动补全 (top 8)  ");
+
+    // 4. 修改书名 (对应 Book::setTitle 触发的增量更新)
+    Latency update;
+    for (std::size_t q = 0; q < std::min(queries, n); ++q) {
+        BookIndex::DocId doc = static_cast<BookIndex::DocId>(nextRandom(state) % n);
+        std::string title = randomTitle();
+        std::string author = randomAuthor();
+        update.measure([&] { index.update(doc, title, author); });
+    }
+    update.report("增量更新          ");
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <malloc.h>
+#include <string>
+#include <vector>
+#include "Car.h"
+
+// g++ car_memory_bench.cpp -o car_memory_bench -std=c++20 -O2 -DLOG_ACTIVE_LEVEL=LOG_LEVEL_OFF
+// 用法: ./car_memory_bench [车辆数] [引擎规格数]
+// 对比三种 Car 的内存占用 (按 glibc 统计的已分配堆内存的增长测量) 和构造、遍历的速度:
+//  - std::string: 型号、颜色、引擎类型都是 std::string，每辆车拷贝一份 Engine (最初的写法)；
+//  - Engine 按值: 字符串换成 InternedString，但每辆车仍然保存完整的引擎参数；
+//  - 共享规格: Car 只保存引擎规格的编号 (当前的 Car)。
+// 默认 1000 万辆车，std::string 版本需要约 1.7 GB 内存。
+
+namespace legacy {
+
+struct Engine {
+    std::string type;
+    int horsepower;
+};
+
+struct Car {
+    std::string model;
+    std::string color;
+    Engine engine;
+};
+
+} // namespace legacy
+
+namespace by_value {
+
+struct Engine {
+    InternedString type;
+    int horsepower;
+};
+
+struct Car {
+    InternedString model;
+    InternedString color;
+    Engine engine;
+};
+
+} // namespace by_value
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 当前已分配的堆内存 (字节，glibc)
+static std::size_t heapBytes() {
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+template <class F>
+static double millis(F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Catalog {
+    std::vector<std::string> models;
+    std::vector<std::string> colors;
+    std::vector<std::string> engineTypes;
+    std::vector<int> horsepowers;
+};
+
+// 对一种 Car 类型测量: 构造 n 辆车，然后统计总马力
+template <class CarT, class Make, class Horsepower>
+static void measure(const char* name, std::size_t n, Make&& make, Horsepower&& horsepower) {
+    std::size_t before = heapBytes();
+    std::vector<CarT> cars;
+    cars.reserve(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    double build = millis([&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            cars.push_back(make(nextRandom(state)));
+        }
+    });
+    std::size_t used = heapBytes() - before;
+    std::uint64_t total = 0;
+    double scan = millis([&] {
+        for (const CarT& car : cars) {
+            total += horsepower(car);
+        }
+    });
+    std::cout << name << ": sizeof = " << sizeof(CarT) << " 字节, 堆内存增加 " << used / (1024 * 1024) << " MB ("
+              << static_cast<double>(used) / n << " 字节/辆), 构造 " << build << " ms, 统计总马力 " << scan
+              << " ms (" << total << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::size_t specs = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000;
+    if (n == 0 || specs == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    Catalog catalog;
+    for (int i = 0; i < 300; ++i) {
+        catalog.models.push_back("Model Series " + std::to_string(i));
+    }
+    for (const char* color : {"Red", "Black", "White", "Silver", "Blue", "Midnight Green Metallic"}) {
+        catalog.colors.push_back(color);
+    }
+    for (std::size_t i = 0; i < specs; ++i) {
+        catalog.engineTypes.push_back(std::to_string(1 + i % 6) + ".0L Turbocharged Inline-" + std::to_string(3 + i % 5));
+        catalog.horsepowers.push_back(static_cast<int>(70 + i % 700));
+    }
+    // 共享规格的版本事先登记所有规格 (真实程序里规格来自配置或数据库)
+    std::vector<EngineSpecRegistry::Id> specIds;
+    for (std::size_t i = 0; i < specs; ++i) {
+        specIds.push_back(EngineSpecRegistry::global().intern(EngineSpec{catalog.engineTypes[i], catalog.horsepowers[i]}));
+    }
+    std::cout << n << " 辆车, " << EngineSpecRegistry::global().size() - 1 << " 种引擎规格\n\n";
+
+    auto model = [&](std::uint64_t r) -> const std::string& { return catalog.models[r % catalog.models.size()]; };
+    auto color = [&](std::uint64_t r) -> const std::string& { return catalog.colors[(r >> 16) % catalog.colors.size()]; };
+    auto spec = [&](std::uint64_t r) { return static_cast<std::size_t>((r >> 32) % specs); };
+
+    measure<legacy::Car>("std::string", n,
+        [&](std::uint64_t r) {
+            return legacy::Car{model(r), color(r), legacy::Engine{catalog.engineTypes[spec(r)], catalog.horsepowers[spec(r)]}};
+        },
+        [](const legacy::Car& car) { return car.engine.horsepower; });
+
+    // 每个字符串只驻留一次，构造时直接使用驻留后的句柄
+    std::vector<InternedString> models(catalog.models.begin(), catalog.models.end());
+    std::vector<InternedString> colors(catalog.colors.begin(), catalog.colors.end());
+    std::vector<InternedString> engineTypes(catalog.engineTypes.begin(), catalog.engineTypes.end());
+    measure<by_value::Car>("Engine 按值", n,
+        [&](std::uint64_t r) {
+            return by_value::Car{models[r % models.size()], colors[(r >> 16) % colors.size()],
+                                 by_value::Engine{engineTypes[spec(r)], catalog.horsepowers[spec(r)]}};
+        },
+        [](const by_value::Car& car) { return car.engine.horsepower; });
+
+    measure<Car>("共享规格", n,
+        [&](std::uint64_t r) {
+            return Car(models[r % models.size()], colors[(r >> 16) % colors.size()], Engine(specIds[spec(r)]));
+        },
+        [](const Car& car) { return car.getEngine().horsepower(); });
+    return 0;
+}
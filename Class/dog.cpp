@@ -1,5 +1,7 @@
 #include <iostream>
 #include <string> // 为了使用 std::string
+#include "Log.h"  // 日志: 类的成员函数通过 LOG_xxx 输出
+#include "InternedString.h" // 驻留字符串: 4 字节的不可变字符串句柄
 
 // 定义一个名为 Dog 的类
 class Dog {
@@ -7,15 +9,16 @@ class Dog {
 public:
     // 构造函数：当创建 Dog 类的对象时自动调用
     // 它用于初始化对象的成员变量
-    Dog(std::string dogName, int dogAge) {
+    // dogName 可以是字符串字面量、std::string 或 InternedString
+    Dog(InternedString dogName, int dogAge) {
         name = dogName;
         age = dogAge;
-        std::cout << name << " 对象被创建了！" << std::endl;
+        LOG_TRACE(name, " 对象被创建了！");
     }
 
     // 成员函数：让狗叫
     void bark() {
-        std::cout << name << " 说：汪汪！" << std::endl;
+        LOG_INFO(name, " 说：汪汪！");
     }
 
     // 成员函数：获取狗的年龄
@@ -28,19 +31,19 @@ public:
         if (newAge > 0 && newAge < 30) { // 做一个简单的年龄校验
             age = newAge;
         } else {
-            std::cout << "无效的年龄！" << std::endl;
+            LOG_WARN("无效的年龄！");
         }
     }
 
     // 成员函数：显示狗的信息
     void displayInfo() {
-        std::cout << "名字: " << name << ", 年龄: " << age << std::endl;
+        LOG_INFO("名字: ", name, ", 年龄: ", age);
     }
 
 // 私有成员: 这些成员只能在类的内部访问
 // 这是封装的概念，有助于保护数据
 private:
-    std::string name; // 狗的名字
+    InternedString name; // 狗的名字 (同名的狗共享同一份字符串)
     int age;          // 狗的年龄
 }; // 类定义结束时需要分号
 
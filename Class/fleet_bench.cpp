@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Fleet.h"
+
+// g++ fleet_bench.cpp -o fleet_bench -std=c++20 -O3 -pthread
+// 用法: ./fleet_bench [车辆数] [tick 数] [线程数]
+// 模拟一个车队: 随机马力和油量，全部点火后每 60 个 tick (1 秒) 随机调整 1% 车辆的油门、熄火或重新启动。
+// 报告每秒 tick 数、每秒更新的车辆数和各个系统的耗时，
+// 最后用一个较小的车队核对单线程与多线程的模拟结果完全相同。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static float uniform(std::uint64_t& state, float low, float high) {
+    return low + static_cast<float>(nextRandom(state) >> 40) * 0x1.0p-24f * (high - low);
+}
+
+// 建立车队并模拟 ticks 步，返回最后的总油量 (用于核对)
+static double simulate(Fleet& fleet, std::size_t cars, std::size_t ticks, bool verbose) {
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    std::vector<Fleet::EntityId> ids;
+    ids.reserve(cars);
+    for (std::size_t i = 0; i < cars; ++i) {
+        ids.push_back(fleet.addCar(uniform(state, 70.0f, 800.0f), uniform(state, 5.0f, 60.0f)));
+        fleet.setThrottle(ids.back(), uniform(state, 0.0f, 1.0f));
+    }
+    fleet.startAll();
+
+    double commandSeconds = 0;
+    for (std::size_t t = 0; t < ticks; ++t) {
+        if (t % 60 == 59) {
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t k = 0; k < cars / 100; ++k) {
+                std::uint64_t r = nextRandom(state);
+                Fleet::EntityId id = ids[(r >> 8) % cars];
+                switch (r % 4) {
+                    case 0: fleet.stop(id); break;
+                    case 1: fleet.start(id); break;
+                    default: fleet.setThrottle(id, uniform(state, 0.0f, 1.0f)); break;
+                }
+            }
+            commandSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        fleet.tick();
+    }
+
+    if (verbose) {
+        double wall = fleet.elapsedSeconds();
+        Fleet::SystemTimings systems = fleet.systemTimings();
+        double systemTotal = systems.state + systems.rpm + systems.fuel;
+        std::cout << "模拟了 " << fleet.simulatedSeconds() << " 秒 (" << fleet.ticks() << " 个 tick), 耗时 "
+                  << wall << " 秒 (另有下达命令 " << commandSeconds << " 秒)\n";
+        std::cout << "  " << static_cast<std::uint64_t>(fleet.ticks() / wall) << " tick/秒, "
+                  << static_cast<std::uint64_t>(static_cast<double>(cars) * fleet.ticks() / wall) << " 车辆更新/秒\n";
+        std::cout << "  各系统耗时 (所有线程之和): 状态 " << systems.state << " 秒 (" << 100 * systems.state / systemTotal
+                  << "%), 转速 " << systems.rpm << " 秒 (" << 100 * systems.rpm / systemTotal << "%), 油耗 "
+                  << systems.fuel << " 秒 (" << 100 * systems.fuel / systemTotal << "%)\n";
+        std::cout << "  状态: 运行 " << fleet.countInState(Fleet::EngineState::Running)
+                  << ", 点火中 " << fleet.countInState(Fleet::EngineState::Starting)
+                  << ", 熄火中 " << fleet.countInState(Fleet::EngineState::Stopping)
+                  << ", 熄火 " << fleet.countInState(Fleet::EngineState::Off)
+                  << ", 没油 " << fleet.countInState(Fleet::EngineState::Stalled)
+                  << "; 平均转速 " << fleet.averageRpm() << ", 剩余油量 " << fleet.totalFuel() << " 升\n";
+    }
+    return fleet.totalFuel();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t cars = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    std::size_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 600;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    if (cars == 0 || threads == 0) {
+        std::cerr << "车辆数和线程数必须为正数。" << std::endl;
+        return 1;
+    }
+    std::cout << cars << " 辆车, " << threads << " 个线程\n";
+    {
+        Fleet fleet(Fleet::Config{}, threads);
+        simulate(fleet, cars, ticks, true);
+    }
+
+    // 核对: 每辆车的更新互不依赖，所以结果与线程数无关
+    std::size_t checkCars = std::min<std::size_t>(cars, 200000);
+    Fleet single(Fleet::Config{}, 1);
+    Fleet multi(Fleet::Config{}, std::max(2u, threads));
+    bool same = simulate(single, checkCars, 300, false) == simulate(multi, checkCars, 300, false);
+    std::cout << "单线程与多线程结果: " << (same ? "一致" : "不一致!") << std::endl;
+    return same ? 0 : 1;
+}
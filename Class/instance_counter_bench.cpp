@@ -0,0 +1,95 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "InstanceCounter.h"
+
+// g++ instance_counter_bench.cpp -o instance_counter_bench -std=c++20 -O2 -pthread
+// 用法: ./instance_counter_bench [线程数] [每个线程的创建/销毁次数]
+// 对比 "一个全局 std::atomic 计数器" 和 InstanceCounter (每线程计数槽) 的构造/析构吞吐量，
+// 并检查多线程交叉创建、销毁之后计数是否正确。
+
+// 对照组: 所有线程共享一个原子计数器
+struct AtomicCounted {
+    static inline std::atomic<std::int64_t> live{0};
+    AtomicCounted() noexcept { live.fetch_add(1, std::memory_order_relaxed); }
+    ~AtomicCounted() { live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+struct ShardCounted : private InstanceCounter<ShardCounted> {
+    using InstanceCounter<ShardCounted>::liveCount;
+};
+
+// 防止编译器把构造和析构整个优化掉
+template <class T>
+void churn(std::size_t ops) {
+    for (std::size_t i = 0; i < ops; ++i) {
+        T object;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        (void)object;
+    }
+}
+
+template <class T>
+double runThreads(unsigned threads, std::size_t ops) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([ops] { churn<T>(ops); });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * ops / elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 64;
+    std::size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    if (threads == 0) {
+        std::cerr << "线程数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    double atomicRate = runThreads<AtomicCounted>(threads, ops);
+    double shardRate = runThreads<ShardCounted>(threads, ops);
+    std::cout << threads << " 个线程，每个线程创建并销毁 " << ops << " 个对象\n";
+    std::cout << "全局 atomic 计数器: " << static_cast<std::uint64_t>(atomicRate) << " 次/秒\n";
+    std::cout << "InstanceCounter   : " << static_cast<std::uint64_t>(shardRate) << " 次/秒 (加速比 "
+              << shardRate / atomicRate << "x)\n";
+
+    // 正确性: 每个线程创建一批对象交给下一个线程销毁，创建线程随后退出
+    const std::size_t perThread = 1000;
+    std::vector<std::vector<std::unique_ptr<ShardCounted>>> batches(threads);
+    std::vector<std::thread> producers;
+    for (unsigned t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < perThread; ++i) {
+                batches[t].push_back(std::make_unique<ShardCounted>());
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    std::int64_t afterCreate = ShardCounted::liveCount();
+
+    std::vector<std::thread> consumers;
+    for (unsigned t = 0; t < threads; ++t) {
+        consumers.emplace_back([&, t] { batches[(t + 1) % threads].clear(); });
+    }
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+    std::int64_t afterDestroy = ShardCounted::liveCount();
+
+    bool correct = afterCreate == static_cast<std::int64_t>(threads * perThread) && afterDestroy == 0;
+    std::cout << "跨线程创建/销毁: 创建后 " << afterCreate << " 个, 销毁后 " << afterDestroy << " 个 -> "
+              << (correct ? "正确" : "错误！") << "\n";
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InternedString.h"
+
+// g++ interned_string_bench.cpp -o interned_string_bench -std=c++20 -O2 -pthread
+// 用法: ./interned_string_bench [记录数量] [不同作者数量] [线程数]
+// 模拟书目中大量重复的作者名: 对比 std::string 与 InternedString 的内存占用、
+// "同一作者" 比较的速度，以及多线程并发驻留的吞吐量。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static std::string authorName(std::uint64_t id) {
+    return "Author Name Number " + std::to_string(id); // 超过 15 字节，std::string 需要堆分配
+}
+
+template <class F>
+static double millis(F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    std::uint64_t distinct = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 4;
+    if (n == 0 || distinct == 0 || threads == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::uint64_t> ids(n);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (std::uint64_t& id : ids) {
+        id = nextRandom(state) % distinct;
+    }
+
+    // 1. 构造
+    std::vector<std::string> plain;
+    std::vector<InternedString> interned;
+    plain.reserve(n);
+    interned.reserve(n);
+    double plainBuild = millis([&] {
+        for (std::uint64_t id : ids) {
+            plain.push_back(authorName(id));
+        }
+    });
+    double internBuild = millis([&] {
+        for (std::uint64_t id : ids) {
+            interned.push_back(authorName(id));
+        }
+    });
+    std::size_t plainBytes = n * sizeof(std::string);
+    for (const std::string& s : plain) {
+        plainBytes += s.capacity() > 15 ? s.capacity() + 1 : 0;
+    }
+    std::size_t internBytes = n * sizeof(InternedString) + StringPool::global().bytesUsed();
+    std::cout << n << " 条记录, " << distinct << " 个不同作者\n";
+    std::cout << "构造: std::string " << plainBuild << " ms, InternedString " << internBuild << " ms\n";
+    std::cout << "内存: std::string 约 " << plainBytes / (1024 * 1024) << " MB, InternedString 约 "
+              << internBytes / (1024 * 1024) << " MB (不含堆分配器和哈希表的开销)\n";
+
+    // 2. 统计与第一条记录同一作者的记录数
+    std::size_t plainSame = 0, internSame = 0;
+    double plainCompare = millis([&] {
+        for (const std::string& s : plain) {
+            plainSame += s == plain[0];
+        }
+    });
+    double internCompare = millis([&] {
+        for (InternedString s : interned) {
+            internSame += s == interned[0];
+        }
+    });
+    std::cout << "相等比较: std::string " << plainCompare << " ms, InternedString " << internCompare << " ms"
+              << (plainSame == internSame ? "" : "  (结果不一致!)") << "\n";
+
+    // 3. 多线程并发驻留 (大部分是已存在的字符串)
+    std::vector<std::thread> workers;
+    double concurrent = millis([&] {
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::uint64_t local = 0x9E3779B97F4A7C15ull * (t + 1);
+                for (std::size_t i = 0; i < n / threads; ++i) {
+                    InternedString s = authorName(nextRandom(local) % (distinct * 2));
+                    (void)s;
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+    std::cout << threads << " 个线程并发驻留: " << static_cast<std::uint64_t>(n / concurrent * 1000) << " 次/秒, 字符串池现有 "
+              << StringPool::global().size() << " 个字符串\n";
+    return plainSame == internSame ? 0 : 1;
+}
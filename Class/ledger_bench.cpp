@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Ledger.h"
+
+// g++ ledger_bench.cpp -o ledger_bench -std=c++20 -O2 -pthread
+// 用法: ./ledger_bench [账户数量] [每个线程的操作次数] [最大线程数]
+
+// 简单的 xorshift 随机数生成器，比 std::mt19937 轻量，避免随机数本身成为瓶颈
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t accountCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t opsPerThread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    unsigned maxThreads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    if (accountCount == 0 || opsPerThread == 0 || maxThreads == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    // 1. 预先生成账户号码，避免基准测试中测量到字符串格式化的开销
+    std::vector<std::string> accountNumbers;
+    accountNumbers.reserve(accountCount);
+    for (std::size_t i = 0; i < accountCount; ++i) {
+        accountNumbers.push_back(std::to_string(100000000 + i));
+    }
+
+    Ledger ledger;
+    auto openStart = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < accountCount; ++i) {
+        ledger.openAccount(accountNumbers[i], "用户" + std::to_string(i), Money::fromCents(100000));
+    }
+    std::chrono::duration<double> openTime = std::chrono::steady_clock::now() - openStart;
+    std::cout << "开户 " << ledger.accountCount() << " 个 (" << ledger.shardCount() << " 个分片)，耗时 "
+              << openTime.count() << " 秒\n\n";
+
+    // 2. 线程数按 1, 2, 4, ... 递增，每个线程随机挑选账户进行存款或取款
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "线程数\t总吞吐量 (ops/s)\t单线程吞吐量 (ops/s)\t加速比\n";
+    double baseline = 0.0;
+    for (unsigned threads : threadCounts) {
+        std::vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+                for (std::size_t i = 0; i < opsPerThread; ++i) {
+                    std::uint64_t r = nextRandom(state);
+                    const std::string& accNum = accountNumbers[r % accountCount];
+                    Money amount = Money::fromCents(static_cast<Money::Cents>((r >> 32) % 10000 + 1));
+                    if (r & (1ull << 20)) {
+                        ledger.deposit(accNum, amount);
+                    } else {
+                        ledger.withdraw(accNum, amount);
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double total = static_cast<double>(opsPerThread) * threads / elapsed.count();
+        if (threads == 1) {
+            baseline = total;
+        }
+        std::cout << threads << '\t' << static_cast<std::uint64_t>(total) << "\t\t"
+                  << static_cast<std::uint64_t>(total / threads) << "\t\t\t" << total / baseline << "x\n";
+    }
+
+    // 3. 批量交易: 一次 applyBatch 提交整批存款 (模拟夜间结算)
+    std::vector<LedgerTxn> batch;
+    batch.reserve(opsPerThread);
+    std::uint64_t state = 0xC0FFEEull;
+    for (std::size_t i = 0; i < opsPerThread; ++i) {
+        std::uint64_t r = nextRandom(state);
+        batch.push_back({accountNumbers[r % accountCount],
+                         {TxnType::Deposit, Money::fromCents(static_cast<Money::Cents>((r >> 32) % 10000 + 1))}});
+    }
+    auto batchStart = std::chrono::steady_clock::now();
+    BatchResult result = ledger.applyBatch(batch);
+    std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - batchStart;
+    std::cout << "\napplyBatch: " << batch.size() << " 笔交易, "
+              << (result.committed() ? "已提交" : "被拒绝") << ", "
+              << static_cast<std::uint64_t>(batch.size() / batchTime.count()) << " txns/s\n";
+    return 0;
+}
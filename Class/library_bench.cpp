@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Library.h"
+
+// g++ library_bench.cpp -o library_bench -std=c++20 -O2 -pthread
+// 用法: ./library_bench [书目数量] [每个书目的副本数] [线程数] [每个线程的操作次数]
+// 多个线程随机借书/还书，统计每秒处理的借阅请求数，最后核对副本数量守恒并扫描逾期。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t titles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    std::uint32_t copies = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 3;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t opsPerThread = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1000000;
+    if (titles == 0 || threads == 0) {
+        std::cerr << "书目数量和线程数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    Library library(14);
+    for (std::size_t i = 0; i < titles; ++i) {
+        library.addTitle(copies);
+    }
+
+    // 每个线程代表一批读者 (读者编号 = 线程号 * 2^20 + 序号)，每 10000 次操作算一天。
+    // 转借给排队读者的书不在 myLoans 里，不会被归还，所以排队人数会逐渐积累 (与真实情况相近)
+    std::vector<std::uint64_t> borrowed(threads), waitlisted(threads), returned(threads);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+            std::vector<std::pair<Library::TitleId, Library::PatronId>> myLoans; // 本线程的读者借到的书
+            for (std::size_t i = 0; i < opsPerThread; ++i) {
+                std::uint64_t r = nextRandom(state);
+                Library::Day today = static_cast<Library::Day>(i / 10000);
+                // 约 40% 的请求是还书 (从本线程借出的书里随机挑一本)，其余是借书
+                if (r % 10 < 4 && !myLoans.empty()) {
+                    std::size_t k = (r >> 8) % myLoans.size();
+                    Library::ReturnResult result = library.returnBook(myLoans[k].first, myLoans[k].second, today);
+                    returned[t] += result.returned;
+                    myLoans[k] = myLoans.back();
+                    myLoans.pop_back();
+                } else {
+                    Library::TitleId title = static_cast<Library::TitleId>((r >> 8) % titles);
+                    Library::PatronId patron = (t << 20) | static_cast<Library::PatronId>((r >> 40) % 100000);
+                    Library::CheckoutResult result = library.checkout(title, patron, today);
+                    if (result == Library::CheckoutResult::Borrowed) {
+                        borrowed[t]++;
+                        myLoans.emplace_back(title, patron);
+                    }
+                    waitlisted[t] += result == Library::CheckoutResult::Waitlisted;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::uint64_t totalOps = threads * opsPerThread;
+    std::uint64_t totalBorrowed = 0, totalWaitlisted = 0, totalReturned = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        totalBorrowed += borrowed[t];
+        totalWaitlisted += waitlisted[t];
+        totalReturned += returned[t];
+    }
+    std::cout << threads << " 个线程, " << titles << " 个书目 x " << copies << " 本\n";
+    std::cout << "借还请求: " << static_cast<std::uint64_t>(totalOps / elapsed.count()) << " 次/秒 ("
+              << static_cast<std::uint64_t>(totalOps / elapsed.count() / threads) << " 次/秒/线程)\n";
+    std::cout << "借到 " << totalBorrowed << " 次, 排队 " << totalWaitlisted << " 次, 归还 " << totalReturned << " 次\n";
+
+    // 守恒: 空闲副本 + 借出的副本 = 总副本数，并且有空闲副本的书目不应有人排队
+    std::uint64_t available = 0, waiting = 0;
+    bool consistent = true;
+    for (std::size_t i = 0; i < titles; ++i) {
+        Library::TitleId id = static_cast<Library::TitleId>(i);
+        available += library.availableCopies(id);
+        waiting += library.waitlistLength(id);
+        consistent &= library.availableCopies(id) == 0 || library.waitlistLength(id) == 0;
+    }
+    std::size_t loans = library.activeLoans();
+    consistent &= available + loans == titles * copies;
+    std::cout << "空闲 " << available << " 本, 借出 " << loans << " 本, 排队 " << waiting << " 人 -> "
+              << (consistent ? "一致" : "不一致！") << "\n";
+
+    // 逾期扫描: 最后一天之后再过 30 天
+    Library::Day lastDay = static_cast<Library::Day>(opsPerThread / 10000);
+    start = std::chrono::steady_clock::now();
+    std::size_t overdue = library.collectOverdue(lastDay + 30).size();
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "逾期扫描: " << overdue << " 笔, 耗时 " << elapsed.count() * 1000 << " ms\n";
+    consistent &= overdue == loans && library.collectOverdue(lastDay + 31).empty();
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "Money.h"
+
+// g++ money_bench.cpp -o money_bench -std=c++20 -O2
+// 用法: ./money_bench [迭代次数]
+// 对比 "double + std::setprecision(2)" 和 "Money + Money::format" 在取款热路径上的开销。
+
+int main(int argc, char* argv[]) {
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    // 取款金额: 0.01 ~ 1.00，预先生成，两种实现使用同一组数据
+    std::vector<std::int64_t> amounts(1024);
+    std::uint64_t state = 88172645463325252ull;
+    for (std::int64_t& amount : amounts) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        amount = static_cast<std::int64_t>(state % 100 + 1);
+    }
+
+    // 1. 旧实现: double 余额，每次取款后用 iostream 格式化余额
+    double doubleBalance = 1e12;
+    std::ostringstream stream;
+    std::size_t doubleChars = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        double amount = static_cast<double>(amounts[i & 1023]) / 100.0;
+        if (amount <= doubleBalance) {
+            doubleBalance -= amount;
+        }
+        stream.str("");
+        stream << std::fixed << std::setprecision(2) << doubleBalance;
+        doubleChars += stream.view().size();
+    }
+    std::chrono::duration<double, std::nano> doubleTime = std::chrono::steady_clock::now() - start;
+
+    // 2. 新实现: Money 余额，每次取款后用 Money::format 写入栈上的缓冲区
+    Money moneyBalance = Money::fromCents(100000000000000);
+    char buffer[Money::kMaxFormattedSize];
+    std::size_t moneyChars = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Money amount = Money::fromCents(amounts[i & 1023]);
+        if (amount <= moneyBalance) {
+            moneyBalance = Money::fromCents(moneyBalance.cents() - amount.cents());
+        }
+        moneyChars += moneyBalance.format(buffer);
+    }
+    std::chrono::duration<double, std::nano> moneyTime = std::chrono::steady_clock::now() - start;
+
+    // 输出最终余额和字符数，既能核对结果，也防止编译器把循环优化掉
+    std::cout << "迭代次数: " << iterations << "\n\n";
+    std::cout << "double + iomanip: " << doubleTime.count() / iterations << " ns/次, 最终余额 "
+              << std::fixed << std::setprecision(2) << doubleBalance << " (" << doubleChars << " 字符)\n";
+    std::cout << "Money + format:   " << moneyTime.count() / iterations << " ns/次, 最终余额 "
+              << moneyBalance << " (" << moneyChars << " 字符)\n";
+    std::cout << "加速比: " << doubleTime.count() / moneyTime.count() << "x\n";
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "SpatialIndex.h"
+
+// g++ spatial_index_bench.cpp -o spatial_index_bench -std=c++20 -O2 -pthread
+// 用法: ./spatial_index_bench [点数] [查询数] [线程数]
+// 点均匀分布在边长 sqrt(点数) 的正方形里 (每单位面积约 1 个点)，半径 2 的查询平均返回约 12 个点。
+// 依次测量: 暴力扫描 (少量查询)、UniformGrid 与 KdTree 的建立时间、单线程和多线程批量查询的吞吐量，
+// 并用暴力扫描的结果核对两种索引。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static double uniform(std::uint64_t& state, double side) {
+    return static_cast<double>(nextRandom(state) >> 11) * 0x1.0p-53 * side;
+}
+
+template <class F>
+static double seconds(F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, std::size_t queries, double elapsed) {
+    std::cout << "  " << name << ": " << static_cast<std::uint64_t>(queries / elapsed) << " 次/秒\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t queryCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    if (n == 0 || queryCount == 0 || threads == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+    constexpr double kRadius = 2.0;
+    constexpr std::size_t kNeighbors = 8;
+    double side = std::sqrt(static_cast<double>(n));
+
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    std::vector<Vector2D> points(n), queries(queryCount), boxMins(queryCount), boxMaxs(queryCount);
+    for (Vector2D& p : points) {
+        p = Vector2D(uniform(state, side), uniform(state, side));
+    }
+    for (std::size_t q = 0; q < queryCount; ++q) {
+        queries[q] = Vector2D(uniform(state, side), uniform(state, side));
+        boxMins[q] = queries[q] - Vector2D(kRadius, kRadius);
+        boxMaxs[q] = queries[q] + Vector2D(kRadius, kRadius);
+    }
+    std::cout << n << " 个点, " << queryCount << " 个查询, " << threads << " 个线程, 半径 " << kRadius
+              << ", k = " << kNeighbors << "\n\n";
+
+    // 1. 暴力扫描 (只跑少量查询)
+    std::size_t sample = std::min<std::size_t>(queryCount, std::max<std::size_t>(1, 200000000 / n));
+    std::vector<std::uint32_t> bruteCounts(sample);
+    double bruteTime = seconds([&] {
+        for (std::size_t q = 0; q < sample; ++q) {
+            std::uint32_t count = 0;
+            for (const Vector2D& p : points) {
+                count += (p - queries[q]).magnitudeSquared() <= kRadius * kRadius;
+            }
+            bruteCounts[q] = count;
+        }
+    });
+    std::cout << "暴力扫描:\n";
+    report("半径查询", sample, bruteTime);
+
+    // 2. 建立索引
+    spatial::UniformGrid grid(kRadius);
+    spatial::KdTree tree;
+    double gridBuild = seconds([&] { grid.build(points); });
+    double gridRebuild = seconds([&] { grid.build(points); }); // 复用内存，相当于每帧重建
+    double treeBuild = seconds([&] { tree.build(points); });
+    std::cout << "\n建立: UniformGrid " << gridBuild * 1000 << " ms (重建 " << gridRebuild * 1000
+              << " ms), KdTree " << treeBuild * 1000 << " ms\n";
+
+    bool ok = true;
+    auto run = [&](const char* name, const auto& index) {
+        std::cout << "\n" << name << ":\n";
+        std::size_t found = 0;
+        double single = seconds([&] {
+            for (const Vector2D& q : queries) {
+                found += index.countRadius(q, kRadius);
+            }
+        });
+        report("半径查询 (计数, 单线程)", queryCount, single);
+
+        std::vector<std::uint32_t> counts;
+        double batch = seconds([&] { counts = index.countRadiusBatch(queries, kRadius, threads); });
+        report("半径查询 (计数, 批量)", queryCount, batch);
+
+        spatial::BatchResult radius;
+        double batchIds = seconds([&] { radius = index.radiusBatch(queries, kRadius, threads); });
+        report("半径查询 (返回 id, 批量)", queryCount, batchIds);
+
+        spatial::BatchResult nearest;
+        double knn = seconds([&] { nearest = index.nearestBatch(queries, kNeighbors, threads); });
+        report("k 近邻 (批量)", queryCount, knn);
+
+        spatial::BatchResult boxes;
+        double box = seconds([&] { boxes = index.boxBatch(boxMins, boxMaxs, threads); });
+        report("矩形查询 (批量)", queryCount, box);
+
+        for (std::size_t q = 0; q < sample; ++q) {
+            ok = ok && counts[q] == bruteCounts[q] && radius[q].size() == bruteCounts[q];
+        }
+        std::cout << "  平均每个半径查询 " << static_cast<double>(found) / queryCount << " 个点, 平均每个矩形 "
+                  << static_cast<double>(boxes.ids.size()) / queryCount << " 个点\n";
+        return nearest;
+    };
+    spatial::BatchResult gridNearest = run("UniformGrid", grid);
+    spatial::BatchResult treeNearest = run("KdTree", tree);
+    ok = ok && gridNearest.ids == treeNearest.ids;
+
+    std::cout << "\n结果核对: " << (ok ? "一致" : "不一致!") << std::endl;
+    return ok ? 0 : 1;
+}
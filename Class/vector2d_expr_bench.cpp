@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "Vector2DExpr.h"
+
+// g++ vector2d_expr_bench.cpp -o vector2d_expr_bench -std=c++20 -O3
+// 用法: ./vector2d_expr_bench [向量数量]
+// 对比两个表达式的几种算法:
+//  - vector<Vector2D>: AoS 数组上逐个元素用 Vector2D 的运算符计算；
+//  - 逐步计算: 每个运算符的结果存入一个新的临时数组 (每次都分配内存)；
+//  - 逐步计算 (复用): 临时数组事先分配好，只剩下多读写几遍内存的开销；
+//  - 融合: 表达式模板，整个表达式一个循环。
+// 默认 1000 万个向量，峰值内存约 1.5 GB。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static double randomCoordinate(std::uint64_t& state) {
+    return static_cast<double>(nextRandom(state) % 2000001) / 1000.0 - 1000.0;
+}
+
+// 运行 3 次取最快的一次，返回毫秒
+template <class F>
+static double bestOf(F&& run) {
+    double best = 1e300;
+    for (int i = 0; i < 3; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+static bool sameResult(const Vector2DArray& a, const std::vector<Vector2D>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (!a.get(i).approxEqual(b[i], 1e-12)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    constexpr double s = 1.75;
+
+    std::vector<Vector2D> aosA(n), aosB(n), aosC(n), aosD(n), aosOut(n);
+    Vector2DArray a(n), b(n), c(n), d(n), out(n);
+    std::uint64_t state = 0x853C49E6748FEA9Bull;
+    for (std::size_t i = 0; i < n; ++i) {
+        aosA[i] = Vector2D(randomCoordinate(state), randomCoordinate(state));
+        aosB[i] = Vector2D(randomCoordinate(state), randomCoordinate(state));
+        aosC[i] = Vector2D(randomCoordinate(state), randomCoordinate(state));
+        aosD[i] = Vector2D(randomCoordinate(state), randomCoordinate(state));
+        a.set(i, aosA[i].getX(), aosA[i].getY());
+        b.set(i, aosB[i].getX(), aosB[i].getY());
+        c.set(i, aosC[i].getX(), aosC[i].getY());
+        d.set(i, aosD[i].getX(), aosD[i].getY());
+    }
+    std::cout << "向量数量: " << n << ", 指令集: " << simdLevelName(Vector2DArray::simdLevel()) << "\n";
+
+    bool ok = true;
+    auto report = [&](const char* name, double ms, double baseline) {
+        std::cout << "  " << name << ": " << ms << " ms";
+        if (baseline > 0) {
+            std::cout << " (" << baseline / ms << "x)";
+        }
+        std::cout << "\n";
+    };
+
+    // 1. a + b * s - c
+    {
+        std::cout << "\nout = a + b * s - c\n";
+        double aos = bestOf([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                aosOut[i] = aosA[i] + aosB[i] * s - aosC[i];
+            }
+        });
+        double unfused = bestOf([&] {
+            Vector2DArray t1 = b * s;
+            Vector2DArray t2 = a + t1;
+            out = t2 - c;
+        });
+        Vector2DArray t1(n), t2(n);
+        double reused = bestOf([&] {
+            t1 = b * s;
+            t2 = a + t1;
+            out = t2 - c;
+        });
+        ok = ok && sameResult(out, aosOut);
+        double fused = bestOf([&] { out = a + b * s - c; });
+        ok = ok && sameResult(out, aosOut);
+        report("vector<Vector2D>", aos, unfused);
+        report("逐步计算", unfused, 0);
+        report("逐步计算 (复用)", reused, unfused);
+        report("融合", fused, unfused);
+    }
+
+    // 2. (a + b) * 0.5 - c * s + d / 3
+    {
+        std::cout << "\nout = (a + b) * 0.5 - c * s + d / 3\n";
+        double aos = bestOf([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                aosOut[i] = (aosA[i] + aosB[i]) * 0.5 - aosC[i] * s + aosD[i] / 3.0;
+            }
+        });
+        double unfused = bestOf([&] {
+            Vector2DArray sum = a + b;
+            Vector2DArray half = sum * 0.5;
+            Vector2DArray scaled = c * s;
+            Vector2DArray third = d / 3.0;
+            Vector2DArray difference = half - scaled;
+            out = difference + third;
+        });
+        Vector2DArray t1(n), t2(n);
+        double reused = bestOf([&] {
+            t1 = a + b;
+            t1 = t1 * 0.5;
+            t2 = c * s;
+            t1 = t1 - t2;
+            t2 = d / 3.0;
+            out = t1 + t2;
+        });
+        ok = ok && sameResult(out, aosOut);
+        double fused = bestOf([&] { out = (a + b) * 0.5 - c * s + d / 3.0; });
+        ok = ok && sameResult(out, aosOut);
+        report("vector<Vector2D>", aos, unfused);
+        report("逐步计算", unfused, 0);
+        report("逐步计算 (复用)", reused, unfused);
+        report("融合", fused, unfused);
+    }
+
+    std::cout << "\n结果核对: " << (ok ? "一致" : "不一致!") << std::endl;
+    return ok ? 0 : 1;
+}
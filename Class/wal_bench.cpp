@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LedgerStore.h"
+
+// g++ wal_bench.cpp -o wal_bench -std=c++20 -O2 -pthread
+// 用法: ./wal_bench [数据目录] [账户数量] [线程数] [每个线程的持久化交易次数]
+// 注意: 程序会先清空数据目录。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 所有账户余额之和，用于核对恢复结果
+static Money::Cents totalBalance(Ledger& ledger, const std::vector<std::string>& accountNumbers) {
+    Money::Cents total = 0;
+    for (const std::string& accNum : accountNumbers) {
+        total += ledger.getBalance(accNum).value_or(Money()).cents();
+    }
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path directory = argc > 1 ? argv[1] : "ledger_data";
+    std::size_t accountCount = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t opsPerThread = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 20000;
+    if (accountCount == 0 || threads == 0) {
+        std::cerr << "账户数量和线程数必须为正数。" << std::endl;
+        return 1;
+    }
+    std::filesystem::remove_all(directory);
+
+    std::vector<std::string> accountNumbers;
+    accountNumbers.reserve(accountCount);
+    for (std::size_t i = 0; i < accountCount; ++i) {
+        accountNumbers.push_back(std::to_string(100000000 + i));
+    }
+
+    Money::Cents expectedTotal = 0;
+    {
+        std::unique_ptr<LedgerStore> store = LedgerStore::open(directory);
+
+        // 1. 批量开户: 不逐笔等待落盘，最后统一 sync
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < accountCount; ++i) {
+            store->accounts().openAccount(accountNumbers[i], "用户" + std::to_string(i), Money::fromCents(100000));
+        }
+        store->sync();
+        std::cout << "开户 " << accountCount << " 个并落盘: " << secondsSince(start) << " 秒\n";
+
+        // 2. 多线程持久化交易: 每笔交易都等到日志 fdatasync 之后才返回，靠组提交分摊 fdatasync
+        start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+                for (std::size_t i = 0; i < opsPerThread; ++i) {
+                    std::uint64_t r = nextRandom(state);
+                    const std::string& accNum = accountNumbers[r % accountCount];
+                    Money amount = Money::fromCents(static_cast<Money::Cents>((r >> 32) % 10000 + 1));
+                    if (r & (1ull << 20)) {
+                        store->deposit(accNum, amount);
+                    } else {
+                        store->withdraw(accNum, amount);
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        double elapsed = secondsSince(start);
+        std::cout << threads << " 个线程持久化交易 " << opsPerThread * threads << " 笔: "
+                  << static_cast<std::uint64_t>(opsPerThread * threads / elapsed) << " txns/s\n";
+
+        // 3. 生成快照，再追加一些交易，让恢复时既有快照又有日志尾部
+        start = std::chrono::steady_clock::now();
+        store->checkpoint();
+        std::cout << "checkpoint (快照 + 清理旧日志): " << secondsSince(start) << " 秒\n";
+        for (std::size_t i = 0; i < std::min<std::size_t>(accountCount, 10000); ++i) {
+            store->accounts().deposit(accountNumbers[i], Money::fromCents(1));
+        }
+        store->sync();
+        expectedTotal = totalBalance(store->accounts(), accountNumbers);
+    }
+
+    // 4. 重启: 映射快照并行重建账户，只重放快照之后的日志
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<LedgerStore> recovered = LedgerStore::open(directory);
+    double recoveryTime = secondsSince(start);
+    const LedgerStore::RecoveryStats& stats = recovered->recoveryStats();
+    std::cout << "恢复耗时: " << recoveryTime << " 秒 (快照账户 " << stats.snapshotAccounts
+              << " 个, 重放日志 " << stats.replayedRecords << " 条, 跳过 " << stats.skippedRecords << " 条)\n";
+
+    Money::Cents actualTotal = totalBalance(recovered->accounts(), accountNumbers);
+    std::cout << "余额核对: " << (actualTotal == expectedTotal ? "一致" : "不一致！")
+              << " (总余额 " << Money::fromCents(actualTotal) << ")\n";
+    return actualTotal == expectedTotal ? 0 : 1;
+}
@@ -0,0 +1,433 @@
+// Allocator.h
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 可复用的内存分配模块，用来替代到处 new / delete 小对象的写法:
+//  - Arena: 指针递增 (bump) 分配，不能单独释放，reset() 一次性回收全部内存 (例如每个请求结束时)；
+//  - SizeClassPool: 按大小分级的内存池。每个线程有自己的空闲链表，分配和释放通常不加锁；
+//    空闲块太多时成批还给全局链表，其他线程可以成批取走；
+//  - ArenaResource / PoolResource: 适配 std::pmr::memory_resource，可以直接给 std::pmr 容器使用；
+//  - PoolAllocated / makePooled: 让领域对象 (Book、策略等) 从内存池分配。
+
+// ===================================================================
+// I. Arena (指针递增分配)
+// ===================================================================
+
+/**
+ * @brief 单线程使用的 bump 分配器。内存按块申请，reset() 后保留所有块供下一轮复用。
+ * create<T>() 构造的对象如果需要析构，会在 reset() (或 Arena 销毁) 时按构造的相反顺序析构。
+ */
+class Arena {
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        reset();
+        for (Block& block : blocks) {
+            ::operator delete(block.data, std::align_val_t{kBlockAlignment});
+        }
+    }
+
+    // 分配 bytes 字节，按 alignment 对齐 (alignment 必须是 2 的幂)
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::uintptr_t aligned = (cursor + alignment - 1) & ~(alignment - 1);
+        if (cursor == 0 || aligned + bytes > limit) {
+            aligned = nextBlock(bytes, alignment);
+        }
+        cursor = aligned + bytes;
+        allocated += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // 在 Arena 中构造对象。返回的指针在 reset() 前有效，不能 delete
+    template <class T, class... Args>
+    T* create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            // 析构函数记录本身也放在 Arena 里
+            void* node = allocate(sizeof(Destructor), alignof(Destructor));
+            destructors = new (node) Destructor{[](void* p) { static_cast<T*>(p)->~T(); }, object, destructors};
+        }
+        return object;
+    }
+
+    // 析构 create() 构造的对象，回收全部内存 (内存块保留，不还给系统)
+    void reset() {
+        for (Destructor* d = destructors; d != nullptr; d = d->next) {
+            d->destroy(d->object);
+        }
+        destructors = nullptr;
+        current = 0;
+        cursor = 0;
+        limit = 0;
+        allocated = 0;
+    }
+
+    // 本轮 (上次 reset() 之后) 分配的字节数
+    std::size_t bytesAllocated() const { return allocated; }
+
+    // 向系统申请的内存总量
+    std::size_t bytesReserved() const {
+        std::size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    static constexpr std::size_t kBlockAlignment = 64;
+
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    // 换到下一个放得下的块 (没有时新申请一块)，返回对齐后的地址
+    std::uintptr_t nextBlock(std::size_t bytes, std::size_t alignment) {
+        std::size_t needed = bytes + alignment;
+        // cursor == 0 表示本轮还没有使用任何块，从第 0 块开始
+        std::size_t index = cursor == 0 ? 0 : current + 1;
+        while (index < blocks.size() && blocks[index].size < needed) {
+            ++index;
+        }
+        if (index >= blocks.size()) {
+            std::size_t size = std::max(blockSize, needed);
+            blocks.push_back(Block{static_cast<std::byte*>(::operator new(size, std::align_val_t{kBlockAlignment})), size});
+            index = blocks.size() - 1;
+        }
+        current = index;
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(blocks[index].data);
+        limit = start + blocks[index].size;
+        return (start + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::size_t blockSize;
+    std::vector<Block> blocks;
+    std::size_t current = 0;      // 正在使用的块
+    std::uintptr_t cursor = 0;    // 下一次分配的起点 (0 表示本轮还没有分配)
+    std::uintptr_t limit = 0;     // 当前块的末尾
+    std::size_t allocated = 0;
+    Destructor* destructors = nullptr;
+};
+
+// ===================================================================
+// II. SizeClassPool (按大小分级的内存池)
+// ===================================================================
+
+/**
+ * @brief 全局的分级内存池。不超过 kMaxSize 字节、对齐不超过 16 的请求按大小分到 15 个等级
+ * (16..128 每 16 字节一级，256..1024 每 128 字节一级)，更大的请求直接交给 ::operator new。
+ *
+ * 每个线程为每个等级缓存一条空闲链表 (块的前 8 字节存放下一个空闲块的地址)。
+ * 缓存超过 2 批时把 1 批还给全局链表；缓存为空时从全局取 1 批，全局也没有时从新的内存页切出 1 批。
+ * 只有成批搬运时才加锁，每批 kBatch 个块。一个线程分配的块可以由另一个线程释放。
+ * 内存池的内存不还给系统: 空闲块留在池里供以后复用。
+ */
+class SizeClassPool {
+public:
+    static constexpr std::size_t kMaxSize = 1024;
+    static constexpr std::size_t kAlignment = 16;
+    static constexpr std::size_t kClassCount = 15;
+    static constexpr std::size_t kBatch = 64;
+
+    // 永不销毁: 其他线程的 ThreadCache 析构时、以及静态对象释放池中的块时，它必须仍然可用
+    static SizeClassPool& global() {
+        static SizeClassPool* instance = new SizeClassPool;
+        return *instance;
+    }
+
+    void* allocate(std::size_t bytes) {
+        if (bytes > kMaxSize) {
+            return ::operator new(bytes);
+        }
+        std::size_t sizeClass = classOf(bytes);
+        if (threadExiting) {
+            // 线程的缓存已经析构 (其他 thread_local 对象析构时仍在分配): 直接分配，释放时会进入内存池
+            return ::operator new(kClassSizes[sizeClass]);
+        }
+        ThreadCache::List& list = cache().lists[sizeClass];
+        if (list.head == nullptr) {
+            refill(list, sizeClass);
+        }
+        FreeBlock* block = list.head;
+        list.head = block->next;
+        --list.count;
+        return block;
+    }
+
+    // bytes 必须与 allocate 时相同
+    void deallocate(void* p, std::size_t bytes) noexcept {
+        if (p == nullptr) {
+            return;
+        }
+        if (bytes > kMaxSize) {
+            ::operator delete(p);
+            return;
+        }
+        std::size_t sizeClass = classOf(bytes);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        if (threadExiting) {
+            block->next = nullptr;
+            releasePartial(block, sizeClass);
+            return;
+        }
+        ThreadCache::List& list = cache().lists[sizeClass];
+        block->next = list.head;
+        list.head = block;
+        if (++list.count > 2 * kBatch) {
+            release(list, sizeClass);
+        }
+    }
+
+    // bytes 字节的请求实际占用的块大小 (大于 kMaxSize 时返回 bytes)
+    static constexpr std::size_t blockSize(std::size_t bytes) {
+        return bytes > kMaxSize ? bytes : kClassSizes[classOf(bytes)];
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::array<std::size_t, kClassCount> kClassSizes = {
+        16, 32, 48, 64, 80, 96, 112, 128, 256, 384, 512, 640, 768, 896, 1024};
+
+    static constexpr std::size_t classOf(std::size_t bytes) {
+        if (bytes <= 128) {
+            return bytes == 0 ? 0 : (bytes - 1) / 16;
+        }
+        return 7 + (bytes - 1) / 128;
+    }
+
+    // 全局链表中的一批空闲块，以链表的形式整体搬运
+    struct Central {
+        std::mutex mutex;
+        std::vector<FreeBlock*> batches;
+    };
+
+    // 线程的缓存。线程退出时把剩余的块全部还给全局链表
+    struct ThreadCache {
+        struct List {
+            FreeBlock* head = nullptr;
+            std::size_t count = 0;
+        };
+        std::array<List, kClassCount> lists{};
+
+        ~ThreadCache() {
+            threadExiting = true;
+            for (std::size_t c = 0; c < kClassCount; ++c) {
+                while (lists[c].count > 0) {
+                    global().release(lists[c], c);
+                }
+            }
+        }
+    };
+
+    SizeClassPool() = default;
+
+    // 本线程的缓存是否已经析构。bool 没有析构函数，线程退出的任何阶段都可以读取
+    static inline thread_local bool threadExiting = false;
+
+    static ThreadCache& cache() {
+        thread_local ThreadCache threadCache;
+        return threadCache;
+    }
+
+    // 从全局取一批，没有时从新的内存页切一批
+    void refill(ThreadCache::List& list, std::size_t sizeClass) {
+        Central& central = centrals[sizeClass];
+        {
+            std::lock_guard<std::mutex> lock(central.mutex);
+            if (!central.batches.empty()) {
+                list.head = central.batches.back();
+                central.batches.pop_back();
+                list.count = kBatch;
+                return;
+            }
+        }
+        std::size_t size = kClassSizes[sizeClass];
+        auto* memory = static_cast<std::byte*>(::operator new(size * kBatch, std::align_val_t{64}));
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            auto* block = reinterpret_cast<FreeBlock*>(memory + i * size);
+            block->next = i + 1 < kBatch ? reinterpret_cast<FreeBlock*>(memory + (i + 1) * size) : nullptr;
+        }
+        list.head = reinterpret_cast<FreeBlock*>(memory);
+        list.count = kBatch;
+    }
+
+    // 把链表头部的一批 (最多 kBatch 个) 还给全局
+    void release(ThreadCache::List& list, std::size_t sizeClass) noexcept {
+        FreeBlock* first = list.head;
+        FreeBlock* last = first;
+        std::size_t n = 1;
+        for (; n < kBatch && last->next != nullptr; ++n) {
+            last = last->next;
+        }
+        list.head = last->next;
+        list.count -= n;
+        last->next = nullptr;
+        if (n < kBatch) {
+            // 不满一批 (只在线程退出时出现): 全局链表里的每一批都必须正好 kBatch 个，先攒起来
+            releasePartial(first, sizeClass);
+            return;
+        }
+        Central& central = centrals[sizeClass];
+        std::lock_guard<std::mutex> lock(central.mutex);
+        central.batches.push_back(first);
+    }
+
+    // 不满一批的块先攒在 partial 里，攒满一批再放入全局链表
+    void releasePartial(FreeBlock* first, std::size_t sizeClass) noexcept {
+        Central& central = centrals[sizeClass];
+        std::lock_guard<std::mutex> lock(central.mutex);
+        Partial& partial = partials[sizeClass];
+        while (first != nullptr) {
+            FreeBlock* next = first->next;
+            first->next = partial.head;
+            partial.head = first;
+            if (++partial.count == kBatch) {
+                central.batches.push_back(partial.head);
+                partial = Partial{};
+            }
+            first = next;
+        }
+    }
+
+    struct Partial {
+        FreeBlock* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    std::array<Central, kClassCount> centrals;
+    std::array<Partial, kClassCount> partials{};
+};
+
+static_assert(SizeClassPool::blockSize(1) == 16 && SizeClassPool::blockSize(128) == 128 &&
+              SizeClassPool::blockSize(129) == 256 && SizeClassPool::blockSize(SizeClassPool::kMaxSize) == 1024);
+
+// ===================================================================
+// III. std::pmr 适配
+// ===================================================================
+
+/**
+ * @brief 从 Arena 分配的 memory_resource。deallocate 什么也不做，内存在 Arena::reset() 时统一回收
+ */
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(Arena& arena) : arena(arena) {}
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override { return arena.allocate(bytes, alignment); }
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Arena& arena;
+};
+
+/**
+ * @brief 从 SizeClassPool 分配的 memory_resource。对齐要求超过 16 字节时交给 ::operator new。
+ * 所有 PoolResource 共用同一个全局内存池，所以它们之间可以互相释放对方分配的内存
+ */
+class PoolResource : public std::pmr::memory_resource {
+public:
+    // 进程内共享的实例
+    static PoolResource* instance() {
+        static PoolResource* resource = new PoolResource;
+        return resource;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > SizeClassPool::kAlignment) {
+            return ::operator new(bytes, std::align_val_t{alignment});
+        }
+        return SizeClassPool::global().allocate(bytes);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        if (alignment > SizeClassPool::kAlignment) {
+            ::operator delete(p, std::align_val_t{alignment});
+            return;
+        }
+        SizeClassPool::global().deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return dynamic_cast<const PoolResource*>(&other) != nullptr;
+    }
+};
+
+// ===================================================================
+// IV. 领域对象从内存池分配
+// ===================================================================
+
+/**
+ * @brief 继承它的类 (public 继承)，new / delete 自动走 SizeClassPool。
+ * 用基类指针 delete 派生类对象时，只要基类的析构函数是虚函数，编译器传入的就是派生类的大小。
+ * 例: class IProductSpecStrategy : public PoolAllocated { ... };
+ */
+struct PoolAllocated {
+    static void* operator new(std::size_t bytes) { return SizeClassPool::global().allocate(bytes); }
+    static void operator delete(void* p, std::size_t bytes) noexcept { SizeClassPool::global().deallocate(p, bytes); }
+};
+
+/**
+ * @brief makePooled 返回的 unique_ptr 的删除器。记住对象实际的大小，
+ * 所以 unique_ptr<Derived> 转成 unique_ptr<Base> 之后也能正确释放 (Base 需要虚析构函数)
+ */
+struct PoolDeleter {
+    std::size_t bytes = 0;
+
+    template <class T>
+    void operator()(T* object) const noexcept {
+        // 多重继承时基类指针不一定指向对象开头，用 dynamic_cast<void*> 找回最初分配的地址
+        void* start;
+        if constexpr (std::is_polymorphic_v<T>) {
+            start = const_cast<void*>(dynamic_cast<const volatile void*>(object));
+        } else {
+            start = const_cast<void*>(static_cast<const volatile void*>(object));
+        }
+        object->~T();
+        SizeClassPool::global().deallocate(start, bytes);
+    }
+};
+
+template <class T>
+using PooledPtr = std::unique_ptr<T, PoolDeleter>;
+
+// 在内存池中构造对象，用法与 std::make_unique 相同，不需要修改类本身
+template <class T, class... Args>
+PooledPtr<T> makePooled(Args&&... args) {
+    static_assert(alignof(T) <= SizeClassPool::kAlignment, "over-aligned types are not supported");
+    void* memory = SizeClassPool::global().allocate(sizeof(T));
+    try {
+        return PooledPtr<T>(new (memory) T(std::forward<Args>(args)...), PoolDeleter{sizeof(T)});
+    } catch (...) {
+        SizeClassPool::global().deallocate(memory, sizeof(T));
+        throw;
+    }
+}
+
+#endif // ALLOCATOR_H
@@ -0,0 +1,704 @@
+// ArrayKernels.h
+#ifndef ARRAY_KERNELS_H
+#define ARRAY_KERNELS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARRAY_KERNELS_X86 1
+#else
+#define ARRAY_KERNELS_X86 0
+#endif
+
+// 数组遍历内核: printArrayWithPointer 只能处理 int、只能打印，这里把 "用指针走一遍数组" 推广成
+// 对任意算术类型的连续数组 (std::vector、std::array、std::span、C 数组) 做常用的批量运算:
+// sum (求和)、minMax (最小/最大值)、inclusiveScan (前缀和)、transform (逐元素变换)、
+// filter (按条件压缩)、histogram (直方图)。
+//
+// 每个内核有两层并行:
+//  - SIMD: 用 GCC 的向量扩展 (T __attribute__((vector_size(N))))，一次处理 16/32/64 字节。
+//    与 Vector2DArray.h 一样，AVX2 / AVX-512 版本的函数用 target 属性单独编译，运行时按 CPU 选择；
+//  - 多线程: 输入足够大 (至少 2 × kParallelMinElements 个元素) 时切成连续的几块，每个线程处理一块。
+//    threads 为 0 时使用 std::thread::hardware_concurrency() 个线程，为 1 时不创建线程。
+// 浮点数的 sum / inclusiveScan 按块、按 SIMD 通道分别累加，结果与逐个累加可能有舍入误差。
+
+namespace array_kernels {
+
+// 使用的指令集。运行时按 CPU 支持情况选择最高的一级
+enum class SimdLevel {
+    Baseline, // 16 字节向量 (x86-64 上是 SSE2)
+    Avx2,     // 32 字节向量
+    Avx512    // 64 字节向量
+};
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "AVX-512";
+        case SimdLevel::Avx2:   return "AVX2";
+        default:                return "Baseline";
+    }
+}
+
+inline SimdLevel detectSimdLevel() {
+#if ARRAY_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+#endif
+    return SimdLevel::Baseline;
+}
+
+inline SimdLevel supportedSimdLevel() {
+    static const SimdLevel detected = detectSimdLevel();
+    return detected;
+}
+
+namespace detail {
+inline std::atomic<SimdLevel>& activeLevel() {
+    static std::atomic<SimdLevel> level{supportedSimdLevel()};
+    return level;
+}
+} // namespace detail
+
+inline SimdLevel simdLevel() { return detail::activeLevel().load(std::memory_order_relaxed); }
+
+// 设置为高于 CPU 支持的级别时按 CPU 支持的最高级别处理 (用于测试和对比)
+inline void setSimdLevel(SimdLevel level) {
+    detail::activeLevel().store(std::min(level, supportedSimdLevel()), std::memory_order_relaxed);
+}
+
+// 每个线程至少处理这么多元素，更小的输入不值得创建线程
+inline constexpr std::size_t kParallelMinElements = std::size_t{1} << 18;
+
+// sum 的结果类型: 整数累加到 64 位 (避免溢出)，浮点数保持原类型
+template <class T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                                   std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+template <class T>
+struct MinMax {
+    T min;
+    T max;
+};
+
+// 用 vectorized(f) 包装的函数会收到整个 SIMD 向量 (GCC 向量扩展类型)，而不是单个元素。
+// 向量支持 + - * / 和比较运算，所以 [](auto x) { return x * 2 + 1; } 这样的泛型 lambda 两种参数都能用。
+// transform: f(向量) 返回同样通道数的向量；filter: pred(向量) 返回比较结果 (非 0 的通道表示保留)。
+// GCC 会对以向量为参数的 lambda 给出 -Wpsabi 提示；lambda 被内联进内核，不影响结果，可以用 -Wno-psabi 关闭。
+template <class F>
+struct Vectorized {
+    F f;
+};
+
+template <class F>
+Vectorized<F> vectorized(F f) {
+    return Vectorized<F>{std::move(f)};
+}
+
+// 下面的函数以向量为参数和返回值，但都强制内联，不存在跨函数调用的 ABI 问题
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace detail {
+
+template <class T>
+struct IsVectorized : std::false_type {};
+template <class F>
+struct IsVectorized<Vectorized<F>> : std::true_type {};
+
+// GCC 向量扩展: Bytes 字节、每个通道一个 T
+template <class T, std::size_t Bytes>
+struct VecType {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+template <class T, std::size_t Bytes>
+using Vec = typename VecType<T, Bytes>::type;
+template <class T, std::size_t Lanes>
+using VecN = Vec<T, sizeof(T) * Lanes>;
+
+// 与 T 大小相同的整数 (shuffle 的下标类型)
+template <class T>
+using LaneIndex = std::conditional_t<sizeof(T) == 1, std::int8_t,
+                  std::conditional_t<sizeof(T) == 2, std::int16_t,
+                  std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+
+// 以下函数强制内联: 它们被内联进带 target 属性的函数后，才按 AVX2 / AVX-512 生成代码
+template <class V, class T>
+[[gnu::always_inline]] inline V load(const T* p) {
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <class V, class T>
+[[gnu::always_inline]] inline void store(T* p, const V& v) {
+    std::memcpy(p, &v, sizeof(V));
+}
+
+// 以 S 类型逐通道累加 (S 可以比 T 宽)。
+// 通道数按较宽的类型决定: 累加器正好占满一个寄存器，输入每次只加载半个 (或更少) 寄存器
+template <class S, std::size_t Bytes, class T>
+[[gnu::always_inline]] inline S accumulate(const T* p, std::size_t n) {
+    constexpr std::size_t L = Bytes / std::max(sizeof(T), sizeof(S));
+    using V = VecN<T, L>;
+    using A = VecN<S, L>;
+    // 4 组累加器互不依赖，浮点加法的延迟不会卡住循环
+    A acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+    std::size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        acc0 += __builtin_convertvector(load<V>(p + i), A);
+        acc1 += __builtin_convertvector(load<V>(p + i + L), A);
+        acc2 += __builtin_convertvector(load<V>(p + i + 2 * L), A);
+        acc3 += __builtin_convertvector(load<V>(p + i + 3 * L), A);
+    }
+    for (; i + L <= n; i += L) {
+        acc0 += __builtin_convertvector(load<V>(p + i), A);
+    }
+    A total = (acc0 + acc1) + (acc2 + acc3);
+    S s = 0;
+    for (std::size_t l = 0; l < L; ++l) {
+        s += total[l];
+    }
+    for (; i < n; ++i) {
+        s += static_cast<S>(p[i]);
+    }
+    return s;
+}
+
+template <std::size_t Bytes, class T>
+[[gnu::always_inline]] inline MinMax<T> minMax(const T* p, std::size_t n) {
+    constexpr std::size_t L = Bytes / sizeof(T);
+    using V = Vec<T, Bytes>;
+    MinMax<T> result{p[0], p[0]};
+    std::size_t i = 0;
+    if (n >= L) {
+        V lo = load<V>(p);
+        V hi = lo;
+        for (i = L; i + L <= n; i += L) {
+            V v = load<V>(p + i);
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+        }
+        for (std::size_t l = 0; l < L; ++l) {
+            result.min = std::min(result.min, lo[l]);
+            result.max = std::max(result.max, hi[l]);
+        }
+    }
+    for (; i < n; ++i) {
+        result.min = std::min(result.min, p[i]);
+        result.max = std::max(result.max, p[i]);
+    }
+    return result;
+}
+
+// 向量整体向高位移动 S 个通道，低位补 0
+template <std::size_t S, class V, std::size_t... J>
+[[gnu::always_inline]] inline V shiftLanes(const V& x, std::index_sequence<J...>) {
+    using T = std::remove_reference_t<decltype(x[0])>;
+    using M = VecN<LaneIndex<T>, sizeof...(J)>;
+    return __builtin_shuffle(x, V{}, M{static_cast<LaneIndex<T>>(J >= S ? J - S : sizeof...(J))...});
+}
+
+// 向量内的前缀和: log2(L) 次 "移位再相加"
+template <std::size_t L, std::size_t S = 1, class V>
+[[gnu::always_inline]] inline V scanLanes(V x) {
+    if constexpr (S < L) {
+        x += shiftLanes<S>(x, std::make_index_sequence<L>{});
+        return scanLanes<L, S * 2>(x);
+    } else {
+        return x;
+    }
+}
+
+// out[i] = carry + in[0] + ... + in[i]，返回最后的累加值。out 可以与 in 相同
+template <std::size_t Bytes, class T>
+[[gnu::always_inline]] inline T inclusiveScan(const T* in, T* out, std::size_t n, T carry) {
+    constexpr std::size_t L = Bytes / sizeof(T);
+    using V = Vec<T, Bytes>;
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        V x = scanLanes<L>(load<V>(in + i)) + carry;
+        store(out + i, x);
+        carry = x[L - 1];
+    }
+    for (; i < n; ++i) {
+        carry += in[i];
+        out[i] = carry;
+    }
+    return carry;
+}
+
+template <std::size_t Bytes, class T, class U, class F>
+[[gnu::always_inline]] inline void transform(const T* in, U* out, std::size_t n, F& f) {
+    std::size_t i = 0;
+    if constexpr (IsVectorized<F>::value) {
+        constexpr std::size_t L = Bytes / std::max(sizeof(T), sizeof(U));
+        using V = VecN<T, L>;
+        for (; i + L <= n; i += L) {
+            store(out + i, __builtin_convertvector(f.f(load<V>(in + i)), VecN<U, L>));
+        }
+        for (; i < n; ++i) {
+            out[i] = static_cast<U>(f.f(in[i]));
+        }
+    } else {
+#pragma GCC ivdep
+        for (; i < n; ++i) {
+            out[i] = static_cast<U>(f(in[i]));
+        }
+    }
+}
+
+// 把满足条件的元素依次写入 out，返回写入的个数。
+// 无分支的写法: 每个元素都写到 out[k]，满足条件时 k 才加一 (out 至少要有 n 个位置)
+template <std::size_t Bytes, class T, class P>
+[[gnu::always_inline]] inline std::size_t filter(const T* in, T* out, std::size_t n, P& pred) {
+    std::size_t k = 0;
+    std::size_t i = 0;
+    if constexpr (IsVectorized<P>::value) {
+        constexpr std::size_t L = Bytes / sizeof(T);
+        using V = Vec<T, Bytes>;
+        for (; i + L <= n; i += L) {
+            V v = load<V>(in + i);
+            auto keep = pred.f(v);
+            for (std::size_t l = 0; l < L; ++l) {
+                out[k] = v[l];
+                k += keep[l] != 0;
+            }
+        }
+        for (; i < n; ++i) {
+            out[k] = in[i];
+            k += pred.f(in[i]) ? 1 : 0;
+        }
+    } else {
+        for (; i < n; ++i) {
+            out[k] = in[i];
+            k += pred(in[i]) ? 1 : 0;
+        }
+    }
+    return k;
+}
+
+// [lo, hi) 均分成 bins 个区间，counts 至少 bins 个位置 (在原有的计数上累加)。区间外的值和 NaN 不计数。
+// 先用 SIMD 算出每个元素所在的区间，再逐个计数: 交替使用 4 份计数，相邻元素落在同一区间时不会互相等待
+template <std::size_t Bytes, class T>
+[[gnu::always_inline]] inline void histogram(const T* in, std::size_t n, double lo, double hi, std::size_t bins,
+                                             std::uint64_t* counts) {
+    // 计数本身只能逐个元素进行，从 zmm 寄存器取出下标的代价比计算更高，因此最多使用 32 字节的向量
+    constexpr std::size_t L = std::min<std::size_t>(Bytes, 32) / std::max(sizeof(T), sizeof(double));
+    using V = VecN<T, L>;
+    using D = VecN<double, L>;
+    using I = VecN<std::int32_t, L>;
+    const double scale = static_cast<double>(bins) / (hi - lo);
+    const std::int64_t last = static_cast<std::int64_t>(bins) - 1;
+    std::vector<std::uint64_t> local(4 * (bins + 1), 0);
+    std::uint64_t* copies[4] = {local.data(), local.data() + (bins + 1), local.data() + 2 * (bins + 1),
+                                local.data() + 3 * (bins + 1)};
+    std::size_t i = 0;
+    for (; i + L <= n; i += L) {
+        // 在 double 中完成比较和截断，最后才转换成 int32 (double 转 int64 的向量指令需要 AVX-512DQ)
+        D x = __builtin_convertvector(load<V>(in + i), D);
+        D position = (x - lo) * scale;
+        position = position > static_cast<double>(last) ? D{} + static_cast<double>(last) : position; // 舍入误差可能让接近 hi 的值算到 bins
+        position = (x >= lo) & (x < hi) ? position : D{} + static_cast<double>(bins); // 区间外的值记到多余的位置 bins
+        I index = __builtin_convertvector(position, I);
+        for (std::size_t l = 0; l < L; ++l) {
+            ++copies[l & 3][index[l]];
+        }
+    }
+    for (; i < n; ++i) {
+        double x = static_cast<double>(in[i]);
+        if (x >= lo && x < hi) {
+            ++copies[0][std::min(static_cast<std::int64_t>((x - lo) * scale), last)];
+        }
+    }
+    for (std::size_t b = 0; b < bins; ++b) {
+        counts[b] += copies[0][b] + copies[1][b] + copies[2][b] + copies[3][b];
+    }
+}
+
+// 把 [0, n) 切成 chunkCount 个连续的块并行执行 body(chunk, begin, end)，当前线程处理第 0 块
+template <class Body>
+void parallelChunks(std::size_t n, std::size_t chunkCount, Body&& body) {
+    auto range = [&](std::size_t c) { return std::pair{n * c / chunkCount, n * (c + 1) / chunkCount}; };
+    std::vector<std::thread> workers;
+    for (std::size_t c = 1; c < chunkCount; ++c) {
+        workers.emplace_back([&, c] {
+            auto [begin, end] = range(c);
+            body(c, begin, end);
+        });
+    }
+    auto [begin, end] = range(0);
+    body(0, begin, end);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// 输入有 n 个元素时使用几个线程 (1 表示不并行)
+inline std::size_t chunkCount(std::size_t n, unsigned threads) {
+    std::size_t available = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(available, n / kParallelMinElements));
+}
+
+} // namespace detail
+
+// ===================================================================
+// 各指令集的内核
+// ===================================================================
+// 每个结构体把 detail 中的通用实现按自己的向量宽度实例化。
+
+namespace simd {
+
+struct Baseline {
+    static constexpr std::size_t kBytes = 16;
+
+    template <class S, class T>
+    static S accumulate(const T* p, std::size_t n) { return detail::accumulate<S, kBytes>(p, n); }
+
+    template <class T>
+    static MinMax<T> minMax(const T* p, std::size_t n) { return detail::minMax<kBytes>(p, n); }
+
+    template <class T>
+    static T inclusiveScan(const T* in, T* out, std::size_t n, T carry) {
+        return detail::inclusiveScan<kBytes>(in, out, n, carry);
+    }
+
+    template <class T, class U, class F>
+    static void transform(const T* in, U* out, std::size_t n, F& f) { detail::transform<kBytes>(in, out, n, f); }
+
+    template <class T, class P>
+    static std::size_t filter(const T* in, T* out, std::size_t n, P& pred) {
+        return detail::filter<kBytes>(in, out, n, pred);
+    }
+
+    template <class T>
+    static void histogram(const T* in, std::size_t n, double lo, double hi, std::size_t bins, std::uint64_t* counts) {
+        detail::histogram<kBytes>(in, n, lo, hi, bins, counts);
+    }
+};
+
+#if ARRAY_KERNELS_X86
+
+struct Avx2 {
+    static constexpr std::size_t kBytes = 32;
+
+    template <class S, class T>
+    [[gnu::target("avx2")]]
+    static S accumulate(const T* p, std::size_t n) { return detail::accumulate<S, kBytes>(p, n); }
+
+    template <class T>
+    [[gnu::target("avx2")]]
+    static MinMax<T> minMax(const T* p, std::size_t n) { return detail::minMax<kBytes>(p, n); }
+
+    template <class T>
+    [[gnu::target("avx2")]]
+    static T inclusiveScan(const T* in, T* out, std::size_t n, T carry) {
+        return detail::inclusiveScan<kBytes>(in, out, n, carry);
+    }
+
+    template <class T, class U, class F>
+    [[gnu::target("avx2")]]
+    static void transform(const T* in, U* out, std::size_t n, F& f) { detail::transform<kBytes>(in, out, n, f); }
+
+    template <class T, class P>
+    [[gnu::target("avx2")]]
+    static std::size_t filter(const T* in, T* out, std::size_t n, P& pred) {
+        return detail::filter<kBytes>(in, out, n, pred);
+    }
+
+    template <class T>
+    [[gnu::target("avx2")]]
+    static void histogram(const T* in, std::size_t n, double lo, double hi, std::size_t bins, std::uint64_t* counts) {
+        detail::histogram<kBytes>(in, n, lo, hi, bins, counts);
+    }
+};
+
+struct Avx512 {
+    static constexpr std::size_t kBytes = 64;
+
+    template <class S, class T>
+    [[gnu::target("avx512f,avx512bw")]]
+    static S accumulate(const T* p, std::size_t n) { return detail::accumulate<S, kBytes>(p, n); }
+
+    template <class T>
+    [[gnu::target("avx512f,avx512bw")]]
+    static MinMax<T> minMax(const T* p, std::size_t n) { return detail::minMax<kBytes>(p, n); }
+
+    template <class T>
+    [[gnu::target("avx512f,avx512bw")]]
+    static T inclusiveScan(const T* in, T* out, std::size_t n, T carry) {
+        return detail::inclusiveScan<kBytes>(in, out, n, carry);
+    }
+
+    template <class T, class U, class F>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void transform(const T* in, U* out, std::size_t n, F& f) { detail::transform<kBytes>(in, out, n, f); }
+
+    // 4 / 8 字节的元素用 AVX-512 的 compress 指令: 一条指令把保留的通道连续写出
+    template <class T, class P>
+    [[gnu::target("avx512f,avx512bw")]]
+    static std::size_t filter(const T* in, T* out, std::size_t n, P& pred) {
+        if constexpr (detail::IsVectorized<P>::value && (sizeof(T) == 4 || sizeof(T) == 8)) {
+            constexpr std::size_t L = kBytes / sizeof(T);
+            using V = detail::Vec<T, kBytes>;
+            std::size_t k = 0;
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                V v = detail::load<V>(in + i);
+                __m512i data;
+                std::memcpy(&data, &v, sizeof(data));
+                __m512i keep;
+                auto mask = pred.f(v);
+                std::memcpy(&keep, &mask, sizeof(keep));
+                if constexpr (sizeof(T) == 4) {
+                    __mmask16 bits = _mm512_test_epi32_mask(keep, keep);
+                    _mm512_mask_compressstoreu_epi32(out + k, bits, data);
+                    k += static_cast<std::size_t>(__builtin_popcount(bits));
+                } else {
+                    __mmask8 bits = _mm512_test_epi64_mask(keep, keep);
+                    _mm512_mask_compressstoreu_epi64(out + k, bits, data);
+                    k += static_cast<std::size_t>(__builtin_popcount(bits));
+                }
+            }
+            return k + detail::filter<kBytes>(in + i, out + k, n - i, pred);
+        } else {
+            return detail::filter<kBytes>(in, out, n, pred);
+        }
+    }
+
+    template <class T>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void histogram(const T* in, std::size_t n, double lo, double hi, std::size_t bins, std::uint64_t* counts) {
+        detail::histogram<kBytes>(in, n, lo, hi, bins, counts);
+    }
+};
+
+#endif // ARRAY_KERNELS_X86
+
+} // namespace simd
+
+#pragma GCC diagnostic pop
+
+namespace detail {
+
+// 以当前指令集对应的内核类型 (一个空结构体) 调用 run
+template <class F>
+decltype(auto) dispatch(F&& run) {
+    switch (simdLevel()) {
+#if ARRAY_KERNELS_X86
+        case SimdLevel::Avx512: return run(simd::Avx512{});
+        case SimdLevel::Avx2:   return run(simd::Avx2{});
+#endif
+        default:                return run(simd::Baseline{});
+    }
+}
+
+template <class R>
+using ElementOf = std::remove_cv_t<std::ranges::range_value_t<R>>;
+
+template <class R>
+auto asSpan(R&& range) {
+    return std::span(std::ranges::data(range), std::ranges::size(range));
+}
+
+template <class T>
+constexpr void requireArithmetic() {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "array_kernels: element type must be arithmetic");
+}
+
+} // namespace detail
+
+// 连续存储、已知长度的数组: std::vector、std::array、std::span、C 数组等
+template <class R>
+concept ContiguousArray = std::ranges::contiguous_range<R> && std::ranges::sized_range<R>;
+
+// ===================================================================
+// 内核
+// ===================================================================
+
+template <ContiguousArray R>
+SumType<detail::ElementOf<R>> sum(const R& input, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    using S = SumType<T>;
+    detail::requireArithmetic<T>();
+    auto in = detail::asSpan(input);
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    std::vector<S> partial(chunks, S{});
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            partial[c] = kernels.template accumulate<S>(in.data() + begin, end - begin);
+        });
+    });
+    S total{};
+    for (S s : partial) {
+        total += s;
+    }
+    return total;
+}
+
+// 空数组返回 std::nullopt。浮点数组中的 NaN 会被忽略或影响结果 (取决于它的位置)，调用前应先排除
+template <ContiguousArray R>
+std::optional<MinMax<detail::ElementOf<R>>> minMax(const R& input, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireArithmetic<T>();
+    auto in = detail::asSpan(input);
+    if (in.empty()) {
+        return std::nullopt;
+    }
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    std::vector<MinMax<T>> partial(chunks);
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            partial[c] = kernels.minMax(in.data() + begin, end - begin);
+        });
+    });
+    MinMax<T> result = partial[0];
+    for (const MinMax<T>& p : partial) {
+        result.min = std::min(result.min, p.min);
+        result.max = std::max(result.max, p.max);
+    }
+    return result;
+}
+
+/**
+ * @brief 前缀和: output[i] = input[0] + ... + input[i]。output 可以是 input 本身 (原地计算)。
+ * 多线程时分两遍: 先并行求每块的和，算出每块的起始值后再并行计算各块的前缀和。
+ * 整数按元素类型计算 (溢出时与逐个相加的结果相同，都是回绕)。
+ */
+template <ContiguousArray R, ContiguousArray Out>
+void inclusiveScan(const R& input, Out&& output, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireArithmetic<T>();
+    static_assert(std::is_same_v<std::ranges::range_value_t<Out>, T>, "inclusiveScan: output must have the input's element type");
+    auto in = detail::asSpan(input);
+    auto out = detail::asSpan(output);
+    if (out.size() < in.size()) {
+        throw std::invalid_argument("array_kernels::inclusiveScan: output too small");
+    }
+    // 整数用无符号类型计算，溢出时是定义良好的回绕
+    using W = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>, std::type_identity<T>>::type;
+    const W* src = reinterpret_cast<const W*>(in.data());
+    W* dst = reinterpret_cast<W*>(out.data());
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    detail::dispatch([&](auto kernels) {
+        if (chunks == 1) {
+            kernels.inclusiveScan(src, dst, in.size(), W{});
+            return;
+        }
+        std::vector<W> carry(chunks, W{});
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            carry[c] = kernels.template accumulate<W>(src + begin, end - begin);
+        });
+        W running{};
+        for (W& c : carry) {
+            W total = c;
+            c = running;
+            running += total;
+        }
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            kernels.inclusiveScan(src + begin, dst + begin, end - begin, carry[c]);
+        });
+    });
+}
+
+/**
+ * @brief output[i] = f(input[i])。f 可以是普通函数 (用 -O3 编译时由编译器自动向量化，-O2 下是逐个元素的循环)，
+ * 也可以用 vectorized(f) 包装，直接收到整个 SIMD 向量 (见 Vectorized)，这时与编译选项无关。
+ */
+template <ContiguousArray R, ContiguousArray Out, class F>
+void transform(const R& input, Out&& output, F f, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    using U = std::ranges::range_value_t<Out>;
+    detail::requireArithmetic<T>();
+    detail::requireArithmetic<U>();
+    auto in = detail::asSpan(input);
+    auto out = detail::asSpan(output);
+    if (out.size() < in.size()) {
+        throw std::invalid_argument("array_kernels::transform: output too small");
+    }
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+            F local = f;
+            kernels.transform(in.data() + begin, out.data() + begin, end - begin, local);
+        });
+    });
+}
+
+/**
+ * @brief 把满足 pred 的元素按原来的顺序复制到 output 的开头，返回个数。
+ * output 至少要有 input.size() 个位置 (其余位置的内容不确定)。pred 同样可以用 vectorized 包装。
+ * 多线程时每块先压缩到 output 中自己的位置，最后依次把各块移到一起。
+ */
+template <ContiguousArray R, ContiguousArray Out, class P>
+std::size_t filter(const R& input, Out&& output, P pred, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireArithmetic<T>();
+    static_assert(std::is_same_v<std::ranges::range_value_t<Out>, T>, "filter: output must have the input's element type");
+    auto in = detail::asSpan(input);
+    auto out = detail::asSpan(output);
+    if (out.size() < in.size()) {
+        throw std::invalid_argument("array_kernels::filter: output too small");
+    }
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    std::vector<std::pair<std::size_t, std::size_t>> kept(chunks); // 每块的起点和保留的个数
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            P local = pred;
+            kept[c] = {begin, kernels.filter(in.data() + begin, out.data() + begin, end - begin, local)};
+        });
+    });
+    std::size_t total = kept[0].second;
+    for (std::size_t c = 1; c < chunks; ++c) {
+        std::memmove(out.data() + total, out.data() + kept[c].first, kept[c].second * sizeof(T));
+        total += kept[c].second;
+    }
+    return total;
+}
+
+/**
+ * @brief 把 [lo, hi) 均分成 bins 个区间，统计每个区间内的元素个数。区间外的值和 NaN 不计数。
+ */
+template <ContiguousArray R>
+std::vector<std::uint64_t> histogram(const R& input, double lo, double hi, std::size_t bins, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireArithmetic<T>();
+    if (bins == 0 || bins >= (std::size_t{1} << 31) || !(lo < hi)) {
+        throw std::invalid_argument("array_kernels::histogram: need 0 < bins < 2^31 and lo < hi");
+    }
+    auto in = detail::asSpan(input);
+    std::size_t chunks = detail::chunkCount(in.size(), threads);
+    std::vector<std::vector<std::uint64_t>> partial(chunks, std::vector<std::uint64_t>(bins, 0));
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(in.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            kernels.histogram(in.data() + begin, end - begin, lo, hi, bins, partial[c].data());
+        });
+    });
+    for (std::size_t c = 1; c < chunks; ++c) {
+        for (std::size_t b = 0; b < bins; ++b) {
+            partial[0][b] += partial[c][b];
+        }
+    }
+    return std::move(partial[0]);
+}
+
+} // namespace array_kernels
+
+#endif // ARRAY_KERNELS_H
@@ -0,0 +1,662 @@
+// Permute.h
+#ifndef PERMUTE_H
+#define PERMUTE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ArrayKernels.h"
+
+// 批量交换 / 重排: swapIntegers 用一个临时变量交换一对 int，这里把它推广到整个数组，
+// 元素可以是任意可平凡复制 (trivially copyable) 的类型 T:
+// swapRanges (两段等长数组逐个交换)、reverse (原地反转)、rotate (原地交换相邻的两块)、
+// gather / scatter (按下标数组读取 / 写入)、applyPermutation (原地按排列重排)、
+// transpose (矩阵转置，输出到另一个数组)。
+//
+// 内核只按元素的字节数 (sizeof(T)) 实例化: float 和 int32 使用同一份代码，所有读写都经过 memcpy。
+// SIMD 指令集和多线程的选择与 ArrayKernels.h 相同 (array_kernels::setSimdLevel、threads 参数)。
+// swapIntegers 对空指针的检查在这里由输入的 span 保证; 长度不符、下标越界会抛出异常。
+
+namespace permute {
+
+using array_kernels::ContiguousArray;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // GCC 12 的 gather / scatter 内建函数头文件中的误报
+
+namespace detail {
+
+using array_kernels::detail::load;
+using array_kernels::detail::store;
+using array_kernels::detail::Vec;
+using array_kernels::detail::VecN;
+
+// 与元素大小相同的无符号整数，用作向量的通道类型 (只有 1/2/4/8 字节的元素有)
+template <std::size_t N>
+using Word = std::conditional_t<N == 1, std::uint8_t,
+             std::conditional_t<N == 2, std::uint16_t,
+             std::conditional_t<N == 4, std::uint32_t,
+             std::conditional_t<N == 8, std::uint64_t, void>>>>;
+
+template <std::size_t N>
+[[gnu::always_inline]] inline void copyElement(unsigned char* to, const unsigned char* from) {
+    std::memcpy(to, from, N);
+}
+
+template <std::size_t N>
+[[gnu::always_inline]] inline void swapElement(unsigned char* a, unsigned char* b) {
+    unsigned char temp[N];
+    std::memcpy(temp, a, N);
+    std::memcpy(a, b, N);
+    std::memcpy(b, temp, N);
+}
+
+// 交换 a、b 开始的 bytes 个字节 (两段不重叠)
+template <std::size_t Bytes>
+[[gnu::always_inline]] inline void swapBytes(unsigned char* a, unsigned char* b, std::size_t bytes) {
+    using V = Vec<unsigned char, Bytes>;
+    std::size_t i = 0;
+    for (; i + 2 * Bytes <= bytes; i += 2 * Bytes) {
+        V x0 = load<V>(a + i), x1 = load<V>(a + i + Bytes);
+        V y0 = load<V>(b + i), y1 = load<V>(b + i + Bytes);
+        store(a + i, y0);
+        store(a + i + Bytes, y1);
+        store(b + i, x0);
+        store(b + i + Bytes, x1);
+    }
+    for (; i < bytes; ++i) {
+        std::swap(a[i], b[i]);
+    }
+}
+
+// 向量的通道顺序反过来
+template <class V, std::size_t... J>
+[[gnu::always_inline]] inline V reverseLanes(const V& x, std::index_sequence<J...>) {
+    using T = std::remove_reference_t<decltype(x[0])>;
+    using M = VecN<array_kernels::detail::LaneIndex<T>, sizeof...(J)>;
+    return __builtin_shuffle(x, M{static_cast<array_kernels::detail::LaneIndex<T>>(sizeof...(J) - 1 - J)...});
+}
+
+// front 的第 i 个元素与 back 的倒数第 i 个元素交换 (i < count)，两段不重叠。
+// 对数组的前一半和后一半执行一次就是整个数组的反转
+template <std::size_t Bytes, std::size_t N>
+[[gnu::always_inline]] inline void reverseSwap(unsigned char* front, unsigned char* back, std::size_t count) {
+    std::size_t i = 0;
+    if constexpr (!std::is_void_v<Word<N>>) {
+        constexpr std::size_t L = Bytes / N;
+        using V = VecN<Word<N>, L>;
+        for (; i + L <= count; i += L) {
+            unsigned char* f = front + i * N;
+            unsigned char* b = back + (count - i - L) * N;
+            V x = load<V>(f);
+            V y = load<V>(b);
+            store(f, reverseLanes(y, std::make_index_sequence<L>{}));
+            store(b, reverseLanes(x, std::make_index_sequence<L>{}));
+        }
+    }
+    for (; i < count; ++i) {
+        swapElement<N>(front + i * N, back + (count - 1 - i) * N);
+    }
+}
+
+// out[i] = in[index[i]]。下标已经检查过; 提前预取 16 个元素之后要读的位置
+template <std::size_t N, class I>
+[[gnu::always_inline]] inline void gather(const unsigned char* in, const I* index, unsigned char* out, std::size_t n) {
+    constexpr std::size_t kAhead = 16;
+    std::size_t i = 0;
+    for (; i + kAhead < n; ++i) {
+        __builtin_prefetch(in + static_cast<std::size_t>(index[i + kAhead]) * N);
+        copyElement<N>(out + i * N, in + static_cast<std::size_t>(index[i]) * N);
+    }
+    for (; i < n; ++i) {
+        copyElement<N>(out + i * N, in + static_cast<std::size_t>(index[i]) * N);
+    }
+}
+
+// out[index[i]] = in[i]
+template <std::size_t N, class I>
+[[gnu::always_inline]] inline void scatter(const unsigned char* in, const I* index, unsigned char* out, std::size_t n) {
+    constexpr std::size_t kAhead = 16;
+    std::size_t i = 0;
+    for (; i + kAhead < n; ++i) {
+        __builtin_prefetch(out + static_cast<std::size_t>(index[i + kAhead]) * N, 1);
+        copyElement<N>(out + static_cast<std::size_t>(index[i]) * N, in + i * N);
+    }
+    for (; i < n; ++i) {
+        copyElement<N>(out + static_cast<std::size_t>(index[i]) * N, in + i * N);
+    }
+}
+
+// 转置时每次处理的小块的边长 (元素个数): 32 × 32 个 8 字节元素的输入和输出各 8 KB，能放进 L1 缓存
+inline constexpr std::size_t kTransposeBlock = 32;
+
+// 对 L 个向量 (L × L 的小方阵) 做一轮 "交换对角线两侧的 S × S 子块"。
+// 对 S = L/2, L/4, ..., 1 各做一轮就完成了整个方阵的转置
+template <std::size_t S, class V, std::size_t L, std::size_t... J>
+[[gnu::always_inline]] inline void swapSubBlocks(V (&rows)[L], std::index_sequence<J...>) {
+    using T = std::remove_reference_t<decltype(rows[0][0])>;
+    using Index = array_kernels::detail::LaneIndex<T>;
+    using M = VecN<Index, L>;
+    constexpr M upper{static_cast<Index>((J & S) != 0 ? L + J - S : J)...};
+    constexpr M lower{static_cast<Index>((J & S) != 0 ? L + J : J + S)...};
+#pragma GCC unroll 64
+    for (std::size_t r = 0; r < L; ++r) {
+        if ((r & S) == 0) {
+            V a = rows[r];
+            V b = rows[r + S];
+            rows[r] = __builtin_shuffle(a, b, upper);
+            rows[r + S] = __builtin_shuffle(a, b, lower);
+        }
+    }
+    if constexpr (S > 1) {
+        swapSubBlocks<S / 2>(rows, std::index_sequence<J...>{});
+    }
+}
+
+// 转置 rows × cols 的一小块: out[c * outStride + r] = in[r * inStride + c] (stride 以元素为单位)。
+// 元素为 2/4/8 字节时，完整的 L × L 方块在寄存器中转置 (L 为一个向量的通道数)，其余部分逐个复制
+template <std::size_t Bytes, std::size_t N>
+[[gnu::always_inline]] inline void transposeBlock(const unsigned char* in, std::size_t inStride, unsigned char* out,
+                                                  std::size_t outStride, std::size_t rows, std::size_t cols) {
+    std::size_t fullRows = 0;
+    std::size_t fullCols = 0;
+    if constexpr (N == 2 || N == 4 || N == 8) {
+        constexpr std::size_t L = Bytes / N;
+        using V = VecN<Word<N>, L>;
+        fullRows = rows / L * L;
+        fullCols = cols / L * L;
+        for (std::size_t r = 0; r < fullRows; r += L) {
+            for (std::size_t c = 0; c < fullCols; c += L) {
+                V tile[L]; // 循环全部展开后，整个方块都在寄存器中
+#pragma GCC unroll 64
+                for (std::size_t k = 0; k < L; ++k) {
+                    tile[k] = load<V>(in + ((r + k) * inStride + c) * N);
+                }
+                swapSubBlocks<L / 2>(tile, std::make_index_sequence<L>{});
+#pragma GCC unroll 64
+                for (std::size_t k = 0; k < L; ++k) {
+                    store(out + ((c + k) * outStride + r) * N, tile[k]);
+                }
+            }
+        }
+    }
+    // 右边不足 L 列的部分和下边不足 L 行的部分
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = r < fullRows ? fullCols : 0; c < cols; ++c) {
+            copyElement<N>(out + (c * outStride + r) * N, in + (r * inStride + c) * N);
+        }
+    }
+}
+
+} // namespace detail
+
+// ===================================================================
+// 各指令集的内核
+// ===================================================================
+// 与 array_kernels::simd 相同的结构。gather / scatter 在 AVX2 / AVX-512 上对 4、8 字节的元素和
+// 4、8 字节的下标使用硬件 gather (AVX-512 还有 scatter) 指令; 32 位下标按有符号数解释，
+// 因此只在数组长度不超过 2^31 - 1 时使用。
+
+namespace simd {
+
+struct Baseline {
+    static constexpr std::size_t kBytes = 16;
+
+    static void swapBytes(unsigned char* a, unsigned char* b, std::size_t bytes) { detail::swapBytes<kBytes>(a, b, bytes); }
+
+    template <std::size_t N>
+    static void reverseSwap(unsigned char* front, unsigned char* back, std::size_t count) {
+        detail::reverseSwap<kBytes, N>(front, back, count);
+    }
+
+    template <std::size_t N, class I>
+    static void gather(const unsigned char* in, std::size_t, const I* index, unsigned char* out, std::size_t n) {
+        detail::gather<N>(in, index, out, n);
+    }
+
+    template <std::size_t N, class I>
+    static void scatter(const unsigned char* in, const I* index, unsigned char* out, std::size_t, std::size_t n) {
+        detail::scatter<N>(in, index, out, n);
+    }
+
+    template <std::size_t N>
+    static void transposeBlock(const unsigned char* in, std::size_t inStride, unsigned char* out, std::size_t outStride,
+                               std::size_t rows, std::size_t cols) {
+        detail::transposeBlock<kBytes, N>(in, inStride, out, outStride, rows, cols);
+    }
+};
+
+#if ARRAY_KERNELS_X86
+
+struct Avx2 {
+    static constexpr std::size_t kBytes = 32;
+
+    [[gnu::target("avx2")]]
+    static void swapBytes(unsigned char* a, unsigned char* b, std::size_t bytes) { detail::swapBytes<kBytes>(a, b, bytes); }
+
+    template <std::size_t N>
+    [[gnu::target("avx2")]]
+    static void reverseSwap(unsigned char* front, unsigned char* back, std::size_t count) {
+        detail::reverseSwap<kBytes, N>(front, back, count);
+    }
+
+    template <std::size_t N, class I>
+    [[gnu::target("avx2")]]
+    static void gather(const unsigned char* in, std::size_t inSize, const I* index, unsigned char* out, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr ((N == 4 || N == 8) && (sizeof(I) == 4 || sizeof(I) == 8)) {
+            if (sizeof(I) == 8 || inSize <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                constexpr std::size_t L = sizeof(I) == 4 && N == 4 ? 8 : 4;
+                for (; i + L <= n; i += L) {
+                    if constexpr (N == 4 && sizeof(I) == 4) {
+                        __m256i v = _mm256_i32gather_epi32(reinterpret_cast<const int*>(in),
+                                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i)), 4);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * N), v);
+                    } else if constexpr (N == 4) {
+                        __m128i v = _mm256_i64gather_epi32(reinterpret_cast<const int*>(in),
+                                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i)), 4);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * N), v);
+                    } else if constexpr (sizeof(I) == 4) {
+                        __m256i v = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(in),
+                                                           _mm_loadu_si128(reinterpret_cast<const __m128i*>(index + i)), 8);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * N), v);
+                    } else {
+                        __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(in),
+                                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i)), 8);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * N), v);
+                    }
+                }
+            }
+        }
+        detail::gather<N>(in, index + i, out + i * N, n - i);
+    }
+
+    template <std::size_t N, class I>
+    [[gnu::target("avx2")]]
+    static void scatter(const unsigned char* in, const I* index, unsigned char* out, std::size_t, std::size_t n) {
+        detail::scatter<N>(in, index, out, n);
+    }
+
+    template <std::size_t N>
+    [[gnu::target("avx2")]]
+    static void transposeBlock(const unsigned char* in, std::size_t inStride, unsigned char* out, std::size_t outStride,
+                               std::size_t rows, std::size_t cols) {
+        detail::transposeBlock<kBytes, N>(in, inStride, out, outStride, rows, cols);
+    }
+};
+
+struct Avx512 {
+    static constexpr std::size_t kBytes = 64;
+
+    [[gnu::target("avx512f,avx512bw")]]
+    static void swapBytes(unsigned char* a, unsigned char* b, std::size_t bytes) { detail::swapBytes<kBytes>(a, b, bytes); }
+
+    template <std::size_t N>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void reverseSwap(unsigned char* front, unsigned char* back, std::size_t count) {
+        detail::reverseSwap<kBytes, N>(front, back, count);
+    }
+
+    template <std::size_t N, class I>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void gather(const unsigned char* in, std::size_t inSize, const I* index, unsigned char* out, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr ((N == 4 || N == 8) && (sizeof(I) == 4 || sizeof(I) == 8)) {
+            if (sizeof(I) == 8 || inSize <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                constexpr std::size_t L = sizeof(I) == 4 && N == 4 ? 16 : 8;
+                for (; i + L <= n; i += L) {
+                    if constexpr (N == 4 && sizeof(I) == 4) {
+                        __m512i v = _mm512_i32gather_epi32(_mm512_loadu_si512(index + i), in, 4);
+                        _mm512_storeu_si512(out + i * N, v);
+                    } else if constexpr (N == 4) {
+                        __m256i v = _mm512_i64gather_epi32(_mm512_loadu_si512(index + i), in, 4);
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * N), v);
+                    } else if constexpr (sizeof(I) == 4) {
+                        __m512i v = _mm512_i32gather_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i)), in, 8);
+                        _mm512_storeu_si512(out + i * N, v);
+                    } else {
+                        __m512i v = _mm512_i64gather_epi64(_mm512_loadu_si512(index + i), in, 8);
+                        _mm512_storeu_si512(out + i * N, v);
+                    }
+                }
+            }
+        }
+        detail::gather<N>(in, index + i, out + i * N, n - i);
+    }
+
+    // 同一个向量内下标重复时，scatter 指令保证编号大的通道最后写入，与逐个写入的结果相同
+    template <std::size_t N, class I>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void scatter(const unsigned char* in, const I* index, unsigned char* out, std::size_t outSize, std::size_t n) {
+        std::size_t i = 0;
+        if constexpr ((N == 4 || N == 8) && (sizeof(I) == 4 || sizeof(I) == 8)) {
+            if (sizeof(I) == 8 || outSize <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                constexpr std::size_t L = sizeof(I) == 4 && N == 4 ? 16 : 8;
+                for (; i + L <= n; i += L) {
+                    if constexpr (N == 4 && sizeof(I) == 4) {
+                        _mm512_i32scatter_epi32(out, _mm512_loadu_si512(index + i), _mm512_loadu_si512(in + i * N), 4);
+                    } else if constexpr (N == 4) {
+                        _mm512_i64scatter_epi32(out, _mm512_loadu_si512(index + i),
+                                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * N)), 4);
+                    } else if constexpr (sizeof(I) == 4) {
+                        _mm512_i32scatter_epi64(out, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i)),
+                                                _mm512_loadu_si512(in + i * N), 8);
+                    } else {
+                        _mm512_i64scatter_epi64(out, _mm512_loadu_si512(index + i), _mm512_loadu_si512(in + i * N), 8);
+                    }
+                }
+            }
+        }
+        detail::scatter<N>(in + i * N, index + i, out, n - i);
+    }
+
+    template <std::size_t N>
+    [[gnu::target("avx512f,avx512bw")]]
+    static void transposeBlock(const unsigned char* in, std::size_t inStride, unsigned char* out, std::size_t outStride,
+                               std::size_t rows, std::size_t cols) {
+        detail::transposeBlock<kBytes, N>(in, inStride, out, outStride, rows, cols);
+    }
+};
+
+#endif // ARRAY_KERNELS_X86
+
+} // namespace simd
+
+#pragma GCC diagnostic pop
+
+namespace detail {
+
+using array_kernels::detail::chunkCount;
+using array_kernels::detail::parallelChunks;
+
+template <class F>
+decltype(auto) dispatch(F&& run) {
+    switch (array_kernels::simdLevel()) {
+#if ARRAY_KERNELS_X86
+        case array_kernels::SimdLevel::Avx512: return run(simd::Avx512{});
+        case array_kernels::SimdLevel::Avx2:   return run(simd::Avx2{});
+#endif
+        default:                               return run(simd::Baseline{});
+    }
+}
+
+template <class R>
+using ElementOf = std::remove_cv_t<std::ranges::range_value_t<R>>;
+
+template <class T>
+constexpr void requireTriviallyCopyable() {
+    static_assert(std::is_trivially_copyable_v<T>, "permute: element type must be trivially copyable");
+}
+
+template <class R>
+unsigned char* bytesOf(R& range) {
+    return reinterpret_cast<unsigned char*>(std::ranges::data(range));
+}
+
+template <class R>
+const unsigned char* bytesOf(const R& range) {
+    return reinterpret_cast<const unsigned char*>(std::ranges::data(range));
+}
+
+// 反转 [p, p + n) (n 个 N 字节的元素)
+template <std::size_t N, class K>
+void reverse(K kernels, unsigned char* p, std::size_t n, unsigned threads) {
+    std::size_t half = n / 2;
+    parallelChunks(half, chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+        kernels.template reverseSwap<N>(p + begin * N, p + (n - end) * N, end - begin);
+    });
+}
+
+// 下标都必须在 [0, size) 中，否则抛出 std::out_of_range
+template <class I>
+void checkIndices(std::span<const I> index, std::size_t size, unsigned threads, const char* what) {
+    static_assert(std::is_integral_v<I> && !std::is_same_v<I, bool>, "permute: indices must be integers");
+    if (auto range = array_kernels::minMax(index, threads)) {
+        bool negative = false;
+        if constexpr (std::is_signed_v<I>) {
+            negative = range->min < 0;
+        }
+        if (negative || static_cast<std::make_unsigned_t<I>>(range->max) >= size) {
+            throw std::out_of_range(std::string("permute::") + what + ": index out of range");
+        }
+    }
+}
+
+// 缓存无关 (cache-oblivious) 的转置: 把较长的一边对半分，直到两边都不超过 kTransposeBlock，
+// 不需要知道缓存大小，每一级缓存都会在某一层递归中装下整块
+template <std::size_t N, class K>
+void transposeRecursive(K kernels, const unsigned char* in, std::size_t inStride, unsigned char* out,
+                        std::size_t outStride, std::size_t rows, std::size_t cols) {
+    if (rows <= kTransposeBlock && cols <= kTransposeBlock) {
+        kernels.template transposeBlock<N>(in, inStride, out, outStride, rows, cols);
+    } else if (rows >= cols) {
+        std::size_t top = rows / 2;
+        transposeRecursive<N>(kernels, in, inStride, out, outStride, top, cols);
+        transposeRecursive<N>(kernels, in + top * inStride * N, inStride, out + top * N, outStride, rows - top, cols);
+    } else {
+        std::size_t left = cols / 2;
+        transposeRecursive<N>(kernels, in, inStride, out, outStride, rows, left);
+        transposeRecursive<N>(kernels, in + left * N, inStride, out + left * outStride * N, outStride, rows, cols - left);
+    }
+}
+
+} // namespace detail
+
+// ===================================================================
+// 接口
+// ===================================================================
+
+/**
+ * @brief 逐个交换 a 和 b 的元素。两者长度必须相同且不能重叠 (否则抛出 std::invalid_argument)。
+ */
+template <ContiguousArray A, ContiguousArray B>
+void swapRanges(A&& a, B&& b, unsigned threads = 0) {
+    using T = detail::ElementOf<A>;
+    detail::requireTriviallyCopyable<T>();
+    static_assert(std::is_same_v<detail::ElementOf<B>, T>, "swapRanges: both ranges must have the same element type");
+    std::size_t n = std::ranges::size(a);
+    if (std::ranges::size(b) != n) {
+        throw std::invalid_argument("permute::swapRanges: ranges have different sizes");
+    }
+    unsigned char* pa = detail::bytesOf(a);
+    unsigned char* pb = detail::bytesOf(b);
+    std::size_t bytes = n * sizeof(T);
+    if (n != 0 && pa < pb + bytes && pb < pa + bytes) {
+        throw std::invalid_argument("permute::swapRanges: ranges overlap");
+    }
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(n, detail::chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+            kernels.swapBytes(pa + begin * sizeof(T), pb + begin * sizeof(T), (end - begin) * sizeof(T));
+        });
+    });
+}
+
+/**
+ * @brief 原地反转数组。多线程时每个线程交换前一半中的一段和后一半中与它对称的一段。
+ */
+template <ContiguousArray R>
+void reverse(R&& data, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireTriviallyCopyable<T>();
+    unsigned char* p = detail::bytesOf(data);
+    std::size_t n = std::ranges::size(data);
+    detail::dispatch([&](auto kernels) { detail::reverse<sizeof(T)>(kernels, p, n, threads); });
+}
+
+/**
+ * @brief 原地交换相邻的两块: [0, middle) 和 [middle, n) 交换位置 (与 std::rotate 相同)，
+ * 不需要额外的内存。用三次反转实现: 先分别反转两块，再反转整个数组。
+ */
+template <ContiguousArray R>
+void rotate(R&& data, std::size_t middle, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireTriviallyCopyable<T>();
+    unsigned char* p = detail::bytesOf(data);
+    std::size_t n = std::ranges::size(data);
+    if (middle > n) {
+        throw std::invalid_argument("permute::rotate: middle is past the end");
+    }
+    if (middle == 0 || middle == n) {
+        return;
+    }
+    detail::dispatch([&](auto kernels) {
+        detail::reverse<sizeof(T)>(kernels, p, middle, threads);
+        detail::reverse<sizeof(T)>(kernels, p + middle * sizeof(T), n - middle, threads);
+        detail::reverse<sizeof(T)>(kernels, p, n, threads);
+    });
+}
+
+/**
+ * @brief output[i] = input[index[i]]，i < index.size()。output 至少要有 index.size() 个位置。
+ * 下标可以重复; 越界时抛出 std::out_of_range (在读写任何元素之前检查)。
+ */
+template <ContiguousArray R, ContiguousArray Index, ContiguousArray Out>
+void gather(const R& input, const Index& index, Out&& output, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    using I = detail::ElementOf<Index>;
+    detail::requireTriviallyCopyable<T>();
+    static_assert(std::is_same_v<std::ranges::range_value_t<Out>, T>, "gather: output must have the input's element type");
+    std::span<const I> idx(std::ranges::data(index), std::ranges::size(index));
+    std::size_t n = idx.size();
+    if (std::ranges::size(output) < n) {
+        throw std::invalid_argument("permute::gather: output too small");
+    }
+    detail::checkIndices(idx, std::ranges::size(input), threads, "gather");
+    const unsigned char* in = detail::bytesOf(input);
+    unsigned char* out = detail::bytesOf(output);
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(n, detail::chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+            kernels.template gather<sizeof(T)>(in, std::ranges::size(input), idx.data() + begin, out + begin * sizeof(T),
+                                               end - begin);
+        });
+    });
+}
+
+/**
+ * @brief output[index[i]] = input[i]，i < input.size()。index 与 input 长度必须相同。
+ * 下标重复时单线程下后写入的元素生效; 多线程时各线程写同一位置是数据竞争，
+ * 所以 index 有重复时必须使用 threads = 1。
+ */
+template <ContiguousArray R, ContiguousArray Index, ContiguousArray Out>
+void scatter(const R& input, const Index& index, Out&& output, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    using I = detail::ElementOf<Index>;
+    detail::requireTriviallyCopyable<T>();
+    static_assert(std::is_same_v<std::ranges::range_value_t<Out>, T>, "scatter: output must have the input's element type");
+    std::span<const I> idx(std::ranges::data(index), std::ranges::size(index));
+    std::size_t n = std::ranges::size(input);
+    if (idx.size() != n) {
+        throw std::invalid_argument("permute::scatter: index and input have different sizes");
+    }
+    detail::checkIndices(idx, std::ranges::size(output), threads, "scatter");
+    const unsigned char* in = detail::bytesOf(input);
+    unsigned char* out = detail::bytesOf(output);
+    detail::dispatch([&](auto kernels) {
+        detail::parallelChunks(n, detail::chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+            kernels.template scatter<sizeof(T)>(in + begin * sizeof(T), idx.data() + begin, out, std::ranges::size(output),
+                                                end - begin);
+        });
+    });
+}
+
+/**
+ * @brief 原地重排: 完成后 data[i] 是原来的 data[permutation[i]] (与 gather 的结果相同)。
+ * permutation 必须是 0..n-1 的一个排列，否则抛出 std::invalid_argument (此时 data 不变)。
+ * 沿着排列的环依次移动元素，只需要 n 位的标记; 随机访问无法并行，也用不上 SIMD，
+ * 内存足够时 gather 到另一个数组再交换要快得多。
+ */
+template <ContiguousArray R, ContiguousArray Index>
+void applyPermutation(R&& data, const Index& permutation) {
+    using T = detail::ElementOf<R>;
+    using I = detail::ElementOf<Index>;
+    detail::requireTriviallyCopyable<T>();
+    static_assert(std::is_integral_v<I> && !std::is_same_v<I, bool>, "permute: indices must be integers");
+    std::size_t n = std::ranges::size(data);
+    const I* perm = std::ranges::data(permutation);
+    if (std::ranges::size(permutation) != n) {
+        throw std::invalid_argument("permute::applyPermutation: permutation and data have different sizes");
+    }
+    std::vector<std::uint64_t> seen((n + 63) / 64, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        bool negative = false;
+        if constexpr (std::is_signed_v<I>) {
+            negative = perm[i] < 0;
+        }
+        auto k = static_cast<std::size_t>(perm[i]);
+        if (negative || k >= n || (seen[k / 64] >> (k % 64) & 1) != 0) {
+            throw std::invalid_argument("permute::applyPermutation: not a permutation");
+        }
+        seen[k / 64] |= std::uint64_t{1} << (k % 64);
+    }
+    // 复用标记: 置位表示还没有放好
+    unsigned char* p = detail::bytesOf(data);
+    constexpr std::size_t N = sizeof(T);
+    for (std::size_t start = 0; start < n; ++start) {
+        if ((seen[start / 64] >> (start % 64) & 1) == 0) {
+            continue;
+        }
+        unsigned char temp[N];
+        std::memcpy(temp, p + start * N, N);
+        std::size_t j = start;
+        for (;;) {
+            seen[j / 64] &= ~(std::uint64_t{1} << (j % 64));
+            auto k = static_cast<std::size_t>(perm[j]);
+            if (k == start) {
+                std::memcpy(p + j * N, temp, N);
+                break;
+            }
+            std::memcpy(p + j * N, p + k * N, N);
+            j = k;
+        }
+    }
+}
+
+/**
+ * @brief 转置按行存储的 rows × cols 矩阵: output[c * rows + r] = input[r * cols + c]。
+ * input 必须正好有 rows * cols 个元素，output 至少要有这么多 (两者不能重叠)。
+ * 多线程时按较长的一边切成几段，每个线程递归地转置自己的一段。
+ */
+template <ContiguousArray R, ContiguousArray Out>
+void transpose(const R& input, std::size_t rows, std::size_t cols, Out&& output, unsigned threads = 0) {
+    using T = detail::ElementOf<R>;
+    detail::requireTriviallyCopyable<T>();
+    static_assert(std::is_same_v<std::ranges::range_value_t<Out>, T>, "transpose: output must have the input's element type");
+    if (cols != 0 && rows > std::numeric_limits<std::size_t>::max() / cols) {
+        throw std::invalid_argument("permute::transpose: rows * cols overflows");
+    }
+    std::size_t n = rows * cols;
+    if (std::ranges::size(input) != n || std::ranges::size(output) < n) {
+        throw std::invalid_argument("permute::transpose: sizes do not match rows * cols");
+    }
+    if (n == 0) {
+        return; // 0 × 0 时下面的分段数会是 0
+    }
+    const unsigned char* in = detail::bytesOf(input);
+    unsigned char* out = detail::bytesOf(output);
+    constexpr std::size_t N = sizeof(T);
+    std::size_t chunks = std::min(detail::chunkCount(n, threads), std::max(rows, cols));
+    detail::dispatch([&](auto kernels) {
+        if (rows >= cols) {
+            detail::parallelChunks(rows, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+                detail::transposeRecursive<N>(kernels, in + begin * cols * N, cols, out + begin * N, rows, end - begin, cols);
+            });
+        } else {
+            detail::parallelChunks(cols, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+                detail::transposeRecursive<N>(kernels, in + begin * N, cols, out + begin * rows * N, rows, rows, end - begin);
+            });
+        }
+    });
+}
+
+} // namespace permute
+
+#endif // PERMUTE_H
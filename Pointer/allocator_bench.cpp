@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+#include "Allocator.h"
+#include "../Class/Book.h"
+#include "../Strategy_Factory/ProductSpecStrategy.h"
+
+// g++ allocator_bench.cpp -o allocator_bench -std=c++20 -O2 -pthread -DLOG_ACTIVE_LEVEL=LOG_LEVEL_OFF
+// 用法: ./allocator_bench [线程数] [每个线程的操作次数]
+// 1. 多线程反复分配/释放 (每个线程保持 4096 个存活的块，每次随机释放一个、再分配一个 16..256 字节的新块)，
+//    比较全局 new/delete、SizeClassPool 和通过 std::pmr 接口使用的 PoolResource；
+// 2. 每个 "请求" 分配 1000 个小对象后全部释放: new/delete 与 Arena::reset 比较；
+// 3. 领域对象: Book 和产品策略用 new/delete (make_unique) 与 makePooled 比较。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <class F>
+static double seconds(F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 多数对象很小，少数较大: 16..64 字节占 3/4
+static std::size_t randomSize(std::uint64_t r) {
+    return (r & 3) != 0 ? 16 + (r >> 8) % 49 : 65 + (r >> 8) % 192;
+}
+
+struct Slot {
+    void* p = nullptr;
+    std::size_t size = 0;
+};
+
+// 每个线程执行 ops 次 "释放一个、分配一个"，返回所有线程每秒的操作数
+template <class Allocate, class Deallocate>
+static double churn(unsigned threads, std::size_t ops, Allocate allocate, Deallocate deallocate) {
+    double time = seconds([&] {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<Slot> slots(4096);
+                std::uint64_t state = 0x9E3779B97F4A7C15ull ^ (t + 1);
+                for (std::size_t i = 0; i < ops; ++i) {
+                    std::uint64_t r = nextRandom(state);
+                    Slot& slot = slots[r % slots.size()];
+                    if (slot.p != nullptr) {
+                        deallocate(slot.p, slot.size);
+                    }
+                    slot.size = randomSize(r >> 12);
+                    slot.p = allocate(slot.size);
+                    static_cast<char*>(slot.p)[0] = static_cast<char>(i); // 访问一下分配到的内存
+                }
+                for (Slot& slot : slots) {
+                    if (slot.p != nullptr) {
+                        deallocate(slot.p, slot.size);
+                    }
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    });
+    return static_cast<double>(threads) * ops / time;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+    if (threads == 0 || ops == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+    std::cout << threads << " 个线程, 每个线程 " << ops << " 次分配/释放\n";
+
+    // --- 1. 多线程反复分配/释放 ---
+    double global = churn(threads, ops,
+        [](std::size_t size) { return ::operator new(size); },
+        [](void* p, std::size_t size) { ::operator delete(p, size); });
+    double pool = churn(threads, ops,
+        [](std::size_t size) { return SizeClassPool::global().allocate(size); },
+        [](void* p, std::size_t size) { SizeClassPool::global().deallocate(p, size); });
+    std::pmr::memory_resource* resource = PoolResource::instance();
+    double pmr = churn(threads, ops,
+        [resource](std::size_t size) { return resource->allocate(size); },
+        [resource](void* p, std::size_t size) { resource->deallocate(p, size); });
+    std::cout << "反复分配/释放: new/delete " << global / 1e6 << " M 次/秒, SizeClassPool " << pool / 1e6
+              << " M 次/秒 (" << pool / global << "x), PoolResource " << pmr / 1e6 << " M 次/秒 ("
+              << pmr / global << "x)\n";
+
+    // --- 2. 每个请求分配 1000 个小对象 ---
+    const std::size_t requests = std::max<std::size_t>(1, ops / 1000);
+    std::vector<void*> objects(1000);
+    std::uint64_t state = 0x2545F4914F6CDD1Dull;
+    double perObject = seconds([&] {
+        for (std::size_t r = 0; r < requests; ++r) {
+            for (void*& p : objects) {
+                p = ::operator new(randomSize(nextRandom(state)));
+            }
+            for (void* p : objects) {
+                ::operator delete(p);
+            }
+        }
+    });
+    Arena arena;
+    double arenaTime = seconds([&] {
+        for (std::size_t r = 0; r < requests; ++r) {
+            for (void*& p : objects) {
+                p = arena.allocate(randomSize(nextRandom(state)));
+            }
+            arena.reset();
+        }
+    });
+    std::cout << "每个请求 1000 个对象: new/delete " << perObject * 1e9 / (requests * 1000) << " ns/个, Arena "
+              << arenaTime * 1e9 / (requests * 1000) << " ns/个 (" << perObject / arenaTime << "x), Arena 占用 "
+              << arena.bytesReserved() / 1024 << " KB\n";
+
+    // --- 3. 领域对象 ---
+    const std::size_t domainOps = std::max<std::size_t>(1, ops / 4);
+    std::vector<std::unique_ptr<Book>> books(256);
+    std::vector<PooledPtr<Book>> pooledBooks(256);
+    double bookNew = seconds([&] {
+        for (std::size_t i = 0; i < domainOps; ++i) {
+            books[i % books.size()] = std::make_unique<Book>("Modern C++", "Someone", 2020);
+        }
+    });
+    double bookPool = seconds([&] {
+        for (std::size_t i = 0; i < domainOps; ++i) {
+            pooledBooks[i % pooledBooks.size()] = makePooled<Book>("Modern C++", "Someone", 2020);
+        }
+    });
+    std::cout << "Book (" << sizeof(Book) << " 字节): make_unique " << bookNew * 1e9 / domainOps << " ns/个, makePooled "
+              << bookPool * 1e9 / domainOps << " ns/个\n";
+
+    std::vector<std::unique_ptr<IProductSpecStrategy>> strategies(256);
+    std::vector<PooledPtr<IProductSpecStrategy>> pooledStrategies(256);
+    double strategyNew = seconds([&] {
+        for (std::size_t i = 0; i < domainOps; ++i) {
+            strategies[i % strategies.size()] = StrategyFactory::createStrategy(static_cast<ProductModel>(i % kProductModelCount));
+        }
+    });
+    double strategyPool = seconds([&] {
+        for (std::size_t i = 0; i < domainOps; ++i) {
+            PooledPtr<IProductSpecStrategy>& slot = pooledStrategies[i % pooledStrategies.size()];
+            switch (static_cast<ProductModel>(i % kProductModelCount)) {
+                case ProductModel::Xiaomi15: slot = makePooled<Xiaomi15Strategy>(); break;
+                case ProductModel::Xiaomi14: slot = makePooled<Xiaomi14Strategy>(); break;
+                case ProductModel::Su7Ultra: slot = makePooled<Su7UltraStrategy>(); break;
+            }
+        }
+    });
+    std::cout << "策略对象: StrategyFactory (make_unique) " << strategyNew * 1e9 / domainOps << " ns/个, makePooled "
+              << strategyPool * 1e9 / domainOps << " ns/个\n";
+    return 0;
+}
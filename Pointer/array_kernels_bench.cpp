@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "ArrayKernels.h"
+
+// g++ array_kernels_bench.cpp -o array_kernels_bench -std=c++20 -O2 -pthread -Wno-psabi
+// 用法: ./array_kernels_bench [元素个数] [线程数]
+// 对 int32 和 float 数组测量各个内核的吞吐量 (GB/s，按读取的输入字节数计算):
+// 普通的逐个元素循环 (与 printArrayWithPointer 相同的写法) 作为对照，
+// 然后是每个指令集的单线程版本，以及当前指令集的多线程版本。
+
+namespace ak = array_kernels;
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 运行 run 若干次，返回最快一次的 GB/s
+template <class F>
+static double gigabytesPerSecond(std::size_t bytes, F&& run) {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return static_cast<double>(bytes) / best / 1e9;
+}
+
+// 普通循环: 一次处理一个元素 (-O2 下 GCC 不会向量化)
+template <class T>
+struct Plain {
+    static ak::SumType<T> sum(const T* p, std::size_t n) {
+        ak::SumType<T> s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            s += p[i];
+        }
+        return s;
+    }
+    static T max(const T* p, std::size_t n) {
+        T m = p[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            m = p[i] > m ? p[i] : m;
+        }
+        return m;
+    }
+    static void scan(const T* in, T* out, std::size_t n) {
+        T s = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            s += in[i];
+            out[i] = s;
+        }
+    }
+    static std::size_t filter(const T* in, T* out, std::size_t n) {
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (in[i] > T(0)) {
+                out[k++] = in[i];
+            }
+        }
+        return k;
+    }
+};
+
+template <class T>
+static void run(const char* name, std::size_t n, unsigned threads) {
+    std::vector<T> data(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (T& x : data) {
+        x = static_cast<T>(static_cast<std::int64_t>(nextRandom(state) % 2001) - 1000);
+    }
+    std::vector<T> out(n);
+    const std::size_t bytes = n * sizeof(T);
+    volatile double sink = 0;
+
+    std::cout << "\n== " << name << ", " << n << " 个元素 (" << bytes / (1024 * 1024) << " MB) ==\n";
+    std::cout << "普通循环: sum " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(Plain<T>::sum(data.data(), n)); })
+              << ", max " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(Plain<T>::max(data.data(), n)); })
+              << ", scan " << gigabytesPerSecond(bytes, [&] { Plain<T>::scan(data.data(), out.data(), n); })
+              << ", filter " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(Plain<T>::filter(data.data(), out.data(), n)); })
+              << " GB/s\n";
+
+    auto kernels = [&](unsigned t) {
+        std::cout << "sum " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(ak::sum(data, t)); })
+                  << ", minMax " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(ak::minMax(data, t)->max); })
+                  << ", scan " << gigabytesPerSecond(bytes, [&] { ak::inclusiveScan(data, out, t); })
+                  << ", transform " << gigabytesPerSecond(bytes, [&] { ak::transform(data, out, ak::vectorized([](auto x) { return x * 3 + 1; }), t); })
+                  << ", filter " << gigabytesPerSecond(bytes, [&] {
+                         sink = sink + static_cast<double>(ak::filter(data, out, ak::vectorized([](auto x) { return x > 0; }), t));
+                     })
+                  << ", histogram " << gigabytesPerSecond(bytes, [&] { sink = sink + static_cast<double>(ak::histogram(data, -1000, 1001, 64, t)[0]); })
+                  << " GB/s\n";
+    };
+    for (ak::SimdLevel level : {ak::SimdLevel::Baseline, ak::SimdLevel::Avx2, ak::SimdLevel::Avx512}) {
+        if (level > ak::supportedSimdLevel()) {
+            continue;
+        }
+        ak::setSimdLevel(level);
+        std::cout << ak::simdLevelName(level) << ", 1 线程: ";
+        kernels(1);
+    }
+    if (threads > 1) {
+        std::cout << ak::simdLevelName(ak::simdLevel()) << ", " << threads << " 线程: ";
+        kernels(threads);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64u << 20;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    if (n == 0 || threads == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+    std::cout << "CPU 支持: " << ak::simdLevelName(ak::supportedSimdLevel()) << std::endl;
+    run<std::int32_t>("int32", n, threads);
+    run<float>("float", n, threads);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "Permute.h"
+
+// g++ permute_bench.cpp -o permute_bench -std=c++20 -O2 -pthread -Wno-psabi
+// 用法: ./permute_bench [元素个数] [线程数]
+// 对 int32 和 double 数组测量各个重排操作的吞吐量 (GB/s，按移动的元素字节数计算):
+// 普通的逐个元素循环 (swapIntegers 的写法: 每次交换经过一个临时变量) 作为对照，
+// 然后是每个指令集的单线程版本，以及当前指令集的多线程版本。gather / scatter 使用随机排列作为下标。
+
+namespace ak = array_kernels;
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 运行 run 若干次，返回最快一次的 GB/s
+template <class F>
+static double gigabytesPerSecond(std::size_t bytes, F&& run) {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return static_cast<double>(bytes) / best / 1e9;
+}
+
+// 普通循环: 一次处理一个元素
+template <class T>
+struct Plain {
+    static void swapRanges(T* a, T* b, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            T temp = a[i];
+            a[i] = b[i];
+            b[i] = temp;
+        }
+    }
+    static void reverse(T* p, std::size_t n) {
+        for (std::size_t i = 0; i < n / 2; ++i) {
+            T temp = p[i];
+            p[i] = p[n - 1 - i];
+            p[n - 1 - i] = temp;
+        }
+    }
+    static void gather(const T* in, const std::uint32_t* index, T* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = in[index[i]];
+        }
+    }
+    static void scatter(const T* in, const std::uint32_t* index, T* out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[index[i]] = in[i];
+        }
+    }
+    static void transpose(const T* in, std::size_t rows, std::size_t cols, T* out) {
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < cols; ++c) {
+                out[c * rows + r] = in[r * cols + c];
+            }
+        }
+    }
+};
+
+template <class T>
+static void run(const char* name, std::size_t n, const std::vector<std::uint32_t>& perm, unsigned threads) {
+    std::vector<T> a(n);
+    std::vector<T> b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<T>(i);
+        b[i] = static_cast<T>(n - i);
+    }
+    const std::size_t side = static_cast<std::size_t>(std::sqrt(static_cast<double>(n)));
+    const std::size_t rows = side / 2;
+    const std::size_t cols = side * side / rows / 2 * 2; // 非正方形，rows × cols 不超过 n
+    std::span<const T> matrix(a.data(), rows * cols);
+    const std::size_t bytes = n * sizeof(T);
+    const std::size_t matrixBytes = rows * cols * sizeof(T);
+
+    std::cout << "\n== " << name << ", " << n << " 个元素 (" << bytes / (1024 * 1024) << " MB), 转置 " << rows << " × "
+              << cols << " ==\n";
+    std::cout << "普通循环: swap " << gigabytesPerSecond(bytes, [&] { Plain<T>::swapRanges(a.data(), b.data(), n); })
+              << ", reverse " << gigabytesPerSecond(bytes, [&] { Plain<T>::reverse(a.data(), n); })
+              << ", gather " << gigabytesPerSecond(bytes, [&] { Plain<T>::gather(a.data(), perm.data(), b.data(), n); })
+              << ", scatter " << gigabytesPerSecond(bytes, [&] { Plain<T>::scatter(a.data(), perm.data(), b.data(), n); })
+              << ", transpose " << gigabytesPerSecond(matrixBytes, [&] { Plain<T>::transpose(a.data(), rows, cols, b.data()); })
+              << " GB/s\n";
+
+    auto kernels = [&](unsigned t) {
+        std::cout << "swap " << gigabytesPerSecond(bytes, [&] { permute::swapRanges(a, b, t); })
+                  << ", reverse " << gigabytesPerSecond(bytes, [&] { permute::reverse(a, t); })
+                  << ", rotate " << gigabytesPerSecond(bytes, [&] { permute::rotate(a, n / 3, t); })
+                  << ", gather " << gigabytesPerSecond(bytes, [&] { permute::gather(a, perm, b, t); })
+                  << ", scatter " << gigabytesPerSecond(bytes, [&] { permute::scatter(a, perm, b, t); })
+                  << ", transpose " << gigabytesPerSecond(matrixBytes, [&] { permute::transpose(matrix, rows, cols, b, t); })
+                  << " GB/s\n";
+    };
+    for (ak::SimdLevel level : {ak::SimdLevel::Baseline, ak::SimdLevel::Avx2, ak::SimdLevel::Avx512}) {
+        if (level > ak::supportedSimdLevel()) {
+            continue;
+        }
+        ak::setSimdLevel(level);
+        std::cout << ak::simdLevelName(level) << ", 1 线程: ";
+        kernels(1);
+    }
+    if (threads > 1) {
+        std::cout << ak::simdLevelName(ak::simdLevel()) << ", " << threads << " 线程: ";
+        kernels(threads);
+    }
+    std::cout << "applyPermutation (原地, 单线程): "
+              << gigabytesPerSecond(bytes, [&] { permute::applyPermutation(a, perm); }) << " GB/s\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 32u << 20;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    if (n < 16 || n > UINT32_MAX || threads == 0) {
+        std::cerr << "元素个数必须在 16 到 2^32 - 1 之间，线程数必须为正数。" << std::endl;
+        return 1;
+    }
+    // 随机排列 (Fisher-Yates)
+    std::vector<std::uint32_t> perm(n);
+    std::iota(perm.begin(), perm.end(), 0u);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (std::size_t i = n - 1; i > 0; --i) {
+        std::swap(perm[i], perm[nextRandom(state) % (i + 1)]);
+    }
+    std::cout << "CPU 支持: " << ak::simdLevelName(ak::supportedSimdLevel()) << std::endl;
+    run<std::int32_t>("int32", n, perm, threads);
+    run<double>("double", n, perm, threads);
+    return 0;
+}
@@ -0,0 +1,161 @@
+// PluginLoader.h
+#ifndef PLUGIN_LOADER_H
+#define PLUGIN_LOADER_H
+
+#include <dlfcn.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ProductSpecPlugin.h" // 插件的 C 接口
+#include "StrategyRegistry.h"  // 加载后的策略登记在这里
+
+// 从目录中按需加载产品规格插件 (libspec_<产品名>.so)。
+// 启动时不打开任何插件: 第一次查询某个产品、而登记表里还没有它时，才 dlopen 对应的文件并把策略登记为单例。
+// 之后的查询直接走 StrategyRegistry，不加锁。新插件放进目录后就能被查到，不需要重启。
+
+/**
+ * @brief 插件提供的策略。持有共享库的句柄，策略对象存在期间插件不会被卸载
+ */
+class PluginStrategy : public IProductSpecStrategy {
+public:
+    PluginStrategy(std::shared_ptr<void> library, const ProductSpecPluginInfo* info)
+        : library(std::move(library)), info(info) {}
+
+    std::string get_spec_string() const override { return info->get_spec(); }
+
+private:
+    std::shared_ptr<void> library;
+    const ProductSpecPluginInfo* info;
+};
+
+class PluginLoader {
+public:
+    explicit PluginLoader(std::filesystem::path directory)
+        : PluginLoader(std::move(directory), StrategyRegistry::global()) {}
+
+    PluginLoader(std::filesystem::path directory, StrategyRegistry& registry)
+        : directory(std::move(directory)), registry(registry) {}
+
+    // 目录中可以加载的产品名 (只看文件名，不打开插件)
+    std::vector<std::string> available() const {
+        std::vector<std::string> names;
+        std::error_code error;
+        for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+            std::string filename = file.path().filename().string();
+            if (filename.size() > kPrefix.size() + kSuffix.size() && filename.starts_with(kPrefix) &&
+                filename.ends_with(kSuffix)) {
+                names.push_back(filename.substr(kPrefix.size(), filename.size() - kPrefix.size() - kSuffix.size()));
+            }
+        }
+        return names;
+    }
+
+    /**
+     * @brief 按名字取得策略，需要时先加载插件。
+     * @return 既没有登记、也没有可用的插件时返回 nullptr
+     */
+    std::shared_ptr<const IProductSpecStrategy> get(std::string_view name) {
+        if (auto strategy = registry.get(name)) {
+            return strategy;
+        }
+        load(std::string(name));
+        return registry.get(name);
+    }
+
+    // 与 StrategyRegistry::visit 相同，需要时先加载插件
+    template <class F>
+    bool visit(std::string_view name, F&& f) {
+        if (registry.visit(name, f)) {
+            return true;
+        }
+        return load(std::string(name)) && registry.visit(name, f);
+    }
+
+    /**
+     * @brief 加载插件并登记它的策略。已经加载过时直接返回 true。
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool load(const std::string& name, std::string* error = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (libraries.count(name) != 0) {
+            return true;
+        }
+        // 名字会拼进路径，不允许出现目录分隔符
+        if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..") {
+            return fail(error, "invalid plugin name: " + name);
+        }
+        std::filesystem::path path = directory / (std::string(kPrefix) + name + std::string(kSuffix));
+        std::error_code exists;
+        if (!std::filesystem::exists(path, exists)) {
+            return fail(error, "no plugin file: " + path.string());
+        }
+
+        void* raw = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (raw == nullptr) {
+            const char* message = dlerror();
+            return fail(error, message != nullptr ? message : "dlopen failed: " + path.string());
+        }
+        std::shared_ptr<void> library(raw, [](void* handle) { dlclose(handle); });
+        auto entry = reinterpret_cast<ProductSpecPluginEntry>(dlsym(raw, PRODUCT_SPEC_PLUGIN_ENTRY));
+        if (entry == nullptr) {
+            return fail(error, path.string() + ": missing " PRODUCT_SPEC_PLUGIN_ENTRY);
+        }
+        const ProductSpecPluginInfo* info = entry();
+        if (info == nullptr || info->abi_version != PRODUCT_SPEC_PLUGIN_ABI_VERSION) {
+            return fail(error, path.string() + ": unsupported ABI version");
+        }
+        if (info->name == nullptr || name != info->name || info->get_spec == nullptr) {
+            return fail(error, path.string() + ": plugin info does not match file name");
+        }
+        if (!registry.addSingleton(name, std::make_shared<const PluginStrategy>(library, info))) {
+            return fail(error, "product already registered: " + name);
+        }
+        libraries.emplace(name, std::move(library));
+        return true;
+    }
+
+    /**
+     * @brief 注销插件的策略，之后再次查询会重新加载。
+     * 共享库在最后一个策略对象释放后才真正卸载 (各线程缓存的旧快照也会持有它)，
+     * 在那之前重新加载得到的仍是内存中的旧版本。
+     */
+    bool unload(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (libraries.erase(name) == 0) {
+            return false;
+        }
+        registry.remove(name);
+        return true;
+    }
+
+    // 已经加载的插件数量
+    std::size_t loadedCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return libraries.size();
+    }
+
+private:
+    static constexpr std::string_view kPrefix = "libspec_";
+    static constexpr std::string_view kSuffix = ".so";
+
+    static bool fail(std::string* error, std::string message) {
+        if (error != nullptr) {
+            *error = std::move(message);
+        }
+        return false;
+    }
+
+    std::filesystem::path directory;
+    StrategyRegistry& registry;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<void>> libraries; // 已加载的插件句柄
+};
+
+#endif // PLUGIN_LOADER_H
@@ -2,6 +2,8 @@
 #ifndef PRODUCT_MODEL_H
 #define PRODUCT_MODEL_H
 
+#include <cstddef>
+
 // 定义一个枚举类来表示所有可选的产品型号。
 // 这为我们的工厂提供了一个清晰、类型安全的方式来指定需要哪种策略。
 enum class ProductModel {
@@ -10,4 +12,7 @@ enum class ProductModel {
     Su7Ultra    // SU7 Ultra
 };
 
+// 型号的数量 (增加型号时同步修改)，用于按型号编号建表
+inline constexpr std::size_t kProductModelCount = 3;
+
 #endif // PRODUCT_MODEL_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+/* ProductSpecPlugin.h */
+#ifndef PRODUCT_SPEC_PLUGIN_H
+#define PRODUCT_SPEC_PLUGIN_H
+
+/*
+ * 产品规格插件的 C 接口 (ABI)。
+ * 插件是一个共享库，文件名为 libspec_<产品名>.so，导出一个 C 函数 product_spec_plugin_info()。
+ * 只用 C 的类型，所以插件可以用任何编译器 (甚至其他语言) 编译，主程序的 C++ 类变化也不影响已经发布的插件。
+ * 增加字段时只能加在结构体末尾，并增加 PRODUCT_SPEC_PLUGIN_ABI_VERSION。
+ */
+
+#include <stdint.h>
+
+#define PRODUCT_SPEC_PLUGIN_ABI_VERSION 1u
+#define PRODUCT_SPEC_PLUGIN_ENTRY "product_spec_plugin_info"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ProductSpecPluginInfo {
+    uint32_t abi_version; /* 编译插件时的 PRODUCT_SPEC_PLUGIN_ABI_VERSION */
+    const char* name;     /* 产品名，必须与文件名中的 <产品名> 相同 */
+    /* 返回规格字符串。返回的字符串由插件持有，在插件卸载前一直有效 */
+    const char* (*get_spec)(void);
+} ProductSpecPluginInfo;
+
+/* 插件导出的入口函数: 返回的结构体由插件持有，在插件卸载前一直有效 */
+typedef const ProductSpecPluginInfo* (*ProductSpecPluginEntry)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRODUCT_SPEC_PLUGIN_H */
@@ -0,0 +1,208 @@
+// ProductSpecStrategy.h
+#ifndef PRODUCT_SPEC_STRATEGY_H
+#define PRODUCT_SPEC_STRATEGY_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include "ProductModel.h" // 包含产品型号的枚举头文件
+
+// 同一组产品规格提供两种查询方式:
+//  - 运行时多态 (虚函数): 工厂每次 new 一个策略对象，通过虚函数取得规格。新策略可以在别处派生，最灵活；
+//  - 编译期分派 (product_spec 命名空间): 策略是没有状态的空类型，用 std::variant 保存、CRTP 提供接口，
+//    另有一张按型号编号的 constexpr 表直接返回 std::string_view。不分配内存，适合每个请求都要查规格的场合。
+// 两种方式的规格字符串都来自 product_spec 中的常量，只写一份。
+
+// ===================================================================
+// I. 编译期分派 (variant / CRTP / constexpr 表)
+// ===================================================================
+
+namespace product_spec {
+
+/**
+ * @brief 策略的公共接口 (CRTP)
+ * 派生类提供 kModel 和 kSpec 两个静态常量，spec() 在编译期就能确定调用哪一个，没有虚函数。
+ */
+template <class Derived>
+struct SpecStrategy {
+    static constexpr ProductModel model() { return Derived::kModel; }
+    constexpr std::string_view spec() const { return Derived::kSpec; }
+};
+
+struct Xiaomi15 : SpecStrategy<Xiaomi15> {
+    static constexpr ProductModel kModel = ProductModel::Xiaomi15;
+    static constexpr std::string_view kSpec = "xiaomi15:8elite";
+};
+
+struct Xiaomi14 : SpecStrategy<Xiaomi14> {
+    static constexpr ProductModel kModel = ProductModel::Xiaomi14;
+    static constexpr std::string_view kSpec = "xiaomi14:8gen3";
+};
+
+struct Su7Ultra : SpecStrategy<Su7Ultra> {
+    static constexpr ProductModel kModel = ProductModel::Su7Ultra;
+    static constexpr std::string_view kSpec = "su7ultra:v8s";
+};
+
+// 所有策略的集合。增加型号时在这里加上新的策略类型即可，下面的 select() 和规格表会自动包含它
+using AnyStrategy = std::variant<Xiaomi15, Xiaomi14, Su7Ultra>;
+
+namespace detail {
+
+template <std::size_t... I>
+constexpr std::optional<AnyStrategy> select(ProductModel model, std::index_sequence<I...>) {
+    std::optional<AnyStrategy> result;
+    ((std::variant_alternative_t<I, AnyStrategy>::kModel == model
+          ? (result.emplace(std::in_place_index<I>), true)
+          : false) || ...);
+    return result;
+}
+
+template <std::size_t... I>
+constexpr std::array<std::string_view, kProductModelCount> buildTable(std::index_sequence<I...>) {
+    std::array<std::string_view, kProductModelCount> table{};
+    ((table[static_cast<std::size_t>(std::variant_alternative_t<I, AnyStrategy>::kModel)] =
+          std::variant_alternative_t<I, AnyStrategy>::kSpec), ...);
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * @brief 按型号选择策略，结果按值保存在 variant 中 (不分配内存)
+ * @return 未知型号返回 std::nullopt
+ */
+constexpr std::optional<AnyStrategy> select(ProductModel model) {
+    return detail::select(model, std::make_index_sequence<std::variant_size_v<AnyStrategy>>{});
+}
+
+// 取得 variant 中策略的规格
+constexpr std::string_view spec(const AnyStrategy& strategy) {
+    return std::visit([](const auto& s) { return s.spec(); }, strategy);
+}
+
+// 按型号编号排列的规格表，在编译期生成
+inline constexpr std::array<std::string_view, kProductModelCount> kSpecTable =
+    detail::buildTable(std::make_index_sequence<std::variant_size_v<AnyStrategy>>{});
+
+constexpr bool everyModelHasSpec() {
+    for (std::string_view s : kSpecTable) {
+        if (s.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(everyModelHasSpec(), "每个 ProductModel 都必须有对应的策略");
+
+/**
+ * @brief 查表得到型号的规格: 一次数组访问，返回的 string_view 指向静态存储，始终有效
+ * @return 未知型号返回空的 string_view
+ */
+constexpr std::string_view lookup(ProductModel model) {
+    std::size_t index = static_cast<std::size_t>(model);
+    return index < kSpecTable.size() ? kSpecTable[index] : std::string_view{};
+}
+
+static_assert(lookup(ProductModel::Su7Ultra) == "su7ultra:v8s");
+static_assert(spec(*select(ProductModel::Xiaomi14)) == lookup(ProductModel::Xiaomi14));
+
+} // namespace product_spec
+
+// ===================================================================
+// II. 策略模式 (Strategy Pattern) - 运行时多态的版本
+// ===================================================================
+
+/**
+ * @brief 策略接口 (The Strategy Interface)
+ * * 定义了一个所有产品规格“策略”都必须实现的通用接口。
+ */
+class IProductSpecStrategy {
+public:
+    virtual ~IProductSpecStrategy() = default;
+
+    // 纯虚函数，任何具体的产品策略都必须提供自己的规格信息。
+    virtual std::string get_spec_string() const = 0;
+};
+
+/**
+ * @brief 具体策略A：小米15的规格
+ */
+class Xiaomi15Strategy : public IProductSpecStrategy {
+public:
+    std::string get_spec_string() const override {
+        return std::string(product_spec::Xiaomi15::kSpec);
+    }
+};
+
+/**
+ * @brief 具体策略B：小米14的规格
+ */
+class Xiaomi14Strategy : public IProductSpecStrategy {
+public:
+    std::string get_spec_string() const override {
+        return std::string(product_spec::Xiaomi14::kSpec);
+    }
+};
+
+/**
+ * @brief 具体策略C：SU7 Ultra的规格
+ */
+class Su7UltraStrategy : public IProductSpecStrategy {
+public:
+    std::string get_spec_string() const override {
+        return std::string(product_spec::Su7Ultra::kSpec);
+    }
+};
+
+// ===================================================================
+// III. 工厂模式 (Factory Pattern)
+// ===================================================================
+
+/**
+ * @brief 策略工厂 (The Strategy Factory)
+ * * 它的职责是根据请求的产品型号，创建对应的规格策略实例。
+ */
+class StrategyFactory {
+public:
+    /**
+     * @brief 创建一个产品规格策略实例 (运行时多态，每次调用都在堆上分配)。
+     * @param model 我们从枚举中选择的产品型号。
+     * @return 返回一个指向策略接口的智能指针。
+     */
+    static std::unique_ptr<IProductSpecStrategy> createStrategy(ProductModel model) {
+        switch (model) {
+            case ProductModel::Xiaomi15:
+                return std::make_unique<Xiaomi15Strategy>();
+            case ProductModel::Xiaomi14:
+                return std::make_unique<Xiaomi14Strategy>();
+            case ProductModel::Su7Ultra:
+                return std::make_unique<Su7UltraStrategy>();
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * @brief 编译期分派的版本: 策略按值放在 variant 中返回，不分配内存。
+     * @return 未知型号返回 std::nullopt
+     */
+    static constexpr std::optional<product_spec::AnyStrategy> selectStrategy(ProductModel model) {
+        return product_spec::select(model);
+    }
+
+    /**
+     * @brief 只需要规格字符串时直接查 constexpr 表。
+     * @return 未知型号返回空的 string_view
+     */
+    static constexpr std::string_view specOf(ProductModel model) {
+        return product_spec::lookup(model);
+    }
+};
+
+#endif // PRODUCT_SPEC_STRATEGY_H
@@ -0,0 +1,413 @@
+// SpecCatalog.h
+#ifndef SPEC_CATALOG_H
+#define SPEC_CATALOG_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "ProductModel.h" // 包含产品型号的枚举头文件
+
+// 结构化的产品规格目录。
+// get_spec_string() 返回 "xiaomi15:8elite" 这样的字符串，调用者还要自己解析；目录里的每条记录直接分成
+// 名字、型号、芯片、版本几个字段。目录保存为一个扁平的二进制文件，打开时 mmap 整个文件，不做解析，
+// 所以 100 万条记录也能瞬间打开；按名字 (哈希表) 或按 ProductModel (数组) 查找都是 O(1)，
+// 返回的 string_view 直接指向映射的文件，查询不分配内存。
+//
+// 文件格式 (本机字节序，各部分按 8 字节对齐):
+//   Header | Record[recordCount] | Bucket[bucketCount] | uint32 modelIndex[modelCount] | 字符串区
+// 字符串区里相同的字符串只保存一份。哈希表是开放寻址 (线性探测)，桶数是 2 的幂且至少是记录数的两倍。
+
+namespace spec_catalog {
+
+inline constexpr char kMagic[8] = {'S', 'P', 'E', 'C', 'C', 'A', 'T', '\0'};
+inline constexpr std::uint32_t kFormatVersion = 1;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304;
+inline constexpr std::uint32_t kNoRecord = 0xFFFFFFFF;
+
+// 字符串在字符串区中的位置
+struct StringRef {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct Record {
+    StringRef name;    // 产品名，查找用的键，例如 "xiaomi15"
+    StringRef model;   // 型号，例如 "Xiaomi 15"
+    StringRef chip;    // 芯片，例如 "8elite"
+    StringRef version; // 版本，例如 "2024"
+};
+
+struct Bucket {
+    std::uint32_t record; // 记录编号 + 1，0 表示空桶
+    std::uint32_t tag;    // 名字哈希的高 32 位: 不相等时不用读记录就能跳过
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t formatVersion;
+    std::uint32_t byteOrder;
+    std::uint32_t recordCount;
+    std::uint32_t bucketCount;
+    std::uint32_t modelCount;
+    std::uint32_t reserved;
+    std::uint64_t recordsOffset;
+    std::uint64_t bucketsOffset;
+    std::uint64_t modelIndexOffset;
+    std::uint64_t stringsOffset;
+    std::uint64_t stringsSize;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) % 8 == 0);
+static_assert(sizeof(Record) == 32 && sizeof(Bucket) == 8);
+
+// FNV-1a: 文件里保存的是哈希的结果，所以必须用固定的算法 (std::hash 在不同的标准库中可能不同)
+constexpr std::uint64_t hashName(std::string_view name) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t alignUp(std::uint64_t n) { return (n + 7) & ~std::uint64_t{7}; }
+
+} // namespace spec_catalog
+
+/**
+ * @brief 一条规格记录。各字段指向映射的文件，在 SpecCatalog 关闭前有效
+ */
+struct SpecRecordView {
+    std::string_view name;
+    std::string_view model;
+    std::string_view chip;
+    std::string_view version;
+
+    // 与 get_spec_string() 相同的格式: "名字:芯片"
+    std::string specString() const {
+        std::string spec(name);
+        spec += ':';
+        spec += chip;
+        return spec;
+    }
+};
+
+/**
+ * @brief 生成目录文件
+ */
+class SpecCatalogWriter {
+public:
+    /**
+     * @brief 增加一条记录。
+     * @param product 可选，同时允许按 ProductModel 查找
+     * @return 名字 (或型号) 重复时返回 false
+     */
+    bool add(std::string_view name, std::string_view model, std::string_view chip, std::string_view version,
+             std::optional<ProductModel> product = std::nullopt) {
+        if (!names.insert(std::string(name)).second) {
+            return false;
+        }
+        if (product) {
+            std::uint32_t& slot = modelIndex[static_cast<std::size_t>(*product)];
+            if (slot != spec_catalog::kNoRecord) {
+                names.erase(std::string(name));
+                return false;
+            }
+            slot = static_cast<std::uint32_t>(records.size());
+        }
+        records.push_back(spec_catalog::Record{store(name), store(model), store(chip), store(version)});
+        hashes.push_back(spec_catalog::hashName(name));
+        return true;
+    }
+
+    std::size_t size() const { return records.size(); }
+
+    /**
+     * @brief 写入文件。先写到 path + ".tmp" 并 fsync，再 rename 替换:
+     * 其他进程已经映射的旧文件不会被截断 (否则访问映射会收到 SIGBUS)，它们继续看到旧的内容。
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool write(const std::string& path, std::string* error = nullptr) const {
+        using namespace spec_catalog;
+        if (records.size() >= kNoRecord / 2) {
+            return fail(error, "too many records");
+        }
+        // StringRef 的偏移和长度都是 32 位: 字符串区超过 4 GiB 时偏移会回绕，读出错误的字符串
+        if (strings.size() > UINT32_MAX) {
+            return fail(error, "string area exceeds 4 GiB");
+        }
+        std::uint32_t bucketCount = 16;
+        while (bucketCount < records.size() * 2) {
+            bucketCount *= 2;
+        }
+        std::vector<Bucket> buckets(bucketCount, Bucket{0, 0});
+        for (std::uint32_t i = 0; i < records.size(); ++i) {
+            std::uint32_t slot = static_cast<std::uint32_t>(hashes[i]) & (bucketCount - 1);
+            while (buckets[slot].record != 0) {
+                slot = (slot + 1) & (bucketCount - 1);
+            }
+            buckets[slot] = Bucket{i + 1, static_cast<std::uint32_t>(hashes[i] >> 32)};
+        }
+
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kFormatVersion;
+        header.byteOrder = kByteOrderMark;
+        header.recordCount = static_cast<std::uint32_t>(records.size());
+        header.bucketCount = bucketCount;
+        header.modelCount = static_cast<std::uint32_t>(modelIndex.size());
+        header.recordsOffset = sizeof(Header);
+        header.bucketsOffset = alignUp(header.recordsOffset + records.size() * sizeof(Record));
+        header.modelIndexOffset = alignUp(header.bucketsOffset + buckets.size() * sizeof(Bucket));
+        header.stringsOffset = alignUp(header.modelIndexOffset + modelIndex.size() * sizeof(std::uint32_t));
+        header.stringsSize = strings.size();
+
+        const std::string tempPath = path + ".tmp";
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return fail(error, "cannot create " + tempPath);
+        }
+        auto pad = [&](std::uint64_t offset) {
+            static constexpr char zeros[8] = {};
+            out.write(zeros, static_cast<std::streamsize>(offset - static_cast<std::uint64_t>(out.tellp())));
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Record)));
+        pad(header.bucketsOffset);
+        out.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(buckets.size() * sizeof(Bucket)));
+        pad(header.modelIndexOffset);
+        out.write(reinterpret_cast<const char*>(modelIndex.data()), static_cast<std::streamsize>(modelIndex.size() * sizeof(std::uint32_t)));
+        pad(header.stringsOffset);
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        out.close();
+        if (!out) {
+            std::remove(tempPath.c_str());
+            return fail(error, "write failed: " + tempPath);
+        }
+        // rename 之前先把内容落盘，崩溃时要么是旧文件，要么是完整的新文件
+        int fd = ::open(tempPath.c_str(), O_RDONLY | O_CLOEXEC);
+        bool synced = fd >= 0 && ::fsync(fd) == 0;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (!synced || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            return fail(error, "cannot replace " + path);
+        }
+        return true;
+    }
+
+private:
+    // 把字符串放入字符串区，相同的字符串只保存一份
+    spec_catalog::StringRef store(std::string_view text) {
+        auto it = stored.find(std::string(text));
+        if (it != stored.end()) {
+            return it->second;
+        }
+        spec_catalog::StringRef ref{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(text.size())};
+        strings.append(text);
+        stored.emplace(std::string(text), ref);
+        return ref;
+    }
+
+    static bool fail(std::string* error, std::string message) {
+        if (error != nullptr) {
+            *error = std::move(message);
+        }
+        return false;
+    }
+
+    std::vector<spec_catalog::Record> records;
+    std::vector<std::uint64_t> hashes;
+    std::array<std::uint32_t, kProductModelCount> modelIndex = makeEmptyIndex();
+    std::string strings;
+    std::unordered_map<std::string, spec_catalog::StringRef> stored;
+    std::unordered_set<std::string> names;
+
+    static constexpr std::array<std::uint32_t, kProductModelCount> makeEmptyIndex() {
+        std::array<std::uint32_t, kProductModelCount> index{};
+        index.fill(spec_catalog::kNoRecord);
+        return index;
+    }
+};
+
+/**
+ * @brief 只读打开目录文件 (mmap)。打开时只检查文件头和各部分的边界，不读取记录
+ */
+class SpecCatalog {
+public:
+    SpecCatalog() = default;
+    SpecCatalog(const SpecCatalog&) = delete;
+    SpecCatalog& operator=(const SpecCatalog&) = delete;
+
+    SpecCatalog(SpecCatalog&& other) noexcept { swap(other); }
+    SpecCatalog& operator=(SpecCatalog&& other) noexcept {
+        SpecCatalog moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~SpecCatalog() { close(); }
+
+    /**
+     * @brief 映射目录文件，之前打开的文件会先关闭。
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool open(const std::string& path, std::string* error = nullptr) {
+        using namespace spec_catalog;
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return fail(error, "cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(Header)) {
+            ::close(fd);
+            return fail(error, path + ": not a spec catalog");
+        }
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            return fail(error, "mmap failed: " + path);
+        }
+        mapped = static_cast<const char*>(data);
+        mappedSize = size;
+
+        const Header& h = *reinterpret_cast<const Header*>(mapped);
+        auto fits = [&](std::uint64_t offset, std::uint64_t bytes) {
+            return offset % 8 == 0 && offset <= mappedSize && bytes <= mappedSize - offset;
+        };
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.formatVersion != kFormatVersion ||
+            h.byteOrder != kByteOrderMark) {
+            close();
+            return fail(error, path + ": not a spec catalog (or written by another version / byte order)");
+        }
+        if (h.bucketCount == 0 || (h.bucketCount & (h.bucketCount - 1)) != 0 || h.recordCount >= h.bucketCount ||
+            !fits(h.recordsOffset, std::uint64_t{h.recordCount} * sizeof(Record)) ||
+            !fits(h.bucketsOffset, std::uint64_t{h.bucketCount} * sizeof(Bucket)) ||
+            !fits(h.modelIndexOffset, std::uint64_t{h.modelCount} * sizeof(std::uint32_t)) ||
+            !fits(h.stringsOffset, h.stringsSize)) {
+            close();
+            return fail(error, path + ": corrupt spec catalog");
+        }
+        header = &h;
+        records = reinterpret_cast<const Record*>(mapped + h.recordsOffset);
+        buckets = reinterpret_cast<const Bucket*>(mapped + h.bucketsOffset);
+        modelIndex = reinterpret_cast<const std::uint32_t*>(mapped + h.modelIndexOffset);
+        strings = std::string_view(mapped + h.stringsOffset, h.stringsSize);
+        return true;
+    }
+
+    void close() {
+        if (mapped != nullptr) {
+            munmap(const_cast<char*>(mapped), mappedSize);
+        }
+        mapped = nullptr;
+        mappedSize = 0;
+        header = nullptr;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+    std::size_t size() const { return header ? header->recordCount : 0; }
+
+    // 第 index 条记录 (index < size())。记录损坏 (字符串越界) 时返回 nullopt
+    std::optional<SpecRecordView> record(std::size_t index) const {
+        const spec_catalog::Record& r = records[index];
+        SpecRecordView view;
+        if (!text(r.name, view.name) || !text(r.model, view.model) || !text(r.chip, view.chip) ||
+            !text(r.version, view.version)) {
+            return std::nullopt;
+        }
+        return view;
+    }
+
+    // 按名字查找: 一次哈希，通常只探测一两个桶
+    std::optional<SpecRecordView> find(std::string_view name) const {
+        if (header == nullptr) {
+            return std::nullopt;
+        }
+        std::uint64_t hash = spec_catalog::hashName(name);
+        std::uint32_t mask = header->bucketCount - 1;
+        std::uint32_t tag = static_cast<std::uint32_t>(hash >> 32);
+        // 桶数大于记录数，所以一定会遇到空桶；仍然限制探测次数，防止损坏的文件造成死循环
+        for (std::uint32_t slot = static_cast<std::uint32_t>(hash) & mask, probes = 0; probes <= mask;
+             slot = (slot + 1) & mask, ++probes) {
+            const spec_catalog::Bucket& bucket = buckets[slot];
+            if (bucket.record == 0 || bucket.record > header->recordCount) {
+                return std::nullopt;
+            }
+            if (bucket.tag == tag) {
+                std::string_view candidate;
+                if (text(records[bucket.record - 1].name, candidate) && candidate == name) {
+                    return record(bucket.record - 1);
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    // 按 ProductModel 查找: 直接读型号索引
+    std::optional<SpecRecordView> find(ProductModel model) const {
+        std::size_t index = static_cast<std::size_t>(model);
+        if (header == nullptr || index >= header->modelCount) {
+            return std::nullopt;
+        }
+        std::uint32_t recordIndex = modelIndex[index];
+        if (recordIndex >= header->recordCount) {
+            return std::nullopt;
+        }
+        return record(recordIndex);
+    }
+
+private:
+    bool text(spec_catalog::StringRef ref, std::string_view& out) const {
+        if (ref.offset > strings.size() || ref.length > strings.size() - ref.offset) {
+            return false;
+        }
+        out = strings.substr(ref.offset, ref.length);
+        return true;
+    }
+
+    void swap(SpecCatalog& other) noexcept {
+        std::swap(mapped, other.mapped);
+        std::swap(mappedSize, other.mappedSize);
+        std::swap(header, other.header);
+        std::swap(records, other.records);
+        std::swap(buckets, other.buckets);
+        std::swap(modelIndex, other.modelIndex);
+        std::swap(strings, other.strings);
+    }
+
+    static bool fail(std::string* error, std::string message) {
+        if (error != nullptr) {
+            *error = std::move(message);
+        }
+        return false;
+    }
+
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+    const spec_catalog::Header* header = nullptr;
+    const spec_catalog::Record* records = nullptr;
+    const spec_catalog::Bucket* buckets = nullptr;
+    const std::uint32_t* modelIndex = nullptr;
+    std::string_view strings;
+};
+
+#endif // SPEC_CATALOG_H
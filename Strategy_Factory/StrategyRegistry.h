@@ -0,0 +1,281 @@
+// StrategyRegistry.h
+#ifndef STRATEGY_REGISTRY_H
+#define STRATEGY_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ProductSpecStrategy.h" // 策略接口和内置的具体策略
+
+// 可扩展的策略登记表:
+// 增加产品不需要修改 StrategyFactory 的 switch 和 ProductModel 枚举，策略在静态初始化 (或插件加载) 时
+// 把自己登记到 StrategyRegistry，之后按名字 (以及可选的 ProductModel) 查找。
+//  - 无状态的策略登记为单例: 只创建一次，所有查询共用同一个对象；
+//  - 有状态的策略登记为工厂函数: 每次查询创建一个新对象。
+// 读多写少，采用 RCU 的方式: 登记表的内容是一个不可修改的快照，登记新策略时复制一份、修改后原子地替换。
+// 每个线程缓存自己正在用的快照，只要版本号没变，查询就只有一次原子读，不加锁、也不修改任何共享的计数。
+// get / visit 在使用快照期间 (包括回调和工厂函数运行时) 把它固定在线程缓存中，
+// 所以回调里可以再次查询、登记或注销: 嵌套的查询看到的是同一个快照，回调返回后才换成新快照。
+
+/**
+ * @brief 规格在运行时才确定的策略 (来自配置文件、插件等)
+ */
+class FixedSpecStrategy : public IProductSpecStrategy {
+public:
+    explicit FixedSpecStrategy(std::string spec) : spec(std::move(spec)) {}
+
+    std::string get_spec_string() const override { return spec; }
+
+private:
+    std::string spec;
+};
+
+class StrategyRegistry {
+public:
+    using Creator = std::function<std::unique_ptr<IProductSpecStrategy>()>;
+
+    // 进程内唯一的登记表，永不销毁: 销毁它会释放插件策略并卸载共享库，而退出时其他静态对象可能还在查询
+    static StrategyRegistry& global() {
+        static StrategyRegistry* instance = new StrategyRegistry;
+        return *instance;
+    }
+
+    /**
+     * @brief 登记一个无状态的策略，所有查询共用这个对象。
+     * @param model 可选，同时允许按 ProductModel 查找
+     * @return 名字 (或型号) 已被占用时返回 false，登记表不变
+     */
+    bool addSingleton(std::string name, std::shared_ptr<const IProductSpecStrategy> instance,
+                      std::optional<ProductModel> model = std::nullopt) {
+        auto entry = std::make_shared<Entry>();
+        entry->name = std::move(name);
+        entry->instance = std::move(instance);
+        entry->model = model;
+        return add(std::move(entry));
+    }
+
+    template <class Strategy>
+    bool addSingleton(std::string name, std::optional<ProductModel> model = std::nullopt) {
+        return addSingleton(std::move(name), std::make_shared<const Strategy>(), model);
+    }
+
+    /**
+     * @brief 登记一个有状态的策略，每次查询都调用 create 创建新对象。
+     * @return 名字 (或型号) 已被占用时返回 false，登记表不变
+     */
+    bool addFactory(std::string name, Creator create, std::optional<ProductModel> model = std::nullopt) {
+        auto entry = std::make_shared<Entry>();
+        entry->name = std::move(name);
+        entry->create = std::move(create);
+        entry->model = model;
+        return add(std::move(entry));
+    }
+
+    /**
+     * @brief 注销策略 (例如插件卸载前)。
+     * 已经通过 get() 取得的单例仍然有效，直到最后一个 shared_ptr 释放。
+     */
+    bool remove(std::string_view name) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::shared_ptr<const Snapshot> old = current.load(std::memory_order_relaxed);
+        auto it = old->byName.find(name);
+        if (it == old->byName.end()) {
+            return false;
+        }
+        auto next = std::make_shared<Snapshot>(*old);
+        if (it->second->model) {
+            next->byModel[static_cast<std::size_t>(*it->second->model)] = nullptr;
+        }
+        next->byName.erase(next->byName.find(name));
+        publish(std::move(next));
+        return true;
+    }
+
+    /**
+     * @brief 按名字取得策略。单例直接返回共享的对象，工厂则创建一个新对象。
+     * @return 没有登记时返回 nullptr
+     */
+    std::shared_ptr<const IProductSpecStrategy> get(std::string_view name) const {
+        Pin snapshot(*this);
+        auto it = snapshot->byName.find(name);
+        return it == snapshot->byName.end() ? nullptr : it->second->get();
+    }
+
+    std::shared_ptr<const IProductSpecStrategy> get(ProductModel model) const {
+        Pin snapshot(*this);
+        const Entry* entry = snapshot->find(model);
+        return entry ? entry->get() : nullptr;
+    }
+
+    /**
+     * @brief 对策略调用 f(const IProductSpecStrategy&)，适合频繁查询:
+     * 单例不拷贝 shared_ptr，所以多个线程同时查询同一个策略时也不会争用引用计数。
+     * @return 没有登记时返回 false，不调用 f
+     */
+    template <class F>
+    bool visit(std::string_view name, F&& f) const {
+        Pin snapshot(*this);
+        auto it = snapshot->byName.find(name);
+        if (it == snapshot->byName.end()) {
+            return false;
+        }
+        it->second->visit(f);
+        return true;
+    }
+
+    template <class F>
+    bool visit(ProductModel model, F&& f) const {
+        Pin snapshot(*this);
+        const Entry* entry = snapshot->find(model);
+        if (entry == nullptr) {
+            return false;
+        }
+        entry->visit(f);
+        return true;
+    }
+
+    // 所有登记过的名字 (顺序不确定)
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        Pin snapshot(*this);
+        for (const auto& [name, entry] : snapshot->byName) {
+            result.push_back(name);
+        }
+        return result;
+    }
+
+    // 每次登记或注销都会加一
+    std::uint64_t version() const { return currentVersion.load(std::memory_order_acquire); }
+
+private:
+    struct Entry {
+        std::string name;
+        std::optional<ProductModel> model;
+        std::shared_ptr<const IProductSpecStrategy> instance; // 单例
+        Creator create;                                       // 没有单例时使用
+
+        std::shared_ptr<const IProductSpecStrategy> get() const {
+            return instance ? instance : std::shared_ptr<const IProductSpecStrategy>(create());
+        }
+
+        template <class F>
+        void visit(F& f) const {
+            if (instance) {
+                f(*instance);
+            } else {
+                std::unique_ptr<IProductSpecStrategy> created = create();
+                f(*created);
+            }
+        }
+    };
+
+    // 透明的哈希: 用 string_view 查找时不需要构造 std::string
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    // 登记表的一个版本，发布之后不再修改
+    struct Snapshot {
+        std::unordered_map<std::string, std::shared_ptr<const Entry>, NameHash, std::equal_to<>> byName;
+        std::array<std::shared_ptr<const Entry>, kProductModelCount> byModel{};
+
+        const Entry* find(ProductModel model) const {
+            std::size_t index = static_cast<std::size_t>(model);
+            return index < byModel.size() ? byModel[index].get() : nullptr;
+        }
+    };
+
+    // 每个线程缓存的快照
+    struct ReaderCache {
+        std::uint64_t version = ~std::uint64_t{0};
+        std::shared_ptr<const Snapshot> snapshot;
+        unsigned pinned = 0; // 正在使用缓存快照的 get / visit 的嵌套层数
+    };
+
+    // 读者取得当前快照并在析构前固定它: 版本号没变时直接用线程缓存的快照，
+    // 外层还在使用时 (pinned > 0) 即使版本号变了也不替换，否则会释放外层正在使用的 Entry 和单例
+    class Pin {
+    public:
+        explicit Pin(const StrategyRegistry& registry) : cache(readerCache()) {
+            std::uint64_t latest = registry.currentVersion.load(std::memory_order_acquire);
+            if (latest != cache.version && cache.pinned == 0) {
+                // 先读版本号再读快照: 读到的快照至少和版本号一样新，最多在下次查询时多刷新一次
+                cache.snapshot = registry.current.load(std::memory_order_acquire);
+                cache.version = latest;
+            }
+            ++cache.pinned;
+        }
+        ~Pin() { --cache.pinned; }
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        const Snapshot* operator->() const { return cache.snapshot.get(); }
+
+    private:
+        ReaderCache& cache;
+    };
+
+    // 登记表只有 global() 一个实例，所以每个线程一份缓存就够了
+    static ReaderCache& readerCache() {
+        thread_local ReaderCache cache;
+        return cache;
+    }
+
+    StrategyRegistry() : current(std::make_shared<const Snapshot>()) {}
+
+    bool add(std::shared_ptr<Entry> entry) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        std::shared_ptr<const Snapshot> old = current.load(std::memory_order_relaxed);
+        if (old->byName.count(entry->name) != 0 || (entry->model && old->find(*entry->model) != nullptr)) {
+            return false;
+        }
+        auto next = std::make_shared<Snapshot>(*old);
+        if (entry->model) {
+            next->byModel[static_cast<std::size_t>(*entry->model)] = entry;
+        }
+        std::string name = entry->name;
+        next->byName.emplace(std::move(name), std::move(entry));
+        publish(std::move(next));
+        return true;
+    }
+
+    // 先替换快照再增加版本号 (只在持有 writeMutex 时调用)
+    void publish(std::shared_ptr<const Snapshot> next) {
+        current.store(std::move(next), std::memory_order_release);
+        currentVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    std::mutex writeMutex;
+    std::atomic<std::shared_ptr<const Snapshot>> current;
+    std::atomic<std::uint64_t> currentVersion{0};
+};
+
+/**
+ * @brief 自动登记: 定义一个该类型的静态变量，程序启动 (或插件加载) 时就把策略登记为单例。
+ * 例: inline const RegisterStrategy<MyStrategy> registerMine{"mine"};
+ */
+template <class Strategy>
+struct RegisterStrategy {
+    explicit RegisterStrategy(std::string name, std::optional<ProductModel> model = std::nullopt) {
+        StrategyRegistry::global().addSingleton<Strategy>(std::move(name), model);
+    }
+};
+
+// 内置的策略。inline 变量在整个程序中只初始化一次，无论这个头文件被包含多少次
+inline const RegisterStrategy<Xiaomi15Strategy> registerXiaomi15{"xiaomi15", ProductModel::Xiaomi15};
+inline const RegisterStrategy<Xiaomi14Strategy> registerXiaomi14{"xiaomi14", ProductModel::Xiaomi14};
+inline const RegisterStrategy<Su7UltraStrategy> registerSu7Ultra{"su7ultra", ProductModel::Su7Ultra};
+
+#endif // STRATEGY_REGISTRY_H
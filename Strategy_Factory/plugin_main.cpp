@@ -0,0 +1,49 @@
+// plugin_main.cpp (从共享库按需加载产品规格)
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "PluginLoader.h" // 按需加载插件并登记到 StrategyRegistry
+
+// 先编译示例插件，再编译主程序:
+// gcc -shared -fPIC -O2 plugins/xiaomi17_plugin.c -o plugins/libspec_xiaomi17.so
+// g++ plugin_main.cpp -o plugin_main -std=c++20 -O2 -pthread -ldl
+// 用法: ./plugin_main [插件目录] (默认 plugins)
+
+int main(int argc, char* argv[]) {
+    PluginLoader loader(argc > 1 ? argv[1] : "plugins");
+
+    // 启动时只列出目录，不加载任何插件
+    std::cout << "可用的插件:";
+    for (const std::string& name : loader.available()) {
+        std::cout << ' ' << name;
+    }
+    std::cout << "\n已加载 " << loader.loadedCount() << " 个插件\n";
+
+    // 内置产品直接从登记表中取得，不会触发加载
+    std::cout << "xiaomi15 -> " << loader.get("xiaomi15")->get_spec_string() << '\n';
+
+    // 第一次查询 xiaomi17 时才加载插件，之后的查询直接用登记表中的单例
+    for (int i = 0; i < 2; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        auto strategy = loader.get("xiaomi17");
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (!strategy) {
+            std::cerr << "错误：找不到 xiaomi17 插件 (先按文件开头的命令编译它)" << std::endl;
+            return 1;
+        }
+        std::cout << "xiaomi17 -> " << strategy->get_spec_string() << " (" << micros << " 微秒, 已加载 "
+                  << loader.loadedCount() << " 个插件)\n";
+    }
+
+    // 没有对应插件的产品
+    std::string error;
+    if (!loader.load("xiaomi99", &error)) {
+        std::cout << "xiaomi99: " << error << '\n';
+    }
+
+    // 卸载后再次查询会重新加载 (例如换上新版本的插件)
+    loader.unload("xiaomi17");
+    std::cout << "卸载后已加载 " << loader.loadedCount() << " 个插件\n";
+    std::cout << "xiaomi17 -> " << loader.get("xiaomi17")->get_spec_string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,17 @@
+/* xiaomi17_plugin.c (一个产品规格插件的例子) */
+/* gcc -shared -fPIC -O2 xiaomi17_plugin.c -o libspec_xiaomi17.so */
+#include "../ProductSpecPlugin.h"
+
+static const char* get_spec(void) {
+    return "xiaomi17:8elite3";
+}
+
+static const ProductSpecPluginInfo info = {
+    PRODUCT_SPEC_PLUGIN_ABI_VERSION,
+    "xiaomi17",
+    get_spec,
+};
+
+__attribute__((visibility("default"))) const ProductSpecPluginInfo* product_spec_plugin_info(void) {
+    return &info;
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "StrategyRegistry.h"
+
+// g++ registry_bench.cpp -o registry_bench -std=c++20 -O2 -pthread
+// 用法: ./registry_bench [读线程数] [每个线程的查询次数]
+// 多个线程按名字随机查询规格，同时一个写线程每毫秒登记一个新产品。比较:
+//  - StrategyRegistry::visit (RCU 快照，读者不加锁)；
+//  - StrategyRegistry::get   (同上，但每次拷贝 shared_ptr，多个线程争用同一个引用计数)；
+//  - 用 std::shared_mutex 保护的 unordered_map (读者加共享锁)。
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 对照组: 读写锁保护的登记表
+class LockedRegistry {
+public:
+    void add(std::string name, std::shared_ptr<const IProductSpecStrategy> strategy) {
+        std::unique_lock lock(mutex);
+        strategies.emplace(std::move(name), std::move(strategy));
+    }
+
+    template <class F>
+    bool visit(const std::string& name, F&& f) const {
+        std::shared_lock lock(mutex);
+        auto it = strategies.find(name);
+        if (it == strategies.end()) {
+            return false;
+        }
+        f(*it->second);
+        return true;
+    }
+
+private:
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const IProductSpecStrategy>> strategies;
+};
+
+// readers 个线程各查询 n 次，同时 addProduct 每毫秒登记一个新产品。返回每秒查询次数
+template <class Lookup, class AddProduct>
+static double run(const std::vector<std::string>& names, unsigned readers, std::size_t n,
+                  Lookup&& lookup, AddProduct&& addProduct) {
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> checksum{0};
+    std::thread writer([&] {
+        for (int i = 0; !done.load(std::memory_order_relaxed); ++i) {
+            addProduct(i);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < readers; ++t) {
+        threads.emplace_back([&, t] {
+            std::uint64_t state = 0x9E3779B97F4A7C15ull + t;
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += lookup(names[nextRandom(state) % names.size()]);
+            }
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true, std::memory_order_relaxed);
+    writer.join();
+    if (checksum.load() == 0) {
+        std::cerr << "查询结果为空!" << std::endl;
+    }
+    return static_cast<double>(readers) * n / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned readers = argc > 1 ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10))
+                                : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t n = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    if (readers == 0 || n == 0) {
+        std::cerr << "参数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    // 查询的名字: 内置的三个产品加上 100 个运行时登记的产品
+    std::vector<std::string> names = {"xiaomi15", "xiaomi14", "su7ultra"};
+    LockedRegistry locked;
+    for (const std::string& name : names) {
+        locked.add(name, StrategyRegistry::global().get(name));
+    }
+    for (int i = 0; i < 100; ++i) {
+        std::string name = "product" + std::to_string(i);
+        auto strategy = std::make_shared<const FixedSpecStrategy>(name + ":spec");
+        StrategyRegistry::global().addSingleton(name, strategy);
+        locked.add(name, strategy);
+        names.push_back(name);
+    }
+    std::cout << readers << " 个读线程, 每个线程查询 " << n << " 次\n";
+
+    auto specLength = [](const IProductSpecStrategy& strategy) { return strategy.get_spec_string().size(); };
+
+    double visit = run(names, readers, n,
+        [&](const std::string& name) {
+            std::uint64_t length = 0;
+            StrategyRegistry::global().visit(name, [&](const IProductSpecStrategy& s) { length = specLength(s); });
+            return length;
+        },
+        [](int i) {
+            std::string name = "visit-new" + std::to_string(i);
+            StrategyRegistry::global().addSingleton(name, std::make_shared<const FixedSpecStrategy>("new"));
+        });
+    std::cout << "RCU visit: " << visit / 1e6 << " M 次/秒\n";
+
+    double get = run(names, readers, n,
+        [&](const std::string& name) -> std::uint64_t {
+            std::shared_ptr<const IProductSpecStrategy> strategy = StrategyRegistry::global().get(name);
+            return strategy ? specLength(*strategy) : 0;
+        },
+        [](int i) {
+            std::string name = "get-new" + std::to_string(i);
+            StrategyRegistry::global().addSingleton(name, std::make_shared<const FixedSpecStrategy>("new"));
+        });
+    std::cout << "RCU get: " << get / 1e6 << " M 次/秒\n";
+
+    double shared = run(names, readers, n,
+        [&](const std::string& name) {
+            std::uint64_t length = 0;
+            locked.visit(name, [&](const IProductSpecStrategy& s) { length = specLength(s); });
+            return length;
+        },
+        [&](int i) { locked.add("locked-new" + std::to_string(i), std::make_shared<const FixedSpecStrategy>("new")); });
+    std::cout << "shared_mutex: " << shared / 1e6 << " M 次/秒\n";
+    std::cout << "登记表版本: " << StrategyRegistry::global().version() << std::endl;
+    return 0;
+}
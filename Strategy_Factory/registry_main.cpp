@@ -0,0 +1,65 @@
+// registry_main.cpp (可扩展的策略登记表)
+#include <iostream>
+#include <memory>
+#include <string>
+#include "StrategyRegistry.h" // 策略登记表，内置的三个策略已经自动登记
+
+// g++ registry_main.cpp -o registry_main -std=c++20 -O2 -pthread
+
+// 一个新产品: 不需要修改 ProductModel 枚举，也不需要修改 StrategyFactory 的 switch，
+// 定义策略后用一个静态变量把它登记进去即可 (程序启动时自动完成)
+class Xiaomi16Strategy : public IProductSpecStrategy {
+public:
+    std::string get_spec_string() const override { return "xiaomi16:8elite2"; }
+};
+
+static const RegisterStrategy<Xiaomi16Strategy> registerXiaomi16{"xiaomi16"};
+
+// 有状态的策略: 每次查询都要一个新对象，所以登记为工厂函数
+class CountingStrategy : public IProductSpecStrategy {
+public:
+    std::string get_spec_string() const override { return "prototype #" + std::to_string(++uses); }
+
+private:
+    mutable int uses = 0;
+};
+
+void printProductSpec(const std::string& name) {
+    // 通过名字查找，找不到时 visit 返回 false
+    bool found = StrategyRegistry::global().visit(name, [&](const IProductSpecStrategy& strategy) {
+        std::cout << name << " -> " << strategy.get_spec_string() << std::endl;
+    });
+    if (!found) {
+        std::cerr << "错误：未知的产品 " << name << "！" << std::endl;
+    }
+}
+
+int main() {
+    StrategyRegistry& registry = StrategyRegistry::global();
+
+    // 内置产品和自动登记的新产品
+    printProductSpec("xiaomi15");
+    printProductSpec("xiaomi16");
+
+    // 也可以按枚举查找内置产品
+    std::cout << "Su7Ultra -> " << registry.get(ProductModel::Su7Ultra)->get_spec_string() << std::endl;
+
+    // 运行时登记: 规格来自配置等外部数据
+    registry.addSingleton("yu7", std::make_shared<const FixedSpecStrategy>("yu7:v6s"));
+    registry.addFactory("prototype", [] { return std::make_unique<CountingStrategy>(); });
+    printProductSpec("yu7");
+    printProductSpec("prototype");
+    printProductSpec("prototype"); // 工厂每次创建新对象，所以还是 #1
+
+    // 单例: 两次查询得到同一个对象
+    std::cout << "单例是否为同一个对象: " << (registry.get("xiaomi14") == registry.get("xiaomi14") ? "是" : "否") << std::endl;
+
+    // 名字已被占用时登记失败
+    if (!registry.addSingleton<Xiaomi16Strategy>("xiaomi15")) {
+        std::cout << "xiaomi15 已经登记过了" << std::endl;
+    }
+
+    registry.remove("yu7");
+    printProductSpec("yu7");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "SpecCatalog.h"
+
+// g++ spec_catalog_bench.cpp -o spec_catalog_bench -std=c++20 -O2
+// 用法: ./spec_catalog_bench [产品数] [目录文件路径]
+// 生成一个包含内置三个产品和 N 个随机产品的目录文件，然后测量:
+// 打开 (mmap) 的耗时、按名字 / 按 ProductModel 查找的 ns/次 和每次查找的堆分配次数。
+
+// 统计堆分配次数: 替换全局的 operator new / delete
+static std::uint64_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <class F>
+static double seconds(F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::string path = argc > 2 ? argv[2] : "spec_catalog.bin";
+
+    std::vector<std::string> names;
+    double build = seconds([&] {
+        SpecCatalogWriter writer;
+        writer.add("xiaomi15", "Xiaomi 15", "8elite", "2024", ProductModel::Xiaomi15);
+        writer.add("xiaomi14", "Xiaomi 14", "8gen3", "2023", ProductModel::Xiaomi14);
+        writer.add("su7ultra", "SU7 Ultra", "v8s", "2025", ProductModel::Su7Ultra);
+        static const char* chips[] = {"8elite", "8gen3", "8gen2", "d9400", "a18pro", "xring-o1"};
+        for (std::size_t i = 0; i < n; ++i) {
+            names.push_back("product-" + std::to_string(i));
+            writer.add(names.back(), "Model " + std::to_string(i % 5000), chips[i % 6], std::to_string(2015 + i % 11));
+        }
+        std::string error;
+        if (!writer.write(path, &error)) {
+            std::cerr << error << std::endl;
+            std::exit(1);
+        }
+    });
+
+    SpecCatalog catalog;
+    std::string error;
+    double open = seconds([&] {
+        if (!catalog.open(path, &error)) {
+            std::cerr << error << std::endl;
+            std::exit(1);
+        }
+    });
+    std::cout << catalog.size() << " 条记录, 生成并写入 " << build << " 秒, 打开 " << open * 1e6 << " 微秒\n";
+
+    // 按 ProductModel 查找内置产品
+    for (ProductModel model : {ProductModel::Xiaomi15, ProductModel::Xiaomi14, ProductModel::Su7Ultra}) {
+        if (auto spec = catalog.find(model)) {
+            std::cout << "  " << spec->name << ": " << spec->model << ", 芯片 " << spec->chip << ", " << spec->version
+                      << " (" << spec->specString() << ")\n";
+        }
+    }
+
+    // 按名字随机查找 (第一轮会把用到的页面读入内存)
+    const std::size_t lookups = 5000000;
+    std::vector<std::uint32_t> order(lookups);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (std::uint32_t& i : order) {
+        i = static_cast<std::uint32_t>(nextRandom(state) % n);
+    }
+    for (int round = 0; round < 2; ++round) {
+        std::uint64_t found = 0;
+        std::uint64_t checksum = 0;
+        std::uint64_t allocationsBefore = allocationCount;
+        double time = seconds([&] {
+            for (std::uint32_t i : order) {
+                if (auto spec = catalog.find(names[i])) {
+                    ++found;
+                    checksum += spec->chip.size();
+                }
+            }
+        });
+        std::cout << (round == 0 ? "按名字查找 (冷)" : "按名字查找 (热)") << ": " << time * 1e9 / lookups << " ns/次, 找到 "
+                  << found << "/" << lookups << ", 每次分配 "
+                  << static_cast<double>(allocationCount - allocationsBefore) / lookups << " 次 (" << checksum << ")\n";
+    }
+
+    std::uint64_t missing = 0;
+    std::uint64_t allocationsBefore = allocationCount;
+    double time = seconds([&] {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            missing += !catalog.find(ProductModel::Xiaomi14) ? 0 : catalog.find(std::string_view("no-such-product")) ? 0 : 1;
+        }
+    });
+    std::cout << "按型号查找 + 查找不存在的名字: " << time * 1e9 / lookups << " ns/次, 每次分配 "
+              << static_cast<double>(allocationCount - allocationsBefore) / lookups << " 次 (" << missing << ")\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <vector>
+#include "ProductSpecStrategy.h"
+
+// g++ strategy_bench.cpp -o strategy_bench -std=c++20 -O2
+// 用法: ./strategy_bench [查询次数]
+// 对随机的型号序列查询规格，比较四种做法的 ns/次 和每次查询的堆分配次数:
+//  - 虚函数 (每次 new): StrategyFactory::createStrategy 每次创建策略对象，再调用 get_spec_string()；
+//  - 虚函数 (复用实例): 每个型号只创建一次策略对象，只剩虚函数调用和返回 std::string 的开销；
+//  - variant: StrategyFactory::selectStrategy + std::visit；
+//  - constexpr 表: StrategyFactory::specOf。
+
+// 统计堆分配次数: 替换全局的 operator new / delete
+static std::uint64_t allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// 对每个型号执行 lookup，汇总规格的长度和首字符 (防止编译器把查询优化掉)
+template <class Lookup>
+static void measure(const char* name, const std::vector<ProductModel>& models, Lookup&& lookup) {
+    std::uint64_t checksum = 0;
+    std::uint64_t allocationsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (ProductModel model : models) {
+        checksum += lookup(model);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::uint64_t allocations = allocationCount - allocationsBefore;
+    std::cout << name << ": " << seconds * 1e9 / models.size() << " ns/次, 每次查询分配 "
+              << static_cast<double>(allocations) / models.size() << " 次 (校验和 " << checksum << ")\n";
+}
+
+static std::uint64_t digest(std::string_view spec) {
+    return spec.size() + static_cast<unsigned char>(spec.empty() ? 0 : spec[0]);
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    if (n == 0) {
+        std::cerr << "查询次数必须为正数。" << std::endl;
+        return 1;
+    }
+
+    std::vector<ProductModel> models(n);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (ProductModel& model : models) {
+        model = static_cast<ProductModel>(nextRandom(state) % kProductModelCount);
+    }
+    std::cout << n << " 次查询, " << kProductModelCount << " 种型号\n";
+
+    measure("虚函数 (每次 new)", models, [](ProductModel model) -> std::uint64_t {
+        std::unique_ptr<IProductSpecStrategy> strategy = StrategyFactory::createStrategy(model);
+        return strategy ? digest(strategy->get_spec_string()) : 0;
+    });
+
+    std::array<std::unique_ptr<IProductSpecStrategy>, kProductModelCount> cached;
+    for (std::size_t i = 0; i < kProductModelCount; ++i) {
+        cached[i] = StrategyFactory::createStrategy(static_cast<ProductModel>(i));
+    }
+    measure("虚函数 (复用实例)", models, [&](ProductModel model) -> std::uint64_t {
+        return digest(cached[static_cast<std::size_t>(model)]->get_spec_string());
+    });
+
+    measure("variant", models, [](ProductModel model) -> std::uint64_t {
+        auto strategy = StrategyFactory::selectStrategy(model);
+        return strategy ? digest(product_spec::spec(*strategy)) : 0;
+    });
+
+    measure("constexpr 表", models, [](ProductModel model) -> std::uint64_t {
+        return digest(StrategyFactory::specOf(model));
+    });
+    return 0;
+}
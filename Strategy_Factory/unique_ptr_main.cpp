@@ -2,87 +2,15 @@
 #include <iostream>
 #include <string>
 #include <memory>
-#include "ProductModel.h" // 包含更新后的枚举头文件
-
-// ===================================================================
-// I. 策略模式 (Strategy Pattern)
-// ===================================================================
-
-/**
- * @brief 策略接口 (The Strategy Interface)
- * * 定义了一个所有产品规格“策略”都必须实现的通用接口。
- */
-class IProductSpecStrategy {
-public:
-    virtual ~IProductSpecStrategy() = default;
-
-    // 纯虚函数，任何具体的产品策略都必须提供自己的规格信息。
-    virtual std::string get_spec_string() const = 0;
-};
-
-/**
- * @brief 具体策略A：小米15的规格
- */
-class Xiaomi15Strategy : public IProductSpecStrategy {
-public:
-    std::string get_spec_string() const override {
-        return "xiaomi15:8elite";
-    }
-};
-
-/**
- * @brief 具体策略B：小米14的规格
- */
-class Xiaomi14Strategy : public IProductSpecStrategy {
-public:
-    std::string get_spec_string() const override {
-        return "xiaomi14:8gen3";
-    }
-};
-
-/**
- * @brief 具体策略C：SU7 Ultra的规格
- */
-class Su7UltraStrategy : public IProductSpecStrategy {
-public:
-    std::string get_spec_string() const override {
-        return "su7ultra:v8s";
-    }
-};
+#include <string_view>
+#include <variant>
+#include "ProductSpecStrategy.h" // 策略接口、具体策略和策略工厂
 
+// 策略接口、具体策略和工厂都在 ProductSpecStrategy.h 中，
+// 除了下面用到的运行时多态版本，还有不分配内存的编译期分派版本 (product_spec 命名空间)。
 
 // ===================================================================
-// II. 工厂模式 (Factory Pattern)
-// ===================================================================
-
-/**
- * @brief 策略工厂 (The Strategy Factory)
- * * 它的职责是根据请求的产品型号，创建对应的规格策略实例。
- */
-class StrategyFactory {
-public:
-    /**
-     * @brief 创建一个产品规格策略实例。
-     * @param model 我们从枚举中选择的产品型号。
-     * @return 返回一个指向策略接口的智能指针。
-     */
-    static std::unique_ptr<IProductSpecStrategy> createStrategy(ProductModel model) {
-        switch (model) {
-            case ProductModel::Xiaomi15:
-                return std::make_unique<Xiaomi15Strategy>();
-            case ProductModel::Xiaomi14:
-                return std::make_unique<Xiaomi14Strategy>();
-            case ProductModel::Su7Ultra:
-                return std::make_unique<Su7UltraStrategy>();
-            default:
-                return nullptr;
-        }
-    }
-};
-
-
-// ===================================================================
-// III. 客户端代码 (Client Code)
+// 客户端代码 (Client Code)
 // ===================================================================
 
 /*
@@ -115,6 +43,13 @@ void printProductSpec(ProductModel model) {
     }
 }
 
+// 编译期分派: 策略按值保存在 variant 中，std::visit 调用的是各个策略自己的 spec()，没有 new 也没有虚函数
+void printProductSpecStatic(ProductModel model) {
+    if (auto strategy = StrategyFactory::selectStrategy(model)) {
+        std::cout << product_spec::spec(*strategy) << std::endl;
+    }
+}
+
 int main() {
     // 客户端代码现在可以轻松地查询不同产品的规格。
     
@@ -124,5 +59,12 @@ int main() {
     
     printProductSpec(ProductModel::Su7Ultra);
 
+    // 同样的查询，换成编译期分派的版本
+    printProductSpecStatic(ProductModel::Xiaomi15);
+
+    // 只需要规格字符串时直接查表，结果甚至可以在编译期算出来
+    constexpr std::string_view su7 = StrategyFactory::specOf(ProductModel::Su7Ultra);
+    std::cout << su7 << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+// Book.h
+#ifndef STRUCTURE_BOOK_H
+#define STRUCTURE_BOOK_H
+
+#include <string>
+
+// 与 book_array.cpp / book_ini.cpp 中相同的书籍结构体，供 BookCatalog 等模块共用
+struct Book
+{
+    std::string title;
+    int pages;
+    double price;
+};
+
+#endif // STRUCTURE_BOOK_H
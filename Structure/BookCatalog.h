@@ -0,0 +1,315 @@
+// BookCatalog.h
+#ifndef BOOK_CATALOG_H
+#define BOOK_CATALOG_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Book.h"
+
+// 书名池: 相同的书名只保存一份，所有字符都放在按块分配的内存 (arena) 里。
+// 块一旦分配就不会移动，所以返回的 string_view 在 TitleArena 存活期间一直有效。
+class TitleArena {
+public:
+    // 返回书名的编号，相同的书名得到相同的编号
+    std::uint32_t intern(std::string_view title) {
+        auto it = ids.find(title);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        std::string_view stored = store(title);
+        std::uint32_t id = static_cast<std::uint32_t>(titles.size());
+        titles.push_back(stored);
+        ids.emplace(stored, id);
+        return id;
+    }
+
+    std::string_view get(std::uint32_t id) const { return titles[id]; }
+    std::size_t uniqueCount() const { return titles.size(); }
+
+    // arena 占用的字节数 (不含哈希表)
+    std::size_t bytesUsed() const { return blocks.size() * kBlockSize + largeBytes; }
+
+private:
+    static constexpr std::size_t kBlockSize = 1 << 20;
+
+    std::string_view store(std::string_view title) {
+        if (title.size() > kBlockSize / 4) {
+            // 特别长的书名单独分配，不占用当前块
+            largeTitles.push_back(std::make_unique<char[]>(title.size()));
+            largeBytes += title.size();
+            std::memcpy(largeTitles.back().get(), title.data(), title.size());
+            return std::string_view(largeTitles.back().get(), title.size());
+        }
+        if (blocks.empty() || used + title.size() > kBlockSize) {
+            blocks.push_back(std::make_unique<char[]>(kBlockSize));
+            used = 0;
+        }
+        char* destination = blocks.back().get() + used;
+        std::memcpy(destination, title.data(), title.size());
+        used += title.size();
+        return std::string_view(destination, title.size());
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<std::unique_ptr<char[]>> largeTitles;
+    std::size_t used = 0;
+    std::size_t largeBytes = 0;
+    std::vector<std::string_view> titles;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+};
+
+// 查询条件: price 在 [minPrice, maxPrice) 之间，pages 在 [minPages, maxPages] 之间。
+// 例如 "price < X and pages > Y" 写作 BookFilter{.maxPrice = X, .minPages = Y + 1}。
+struct BookFilter
+{
+    double minPrice = -std::numeric_limits<double>::infinity();
+    double maxPrice = std::numeric_limits<double>::infinity();
+    int minPages = std::numeric_limits<int>::min();
+    int maxPages = std::numeric_limits<int>::max();
+};
+
+// 聚合结果
+struct BookStats
+{
+    std::size_t count = 0;
+    double sumPrice = 0.0;
+    double minPrice = std::numeric_limits<double>::infinity();
+    double maxPrice = -std::numeric_limits<double>::infinity();
+    std::int64_t sumPages = 0;
+    int minPages = std::numeric_limits<int>::max();
+    int maxPages = std::numeric_limits<int>::min();
+
+    double avgPrice() const { return count == 0 ? 0.0 : sumPrice / static_cast<double>(count); }
+    double avgPages() const { return count == 0 ? 0.0 : static_cast<double>(sumPages) / static_cast<double>(count); }
+};
+
+// === BookCatalog (列式书目) ===
+// std::vector<Book> 把每本书的 title/pages/price 放在一起 (AoS)，扫描 price 时
+// 也要把 title 的 32 字节一起读进缓存。BookCatalog 把每个字段放在单独的数组里 (SoA)：
+// 扫描 price/pages 只读这两列，而且循环是连续的、没有分支的，编译器可以自动向量化
+// (建议用 -O3 -march=native 编译以使用 AVX2/AVX-512)。
+class BookCatalog
+{
+public:
+    // 选择向量: 满足条件的行号，按升序排列
+    using Selection = std::vector<std::uint32_t>;
+
+    void reserve(std::size_t count)
+    {
+        titleIds.reserve(count);
+        pageColumn.reserve(count);
+        priceColumn.reserve(count);
+    }
+
+    // 追加一本书，返回它的行号
+    std::uint32_t add(std::string_view title, int pages, double price)
+    {
+        titleIds.push_back(arena.intern(title));
+        pageColumn.push_back(pages);
+        priceColumn.push_back(price);
+        return static_cast<std::uint32_t>(pageColumn.size() - 1);
+    }
+
+    std::uint32_t add(const Book& book) { return add(book.title, book.pages, book.price); }
+
+    std::size_t size() const { return pageColumn.size(); }
+
+    std::string_view title(std::size_t row) const { return arena.get(titleIds[row]); }
+    int pages(std::size_t row) const { return pageColumn[row]; }
+    double price(std::size_t row) const { return priceColumn[row]; }
+    Book book(std::size_t row) const { return Book{std::string(title(row)), pages(row), price(row)}; }
+
+    std::span<const int> pagesColumn() const { return pageColumn; }
+    std::span<const double> pricesColumn() const { return priceColumn; }
+    const TitleArena& titles() const { return arena; }
+
+    // 统计满足条件的行数: 纯向量化循环，不生成选择向量
+    std::size_t count(const BookFilter& filter) const
+    {
+        const double* prices = priceColumn.data();
+        const int* pages = pageColumn.data();
+        std::size_t n = size();
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total += matches(filter, prices[i], pages[i]);
+        }
+        return total;
+    }
+
+    // 生成选择向量。按块处理: 先用向量化循环算出每行是否匹配 (0/1)，
+    // 再用无分支的方式把匹配的行号压缩到结果里。
+    Selection select(const BookFilter& filter) const
+    {
+        Selection selection;
+        std::size_t n = size();
+        selection.resize(n);
+        std::uint32_t* out = selection.data();
+        std::size_t found = 0;
+        unsigned char mask[kBlockRows];
+        for (std::size_t base = 0; base < n; base += kBlockRows) {
+            std::size_t rows = std::min(kBlockRows, n - base);
+            const double* prices = priceColumn.data() + base;
+            const int* pages = pageColumn.data() + base;
+            for (std::size_t i = 0; i < rows; ++i) {
+                mask[i] = matches(filter, prices[i], pages[i]);
+            }
+            for (std::size_t i = 0; i < rows; ++i) {
+                out[found] = static_cast<std::uint32_t>(base + i);
+                found += mask[i];
+            }
+        }
+        selection.resize(found);
+        return selection;
+    }
+
+    // 在已有的选择向量上继续过滤 (多个条件串联)
+    Selection refine(const Selection& input, const BookFilter& filter) const
+    {
+        Selection selection(input.size());
+        std::size_t found = 0;
+        for (std::uint32_t row : input) {
+            selection[found] = row;
+            found += matches(filter, priceColumn[row], pageColumn[row]);
+        }
+        selection.resize(found);
+        return selection;
+    }
+
+    // 整张表的聚合
+    BookStats aggregate() const { return accumulate<false>(BookFilter{}); }
+
+    // 只聚合选择向量中的行
+    BookStats aggregate(const Selection& selection) const
+    {
+        BookStats stats;
+        stats.count = selection.size();
+        for (std::uint32_t row : selection) {
+            double price = priceColumn[row];
+            int pages = pageColumn[row];
+            stats.sumPrice += price;
+            stats.minPrice = std::min(stats.minPrice, price);
+            stats.maxPrice = std::max(stats.maxPrice, price);
+            stats.sumPages += pages;
+            stats.minPages = std::min(stats.minPages, pages);
+            stats.maxPages = std::max(stats.maxPages, pages);
+        }
+        return stats;
+    }
+
+    // 直接对满足条件的行做聚合，不生成选择向量
+    BookStats aggregate(const BookFilter& filter) const { return accumulate<true>(filter); }
+
+private:
+    static constexpr std::size_t kBlockRows = 1024;
+
+    // 用 & 而不是 &&，避免短路求值产生分支
+    static bool matches(const BookFilter& filter, double price, int pages)
+    {
+        return (price >= filter.minPrice) & (price < filter.maxPrice)
+             & (pages >= filter.minPages) & (pages <= filter.maxPages);
+    }
+
+    // GCC/Clang 的向量扩展: 一个变量保存 8 个 double / int64，运算符直接作用于每个分量，
+    // 编译器按目标指令集生成 AVX-512、AVX2 或 SSE2 指令。
+    typedef double DoubleLanes __attribute__((vector_size(64)));
+    typedef std::int64_t MaskLanes __attribute__((vector_size(64)));
+    typedef int IntLanes __attribute__((vector_size(32)));
+
+    // 8 路并行累加 (显式 SIMD)。浮点加法不满足结合律，普通循环里编译器不会自动向量化求和，
+    // 这里明确地把数据分成 8 路分别累加，最后再合并。
+    // Filtered 为 true 时不匹配的行用中性值代替 (0、+inf、-inf)，循环中没有分支。
+    // pages 转换成 double 参与运算 (int 范围内的整数都能被 double 精确表示)，
+    // 这样只用到浮点比较，在只有 SSE2 的机器上也不会退化成逐个分量处理。
+    template <bool Filtered>
+    BookStats accumulate(const BookFilter& filter) const
+    {
+        constexpr std::size_t kLanes = 8;
+        constexpr double kInf = std::numeric_limits<double>::infinity();
+        const DoubleLanes zero = {};
+        const DoubleLanes positiveInf = zero + kInf;
+        const DoubleLanes negativeInf = zero - kInf;
+        const MaskLanes noMask = {};
+        const MaskLanes positiveInfBits = (MaskLanes)positiveInf;
+        const MaskLanes negativeInfBits = (MaskLanes)negativeInf;
+
+        MaskLanes count = noMask;
+        DoubleLanes sumPrice = zero;
+        DoubleLanes minPrice = positiveInf;
+        DoubleLanes maxPrice = negativeInf;
+        DoubleLanes sumPages = zero;
+        DoubleLanes minPages = positiveInf;
+        DoubleLanes maxPages = negativeInf;
+
+        const double* prices = priceColumn.data();
+        const int* pages = pageColumn.data();
+        std::size_t n = size();
+        std::size_t i = 0;
+        for (; i + kLanes <= n; i += kLanes) {
+            DoubleLanes price;
+            IntLanes pageCount32;
+            std::memcpy(&price, prices + i, sizeof(price));
+            std::memcpy(&pageCount32, pages + i, sizeof(pageCount32));
+            DoubleLanes pageCount = __builtin_convertvector(pageCount32, DoubleLanes);
+            MaskLanes hit = noMask - 1; // 比较结果: 每个分量为 -1 (真) 或 0 (假)
+            if constexpr (Filtered) {
+                hit = (price >= filter.minPrice) & (price < filter.maxPrice)
+                    & (pageCount >= filter.minPages) & (pageCount <= filter.maxPages);
+            }
+            count -= hit;
+            // 不匹配的分量用位运算换成中性值 (0.0 的位模式是全 0)，SSE2 上也只需要 and/andnot/or
+            MaskLanes priceBits = (MaskLanes)price & hit;
+            MaskLanes pageBits = (MaskLanes)pageCount & hit;
+            DoubleLanes low = (DoubleLanes)(priceBits | (positiveInfBits & ~hit));
+            DoubleLanes high = (DoubleLanes)(priceBits | (negativeInfBits & ~hit));
+            DoubleLanes lowPages = (DoubleLanes)(pageBits | (positiveInfBits & ~hit));
+            DoubleLanes highPages = (DoubleLanes)(pageBits | (negativeInfBits & ~hit));
+            sumPrice += (DoubleLanes)priceBits;
+            sumPages += (DoubleLanes)pageBits;
+            minPrice = low < minPrice ? low : minPrice;
+            maxPrice = high > maxPrice ? high : maxPrice;
+            minPages = lowPages < minPages ? lowPages : minPages;
+            maxPages = highPages > maxPages ? highPages : maxPages;
+        }
+
+        BookStats stats;
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            stats.count += static_cast<std::size_t>(count[l]);
+            stats.sumPrice += sumPrice[l];
+            stats.minPrice = std::min(stats.minPrice, minPrice[l]);
+            stats.maxPrice = std::max(stats.maxPrice, maxPrice[l]);
+            stats.sumPages += static_cast<std::int64_t>(sumPages[l]);
+            if (minPages[l] <= maxPages[l]) { // 该路至少有一行匹配
+                stats.minPages = std::min(stats.minPages, static_cast<int>(minPages[l]));
+                stats.maxPages = std::max(stats.maxPages, static_cast<int>(maxPages[l]));
+            }
+        }
+        // 剩余不足 8 行的部分逐行处理
+        for (; i < n; ++i) {
+            if (!Filtered || matches(filter, prices[i], pages[i])) {
+                stats.count++;
+                stats.sumPrice += prices[i];
+                stats.minPrice = std::min(stats.minPrice, prices[i]);
+                stats.maxPrice = std::max(stats.maxPrice, prices[i]);
+                stats.sumPages += pages[i];
+                stats.minPages = std::min(stats.minPages, pages[i]);
+                stats.maxPages = std::max(stats.maxPages, pages[i]);
+            }
+        }
+        return stats;
+    }
+
+    TitleArena arena;
+    std::vector<std::uint32_t> titleIds;
+    std::vector<int> pageColumn;
+    std::vector<double> priceColumn;
+};
+
+#endif // BOOK_CATALOG_H
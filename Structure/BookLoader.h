@@ -0,0 +1,756 @@
+// BookLoader.h
+#ifndef BOOK_LOADER_H
+#define BOOK_LOADER_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Book.h"
+#include "../Pointer/ArrayKernels.h"
+
+// 从文件批量读取书籍: book_array.cpp / book_ini.cpp 里的书都写死在 main 中，
+// 这里读取几十 GB 的书目导出文件。两种格式:
+//  - CSV: 每行 "title,pages,price"，title 可以用双引号括起来 (里面可以有逗号，"" 表示一个引号，不能换行)，
+//    行尾可以是 \n 或 \r\n，空行被忽略。CsvBookReader 用 mmap 映射整个文件，用 SIMD 一次比较 64 个字节，
+//    找出所有 ',' '\n' '"' 的位置，只在这些位置上解析。多线程时按字节数切成几段 (边界移到下一个换行之后)，
+//    每个线程解析自己的一段;
+//  - 二进制: BinaryBookWriter 写出、BinaryBookReader 映射读取。按列存放 (书名区、书名偏移、price、pages)，
+//    打开时不需要解析，pages / price 可以直接当作数组使用 (与 BookCatalog 的列相同)。
+//
+// 读出的书是 BookView: title 是指向映射文件的 string_view，不复制字符串，在读取器关闭之前有效。
+// 需要长期保存时用 toBook() 转换成 Book，或者加入 BookCatalog (书名会复制到它的 TitleArena 中)。
+// 带引号的书名中的 "" 在 BookView 里保持原样 (不复制就无法去掉)，unquoteTitle() 可以得到去掉转义后的字符串。
+// 出错时与 SpecCatalog 一样返回 false，并把原因 (包括出错的字节位置) 写入 error。
+
+/**
+ * @brief 一本书。title 指向读取器映射的文件
+ */
+struct BookView
+{
+    std::string_view title;
+    int pages = 0;
+    double price = 0.0;
+
+    Book toBook() const { return Book{std::string(title), pages, price}; }
+};
+
+// CSV 中带引号的书名里的 "" 换成 "
+inline std::string unquoteTitle(std::string_view title)
+{
+    std::string text;
+    text.reserve(title.size());
+    for (std::size_t i = 0; i < title.size(); ++i) {
+        text += title[i];
+        if (title[i] == '"' && i + 1 < title.size() && title[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return text;
+}
+
+namespace book_io {
+
+inline constexpr char kMagic[8] = {'B', 'O', 'O', 'K', 'B', 'I', 'N', '\0'};
+inline constexpr std::uint32_t kFormatVersion = 1;
+inline constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+// 二进制文件格式 (本机字节序，各部分按 8 字节对齐):
+//   Header | 书名区 | uint64 titleOffsets[count + 1] | double prices[count] | int32 pages[count]
+// 第 i 本书的书名是书名区中的 [titleOffsets[i], titleOffsets[i + 1])
+struct Header
+{
+    char magic[8];
+    std::uint32_t formatVersion;
+    std::uint32_t byteOrder;
+    std::uint64_t count;
+    std::uint64_t titlesOffset;
+    std::uint64_t titlesSize;
+    std::uint64_t offsetsOffset;
+    std::uint64_t pricesOffset;
+    std::uint64_t pagesOffset;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 64);
+static_assert(sizeof(int) == 4, "pages are stored as int32");
+
+constexpr std::uint64_t alignUp(std::uint64_t n) { return (n + 7) & ~std::uint64_t{7}; }
+
+inline bool fail(std::string* error, std::string message)
+{
+    if (error != nullptr) {
+        *error = std::move(message);
+    }
+    return false;
+}
+
+/**
+ * @brief 只读映射整个文件
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        MappedFile moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    // 空文件也能打开 (data() 为空)
+    bool open(const std::string& path, std::string* error = nullptr)
+    {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return fail(error, "cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return fail(error, "cannot stat " + path);
+        }
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        if (size != 0) {
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                return fail(error, "mmap failed: " + path);
+            }
+            // 文件按顺序读取: 让内核提前读入后面的页
+            madvise(data, size, MADV_SEQUENTIAL);
+            mapped = static_cast<const char*>(data);
+            mappedSize = size;
+        }
+        ::close(fd);
+        opened = true;
+        return true;
+    }
+
+    void close()
+    {
+        if (mapped != nullptr) {
+            munmap(const_cast<char*>(mapped), mappedSize);
+        }
+        mapped = nullptr;
+        mappedSize = 0;
+        opened = false;
+    }
+
+    bool isOpen() const { return opened; }
+    std::string_view data() const { return std::string_view(mapped, mappedSize); }
+
+private:
+    void swap(MappedFile& other) noexcept
+    {
+        std::swap(mapped, other.mapped);
+        std::swap(mappedSize, other.mappedSize);
+        std::swap(opened, other.opened);
+    }
+
+    const char* mapped = nullptr;
+    std::size_t mappedSize = 0;
+    bool opened = false;
+};
+
+// ===================================================================
+// SIMD 分隔符扫描
+// ===================================================================
+// structuralMask(p) 返回 p[0..63] 中 ',' '\n' '"' 的位置 (第 i 位对应 p[i])。
+// 与 array_kernels 一样，每个指令集一个结构体，运行时按 array_kernels::simdLevel() 选择。
+
+namespace simd {
+
+struct Baseline
+{
+    static std::uint64_t structuralMask(const char* p)
+    {
+#if ARRAY_KERNELS_X86
+        // x86-64 一定有 SSE2: 每次比较 16 个字节
+        std::uint64_t mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * k));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                                       _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+            mask |= std::uint64_t{static_cast<std::uint16_t>(_mm_movemask_epi8(hit))} << (16 * k);
+        }
+        return mask;
+#else
+        std::uint64_t mask = 0;
+        for (int i = 0; i < 64; ++i) {
+            mask |= std::uint64_t{p[i] == ',' || p[i] == '\n' || p[i] == '"'} << i;
+        }
+        return mask;
+#endif
+    }
+};
+
+#if ARRAY_KERNELS_X86
+
+struct Avx2
+{
+    [[gnu::target("avx2")]]
+    static std::uint64_t structuralMask(const char* p)
+    {
+        std::uint64_t mask = 0;
+        for (int k = 0; k < 2; ++k) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * k));
+            __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+                                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                                          _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')));
+            mask |= std::uint64_t{static_cast<std::uint32_t>(_mm256_movemask_epi8(hit))} << (32 * k);
+        }
+        return mask;
+    }
+};
+
+struct Avx512
+{
+    [[gnu::target("avx512f,avx512bw")]]
+    static std::uint64_t structuralMask(const char* p)
+    {
+        __m512i v = _mm512_loadu_si512(p);
+        return _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(',')) | _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('\n')) |
+               _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('"'));
+    }
+};
+
+#endif // ARRAY_KERNELS_X86
+
+} // namespace simd
+
+namespace detail {
+
+using array_kernels::detail::chunkCount;
+using array_kernels::detail::parallelChunks;
+
+using MaskFunction = std::uint64_t (*)(const char*);
+
+inline MaskFunction structuralMask()
+{
+    switch (array_kernels::simdLevel()) {
+#if ARRAY_KERNELS_X86
+        case array_kernels::SimdLevel::Avx512: return &simd::Avx512::structuralMask;
+        case array_kernels::SimdLevel::Avx2:   return &simd::Avx2::structuralMask;
+#endif
+        default:                               return &simd::Baseline::structuralMask;
+    }
+}
+
+// 依次给出 [begin, end) 中 ',' '\n' '"' 的位置。每 64 个字节计算一次位掩码，之后只是取最低位
+class Scanner
+{
+public:
+    Scanner(std::string_view text, std::size_t begin, std::size_t end, MaskFunction mask)
+        : text(text), end(end), mask(mask), block(begin & ~std::size_t{63})
+    {
+        bits = load(block) & (~std::uint64_t{0} << (begin - block));
+    }
+
+    // 下一个分隔符的位置，没有时返回 end
+    std::size_t next()
+    {
+        while (bits == 0) {
+            block += 64;
+            if (block >= end) {
+                return end;
+            }
+            bits = load(block);
+        }
+        std::size_t position = block + static_cast<std::size_t>(__builtin_ctzll(bits));
+        bits &= bits - 1;
+        return position < end ? position : end;
+    }
+
+private:
+    // 文件最后不足 64 字节时复制到缓冲区，不读映射之外的内存
+    std::uint64_t load(std::size_t offset) const
+    {
+        if (offset + 64 <= text.size()) {
+            return mask(text.data() + offset);
+        }
+        char tail[64] = {};
+        if (offset < text.size()) { // 空输入时 text.data() 可能是空指针
+            std::memcpy(tail, text.data() + offset, text.size() - offset);
+        }
+        return mask(tail) & ((std::uint64_t{1} << (text.size() - offset)) - 1);
+    }
+
+    std::string_view text;
+    std::size_t end;
+    MaskFunction mask;
+    std::size_t block;
+    std::uint64_t bits = 0;
+};
+
+template <class T>
+bool parseNumber(const char* first, const char* last, T& value)
+{
+    auto [next, status] = std::from_chars(first, last, value);
+    return status == std::errc() && next == last && first != last;
+}
+
+// 价格通常是 "123.45" 这样的短小数: 整数部分和小数部分合起来不超过 15 位时，
+// 它们组成的整数和 10 的幂都能被 double 精确表示，一次除法的结果就是正确舍入的值
+// (与 from_chars 相同)。其他情况 (指数、很长的数字) 交给 from_chars
+inline bool parsePrice(const char* first, const char* last, double& value)
+{
+    static constexpr double kPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    p += negative;
+    std::uint64_t digits = 0;
+    std::size_t count = 0;
+    std::size_t fraction = 0;
+    const char* start = p;
+    for (; p != last && static_cast<unsigned>(*p - '0') < 10; ++p, ++count) {
+        digits = digits * 10 + static_cast<unsigned>(*p - '0');
+    }
+    bool hasInteger = p != start;
+    if (p != last && *p == '.') {
+        for (++p; p != last && static_cast<unsigned>(*p - '0') < 10; ++p, ++count, ++fraction) {
+            digits = digits * 10 + static_cast<unsigned>(*p - '0');
+        }
+    }
+    if (p != last || count > 15 || (!hasInteger && fraction == 0)) {
+        return parseNumber(first, last, value);
+    }
+    value = static_cast<double>(digits) / kPowers[fraction];
+    value = negative ? -value : value;
+    return true;
+}
+
+// 解析 text 中 [begin, end) 的行 (begin 是行首，end 是行首或文件末尾)，对每本书调用 emit。
+// stop 被其他线程置位时提前结束
+template <class Emit>
+bool parseCsv(std::string_view text, std::size_t begin, std::size_t end, MaskFunction mask, Emit& emit,
+              const std::atomic<bool>& stop, const std::string& name, std::string* error)
+{
+    const char* data = text.data();
+    Scanner scan(text, begin, end, mask);
+    std::size_t pos = begin;
+    auto failAt = [&](std::size_t at, const char* message) {
+        return fail(error, name + ": byte " + std::to_string(at) + ": " + message);
+    };
+    while (pos < end) {
+        if (stop.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        // 空行
+        if (data[pos] == '\n' || (data[pos] == '\r' && pos + 1 < end && data[pos + 1] == '\n')) {
+            pos = scan.next() + 1;
+            continue;
+        }
+        BookView book;
+        std::size_t comma;
+        if (data[pos] == '"') {
+            scan.next(); // 开头的引号
+            std::size_t quote;
+            for (;;) {
+                quote = scan.next();
+                if (quote >= end || data[quote] == '\n') {
+                    return failAt(pos, "unterminated quoted title");
+                }
+                if (data[quote] == '"') {
+                    if (quote + 1 < end && data[quote + 1] == '"') {
+                        scan.next(); // "" 是转义的引号
+                        continue;
+                    }
+                    break;
+                }
+            }
+            book.title = std::string_view(data + pos + 1, quote - pos - 1);
+            comma = scan.next();
+            if (comma != quote + 1 || data[comma] != ',') {
+                return failAt(quote, "expected ',' after quoted title");
+            }
+        } else {
+            comma = scan.next();
+            if (comma >= end || data[comma] != ',') {
+                return failAt(pos, comma < end && data[comma] == '"' ? "quote inside unquoted title" : "expected title,pages,price");
+            }
+            book.title = std::string_view(data + pos, comma - pos);
+        }
+        std::size_t comma2 = scan.next();
+        if (comma2 >= end || data[comma2] != ',') {
+            return failAt(pos, "expected title,pages,price");
+        }
+        std::size_t eol = scan.next();
+        if (eol < end && data[eol] != '\n') {
+            return failAt(eol, "too many fields or stray quote");
+        }
+        std::size_t priceEnd = eol > comma2 + 1 && data[eol - 1] == '\r' ? eol - 1 : eol;
+        if (!parseNumber(data + comma + 1, data + comma2, book.pages)) {
+            return failAt(comma + 1, "bad pages");
+        }
+        if (!parsePrice(data + comma2 + 1, data + priceEnd, book.price)) {
+            return failAt(comma2 + 1, "bad price");
+        }
+        emit(book);
+        pos = eol + 1;
+    }
+    return true;
+}
+
+} // namespace detail
+
+} // namespace book_io
+
+/**
+ * @brief 读取 CSV 书目 (见文件开头的格式说明)
+ */
+class CsvBookReader
+{
+public:
+    /**
+     * @brief 映射文件，之前打开的文件会先关闭。
+     * @param hasHeader 第一行是表头 ("title,pages,price" 之类)，解析时跳过
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool open(const std::string& path, bool hasHeader = false, std::string* error = nullptr)
+    {
+        name = path;
+        header = hasHeader;
+        external = {};
+        return file.open(path, error);
+    }
+
+    // 直接解析内存中的文本 (不复制，text 必须在读取器使用期间有效)
+    void attach(std::string_view text, bool hasHeader = false)
+    {
+        file.close();
+        name = "<memory>";
+        header = hasHeader;
+        external = text;
+    }
+
+    std::string_view text() const { return file.isOpen() ? file.data() : external; }
+    std::size_t bytes() const { return text().size(); }
+
+    /**
+     * @brief 按顺序对每本书调用 f(const BookView&)，单线程。
+     * @return 格式错误时返回 false (出错之前的书已经交给了 f)
+     */
+    template <class F>
+    bool forEach(F&& f, std::string* error = nullptr) const
+    {
+        std::atomic<bool> stop{false};
+        return book_io::detail::parseCsv(text(), firstLine(), bytes(), book_io::detail::structuralMask(), f, stop, name, error);
+    }
+
+    /**
+     * @brief 多线程解析: 文件切成几段，每段由一个线程按顺序调用 f(段号, const BookView&)。
+     * 不同的段会同时调用 f; 段号小的段在文件中靠前。threads 为 0 时使用全部核心。
+     * @return 任何一段出错时返回 false (其他段会尽快停止)
+     */
+    template <class F>
+    bool forEachParallel(F&& f, unsigned threads = 0, std::string* error = nullptr) const
+    {
+        std::vector<std::size_t> bounds = chunkBounds(threads);
+        std::size_t chunks = bounds.size() - 1;
+        std::vector<std::string> errors(chunks);
+        std::vector<char> failed(chunks, 0);
+        std::atomic<bool> stop{false};
+        book_io::detail::MaskFunction mask = book_io::detail::structuralMask();
+        book_io::detail::parallelChunks(chunks, chunks, [&](std::size_t c, std::size_t, std::size_t) {
+            auto emit = [&](const BookView& book) { f(c, book); };
+            if (!book_io::detail::parseCsv(text(), bounds[c], bounds[c + 1], mask, emit, stop, name, &errors[c])) {
+                failed[c] = 1;
+                stop.store(true, std::memory_order_relaxed);
+            }
+        });
+        for (std::size_t c = 0; c < chunks; ++c) {
+            if (failed[c]) {
+                return book_io::fail(error, errors[c]);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 读出所有书 (按文件中的顺序) 追加到 books。
+     * 出错时 books 保持不变 (与 BinaryBookReader::load 相同): 各段是同时解析的，
+     * 出错位置之后的段可能已经读出了一部分，追加进去会在中间留下空缺。
+     */
+    bool load(std::vector<BookView>& books, unsigned threads = 0, std::string* error = nullptr) const
+    {
+        std::vector<std::vector<BookView>> parts(chunkBounds(threads).size() - 1);
+        if (!forEachParallel([&](std::size_t c, const BookView& book) { parts[c].push_back(book); }, threads, error)) {
+            return false;
+        }
+        for (const std::vector<BookView>& part : parts) {
+            books.insert(books.end(), part.begin(), part.end());
+        }
+        return true;
+    }
+
+private:
+    // 跳过表头后的第一个字节
+    std::size_t firstLine() const
+    {
+        if (!header) {
+            return 0;
+        }
+        std::size_t eol = text().find('\n');
+        return eol == std::string_view::npos ? bytes() : eol + 1;
+    }
+
+    // 每段的起点都在行首: 按字节数均分后移到下一个换行之后 (带引号的书名里不能有换行，所以这里不会切错)
+    std::vector<std::size_t> chunkBounds(unsigned threads) const
+    {
+        std::string_view t = text();
+        std::size_t begin = firstLine();
+        std::size_t chunks = book_io::detail::chunkCount(t.size() - begin, threads);
+        std::vector<std::size_t> bounds{begin};
+        for (std::size_t c = 1; c < chunks; ++c) {
+            std::size_t at = begin + (t.size() - begin) * c / chunks;
+            std::size_t eol = t.find('\n', std::max(at, bounds.back()));
+            bounds.push_back(eol == std::string_view::npos ? t.size() : eol + 1);
+        }
+        bounds.push_back(t.size());
+        return bounds;
+    }
+
+    book_io::MappedFile file;
+    std::string_view external;
+    std::string name;
+    bool header = false;
+};
+
+/**
+ * @brief 写二进制书目文件。书名在 add 时直接写入文件，pages / price / 书名偏移保存在内存中 (每本书 20 字节)，
+ * finish 时写在书名区之后，最后回到开头写入文件头。
+ * 内容先写到 path + ".tmp"，finish 时 fsync 后 rename 替换目标文件: 正在映射旧文件的 BinaryBookReader
+ * 不会因为文件被截断而收到 SIGBUS，它们继续看到旧的内容。
+ */
+class BinaryBookWriter
+{
+public:
+    /**
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool open(const std::string& path, std::string* error = nullptr)
+    {
+        name = path;
+        tempName = path + ".tmp";
+        out = std::ofstream(tempName, std::ios::binary | std::ios::trunc);
+        offsets.assign(1, 0);
+        prices.clear();
+        pages.clear();
+        if (!out) {
+            return book_io::fail(error, "cannot create " + tempName);
+        }
+        book_io::Header placeholder{};
+        out.write(reinterpret_cast<const char*>(&placeholder), sizeof(placeholder));
+        return true;
+    }
+
+    void add(std::string_view title, int pageCount, double price)
+    {
+        out.write(title.data(), static_cast<std::streamsize>(title.size()));
+        offsets.push_back(offsets.back() + title.size());
+        prices.push_back(price);
+        pages.push_back(pageCount);
+    }
+
+    void add(const BookView& book) { add(book.title, book.pages, book.price); }
+    void add(const Book& book) { add(book.title, book.pages, book.price); }
+
+    std::size_t size() const { return pages.size(); }
+
+    bool finish(std::string* error = nullptr)
+    {
+        using namespace book_io;
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.formatVersion = kFormatVersion;
+        header.byteOrder = kByteOrderMark;
+        header.count = pages.size();
+        header.titlesOffset = sizeof(Header);
+        header.titlesSize = offsets.back();
+        header.offsetsOffset = alignUp(header.titlesOffset + header.titlesSize);
+        header.pricesOffset = header.offsetsOffset + offsets.size() * sizeof(std::uint64_t);
+        header.pagesOffset = header.pricesOffset + prices.size() * sizeof(double);
+
+        static constexpr char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(header.offsetsOffset - header.titlesOffset - header.titlesSize));
+        out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+        out.write(reinterpret_cast<const char*>(prices.data()), static_cast<std::streamsize>(prices.size() * sizeof(double)));
+        out.write(reinterpret_cast<const char*>(pages.data()), static_cast<std::streamsize>(pages.size() * sizeof(std::int32_t)));
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out) {
+            std::remove(tempName.c_str());
+            return fail(error, "write failed: " + tempName);
+        }
+        // rename 之前先把内容落盘，崩溃时要么是旧文件，要么是完整的新文件
+        int fd = ::open(tempName.c_str(), O_RDONLY | O_CLOEXEC);
+        bool synced = fd >= 0 && ::fsync(fd) == 0;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        if (!synced || std::rename(tempName.c_str(), name.c_str()) != 0) {
+            std::remove(tempName.c_str());
+            return fail(error, "cannot replace " + name);
+        }
+        return true;
+    }
+
+private:
+    static bool fail(std::string* error, std::string message) { return book_io::fail(error, std::move(message)); }
+
+    std::ofstream out;
+    std::string name;
+    std::string tempName;
+    std::vector<std::uint64_t> offsets;
+    std::vector<double> prices;
+    std::vector<std::int32_t> pages;
+};
+
+/**
+ * @brief 只读打开二进制书目文件 (mmap)。打开时只检查文件头和各部分的边界，书名偏移在读取每本书时检查
+ */
+class BinaryBookReader
+{
+public:
+    /**
+     * @brief 映射文件，之前打开的文件会先关闭。
+     * @param error 失败时写入原因 (可以为 nullptr)
+     */
+    bool open(const std::string& path, std::string* error = nullptr)
+    {
+        using namespace book_io;
+        close();
+        if (!file.open(path, error)) {
+            return false;
+        }
+        std::string_view data = file.data();
+        if (data.size() < sizeof(Header)) {
+            close();
+            return fail(error, path + ": not a book file");
+        }
+        const Header& h = *reinterpret_cast<const Header*>(data.data());
+        auto fits = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t size) {
+            return offset % 8 == 0 && offset <= data.size() && count <= (data.size() - offset) / size;
+        };
+        if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.formatVersion != kFormatVersion ||
+            h.byteOrder != kByteOrderMark) {
+            close();
+            return fail(error, path + ": not a book file (or written by another version / byte order)");
+        }
+        if (!fits(h.titlesOffset, h.titlesSize, 1) || !fits(h.offsetsOffset, h.count, sizeof(std::uint64_t)) ||
+            !fits(h.offsetsOffset, h.count + 1, sizeof(std::uint64_t)) || !fits(h.pricesOffset, h.count, sizeof(double)) ||
+            !fits(h.pagesOffset, h.count, sizeof(std::int32_t))) {
+            close();
+            return fail(error, path + ": corrupt book file");
+        }
+        header = &h;
+        titles = data.substr(h.titlesOffset, h.titlesSize);
+        offsets = reinterpret_cast<const std::uint64_t*>(data.data() + h.offsetsOffset);
+        prices = reinterpret_cast<const double*>(data.data() + h.pricesOffset);
+        pages = reinterpret_cast<const int*>(data.data() + h.pagesOffset);
+        return true;
+    }
+
+    void close()
+    {
+        file.close();
+        header = nullptr;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+    std::size_t size() const { return header ? header->count : 0; }
+    std::size_t bytes() const { return file.data().size(); }
+
+    // 列直接指向映射的文件
+    std::span<const double> pricesColumn() const { return std::span<const double>(prices, size()); }
+    std::span<const int> pagesColumn() const { return std::span<const int>(pages, size()); }
+
+    // 第 index 本书 (index < size())。书名偏移损坏时返回 nullopt
+    std::optional<BookView> book(std::size_t index) const
+    {
+        std::uint64_t first = offsets[index];
+        std::uint64_t last = offsets[index + 1];
+        if (first > last || last > titles.size()) {
+            return std::nullopt;
+        }
+        return BookView{titles.substr(first, last - first), pages[index], prices[index]};
+    }
+
+    /**
+     * @brief 按顺序对每本书调用 f(const BookView&)。文件损坏时返回 false
+     */
+    template <class F>
+    bool forEach(F&& f, std::string* error = nullptr) const
+    {
+        for (std::size_t i = 0; i < size(); ++i) {
+            std::optional<BookView> view = book(i);
+            if (!view) {
+                return fail(error, "corrupt title offset at book " + std::to_string(i));
+            }
+            f(*view);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 读出所有书追加到 books。多线程时每个线程填写一段
+     */
+    bool load(std::vector<BookView>& books, unsigned threads = 0, std::string* error = nullptr) const
+    {
+        std::size_t base = books.size();
+        std::size_t n = size();
+        books.resize(base + n);
+        std::atomic<bool> corrupt{false};
+        book_io::detail::parallelChunks(n, book_io::detail::chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::optional<BookView> view = book(i);
+                if (!view) {
+                    corrupt.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                books[base + i] = *view;
+            }
+        });
+        if (corrupt.load()) {
+            books.resize(base);
+            return fail(error, "corrupt title offsets");
+        }
+        return true;
+    }
+
+private:
+    static bool fail(std::string* error, std::string message) { return book_io::fail(error, std::move(message)); }
+
+    book_io::MappedFile file;
+    const book_io::Header* header = nullptr;
+    std::string_view titles;
+    const std::uint64_t* offsets = nullptr;
+    const double* prices = nullptr;
+    const int* pages = nullptr;
+};
+
+#endif // BOOK_LOADER_H
@@ -0,0 +1,531 @@
+// BookSort.h
+#ifndef BOOK_SORT_H
+#define BOOK_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Book.h"
+#include "BookCatalog.h"
+#include "../Pointer/ArrayKernels.h"
+
+// 书籍排序与排名: book_array.cpp 按下标依次遍历 book_list，这里对上亿本书按 price 或 pages
+// 求出排序后的顺序、前 k 名和第 n 名。书籍本身 (vector<Book> 或 BookCatalog 的列) 从不移动，
+// 所有函数都返回行号 (与 BookCatalog::Selection 相同的 uint32_t)。
+//
+// 做法: 把排序字段并行地提取成紧凑的 (key, index) 数组 (pages 每项 8 字节，price 每项 16 字节)，
+// key 是保序编码后的无符号整数，之后只在这个数组上操作:
+//  - sortBooks: 并行 LSD 基数排序，每轮 8 位，所有书在某一位上都相同时跳过这一轮;
+//  - nthElement: 并行的 MSD 基数选择，每轮看 16 位、只保留第 n 名所在的桶，剩下的很少时用
+//    std::nth_element。第一轮直接读书籍的字段，只提取第 n 名所在的桶;
+//  - topK: k 较小时每个线程用一个大小为 k 的堆扫描一遍; 否则先选出第 k 名，再筛出不比它差的 k 项排序;
+//  - sortBooksBy: 任意比较函数 (例如按书名) 的并行归并排序: 每个线程 stable_sort 一段，再两两归并。
+// 键相同的书按行号升序排列 (稳定)，降序排序时也是如此。
+// 多线程的方式与 array_kernels 相同: threads 为 0 时使用全部核心，输入太小时不创建线程。
+
+namespace book_sort {
+
+enum class BookKey
+{
+    Price,
+    Pages
+};
+
+enum class Order
+{
+    Ascending,
+    Descending
+};
+
+// 排序字段编码后的值 (按无符号整数比较的顺序与原值的顺序相同) 和书的行号
+template <class K>
+struct KeyIndex
+{
+    using Key = K;
+
+    K key;
+    std::uint32_t index;
+};
+
+template <class K>
+inline bool operator<(const KeyIndex<K>& a, const KeyIndex<K>& b)
+{
+    return a.key != b.key ? a.key < b.key : a.index < b.index;
+}
+
+// int 翻转符号位后按无符号数比较，顺序不变
+inline std::uint32_t encodeKey(int value)
+{
+    return static_cast<std::uint32_t>(value) ^ 0x80000000u;
+}
+
+// double: 正数翻转符号位，负数翻转所有位。-0.0 排在 +0.0 之前，NaN 排在两端 (按符号位)
+inline std::uint64_t encodeKey(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) != 0 ? ~bits : bits | (std::uint64_t{1} << 63);
+}
+
+namespace detail {
+
+using array_kernels::detail::chunkCount;
+using array_kernels::detail::parallelChunks;
+
+constexpr std::size_t kRadixBits = 8;
+constexpr std::size_t kBuckets = std::size_t{1} << kRadixBits;
+// 候选少于这个数时不再按位缩小范围，直接用 std::nth_element
+constexpr std::size_t kSelectDirect = std::size_t{1} << 16;
+
+// 选择时每轮看 16 位: double 的最高 8 位只有符号和一部分指数，8 位一轮时第一轮几乎缩小不了范围
+constexpr std::size_t kSelectBits = 16;
+
+using Counts = std::array<std::size_t, kBuckets>;
+
+template <std::size_t Bits = kRadixBits, class K>
+std::size_t digitOf(K key, std::size_t shift)
+{
+    return static_cast<std::size_t>(key >> shift) & ((std::size_t{1} << Bits) - 1);
+}
+
+// 并行统计 digit(i) (0 <= digit < buckets) 的分布，找出排名为 rank 的元素所在的桶，
+// rank 减去更小的桶中的元素个数
+template <class Digit>
+std::size_t findBucket(std::size_t n, std::size_t buckets, Digit digit, std::size_t& rank, unsigned threads)
+{
+    std::size_t chunks = chunkCount(n, threads);
+    std::vector<std::vector<std::size_t>> local(chunks);
+    parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::vector<std::size_t>& counts = local[c];
+        counts.assign(buckets, 0);
+        for (std::size_t i = begin; i < end; ++i) {
+            ++counts[digit(i)];
+        }
+    });
+    for (std::size_t bucket = 0;; ++bucket) {
+        std::size_t count = 0;
+        for (const std::vector<std::size_t>& counts : local) {
+            count += counts[bucket];
+        }
+        if (rank < count) {
+            return bucket;
+        }
+        rank -= count;
+    }
+}
+
+inline void checkSize(std::size_t n)
+{
+    if (n > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("book_sort: more than 2^32 - 1 books");
+    }
+}
+
+// keyOf(i) 返回第 i 本书的排序字段 (int 或 double)，K 是编码后的类型
+template <class KeyOf>
+using KeyTypeOf = decltype(encodeKey(std::declval<KeyOf&>()(std::size_t{0})));
+
+// 第 i 本书编码后的键; 降序时把所有位取反
+template <class KeyOf>
+KeyTypeOf<KeyOf> keyAt(KeyOf& keyOf, std::size_t i, Order order)
+{
+    using K = KeyTypeOf<KeyOf>;
+    return static_cast<K>(encodeKey(keyOf(i)) ^ (order == Order::Descending ? ~K{0} : K{0}));
+}
+
+template <class KeyOf>
+std::vector<KeyIndex<KeyTypeOf<KeyOf>>> extractKeys(std::size_t n, KeyOf keyOf, Order order, unsigned threads)
+{
+    checkSize(n);
+    std::vector<KeyIndex<KeyTypeOf<KeyOf>>> keys(n);
+    parallelChunks(n, chunkCount(n, threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            keys[i] = {keyAt(keyOf, i, order), static_cast<std::uint32_t>(i)};
+        }
+    });
+    return keys;
+}
+
+// 只提取满足 keep(key, index) 的书 (按行号顺序): 先并行计数，再各自写到自己的位置
+template <class KeyOf, class Keep>
+std::vector<KeyIndex<KeyTypeOf<KeyOf>>> collectKeys(std::size_t n, KeyOf keyOf, Order order, Keep keep, unsigned threads)
+{
+    checkSize(n);
+    std::size_t chunks = chunkCount(n, threads);
+    std::vector<std::size_t> counts(chunks + 1, 0);
+    parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            count += keep(keyAt(keyOf, i, order), i) ? 1 : 0;
+        }
+        counts[c + 1] = count;
+    });
+    for (std::size_t c = 0; c < chunks; ++c) {
+        counts[c + 1] += counts[c];
+    }
+    std::vector<KeyIndex<KeyTypeOf<KeyOf>>> keys(counts[chunks]);
+    parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t next = counts[c];
+        for (std::size_t i = begin; i < end; ++i) {
+            auto key = keyAt(keyOf, i, order);
+            if (keep(key, i)) {
+                keys[next++] = {key, static_cast<std::uint32_t>(i)};
+            }
+        }
+    });
+    return keys;
+}
+
+// 并行 LSD 基数排序 (稳定)。每一轮: 各线程统计自己那一段中每个桶的个数，
+// 算出每个 (桶, 线程) 的写入位置后各自把元素分发到另一个数组。
+template <class K>
+void radixSort(std::vector<KeyIndex<K>>& keys, unsigned threads)
+{
+    constexpr std::size_t kPasses = sizeof(K) * 8 / kRadixBits;
+    const std::size_t n = keys.size();
+    if (n < 2) {
+        return;
+    }
+    std::size_t chunks = chunkCount(n, threads);
+
+    // 先用一遍扫描统计所有位的分布，找出所有书都相同的位 (例如 pages 的高位)，这些轮可以跳过
+    std::vector<std::array<Counts, kPasses>> totals(chunks);
+    parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::array<Counts, kPasses>& local = totals[c];
+        for (Counts& counts : local) {
+            counts.fill(0);
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t pass = 0; pass < kPasses; ++pass) {
+                ++local[pass][digitOf(keys[i].key, pass * kRadixBits)];
+            }
+        }
+    });
+    std::vector<std::size_t> passes;
+    for (std::size_t pass = 0; pass < kPasses; ++pass) {
+        std::size_t first = 0;
+        for (const auto& local : totals) {
+            first += local[pass][digitOf(keys[0].key, pass * kRadixBits)];
+        }
+        if (first != n) {
+            passes.push_back(pass);
+        }
+    }
+    if (passes.empty()) {
+        return;
+    }
+
+    auto buffer = std::make_unique_for_overwrite<KeyIndex<K>[]>(n);
+    KeyIndex<K>* from = keys.data();
+    KeyIndex<K>* to = buffer.get();
+    std::vector<Counts> offsets(chunks);
+    for (std::size_t pass : passes) {
+        const std::size_t shift = pass * kRadixBits;
+        parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            Counts& counts = offsets[c];
+            counts.fill(0);
+            for (std::size_t i = begin; i < end; ++i) {
+                ++counts[digitOf(from[i].key, shift)];
+            }
+        });
+        // 桶优先、线程其次的前缀和: 同一个桶里，前面线程的元素排在前面，保证稳定
+        std::size_t position = 0;
+        for (std::size_t b = 0; b < kBuckets; ++b) {
+            for (Counts& counts : offsets) {
+                std::size_t count = counts[b];
+                counts[b] = position;
+                position += count;
+            }
+        }
+        parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            Counts& next = offsets[c];
+            for (std::size_t i = begin; i < end; ++i) {
+                to[next[digitOf(from[i].key, shift)]++] = from[i];
+            }
+        });
+        std::swap(from, to);
+    }
+    if (from != keys.data()) {
+        parallelChunks(n, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+            std::memcpy(keys.data() + begin, from + begin, (end - begin) * sizeof(KeyIndex<K>));
+        });
+    }
+}
+
+// 把 keys 中满足 keep 的元素按原顺序并行地复制出来
+template <class K, class Keep>
+std::vector<KeyIndex<K>> parallelFilter(std::span<const KeyIndex<K>> keys, Keep keep, unsigned threads)
+{
+    std::size_t chunks = chunkCount(keys.size(), threads);
+    std::vector<std::size_t> counts(chunks + 1, 0);
+    parallelChunks(keys.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t count = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            count += keep(keys[i]) ? 1 : 0;
+        }
+        counts[c + 1] = count;
+    });
+    for (std::size_t c = 0; c < chunks; ++c) {
+        counts[c + 1] += counts[c];
+    }
+    std::vector<KeyIndex<K>> result(counts[chunks]);
+    parallelChunks(keys.size(), chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+        std::size_t next = counts[c];
+        for (std::size_t i = begin; i < end; ++i) {
+            if (keep(keys[i])) {
+                result[next++] = keys[i];
+            }
+        }
+    });
+    return result;
+}
+
+// 按 (key, index) 的顺序返回排名为 rank 的一项 (从 0 开始)，keys 非空且 rank < keys.size()。
+// MSD 基数选择: 从最高的 16 位开始，统计每个桶的个数，只保留 rank 所在的桶
+template <class K>
+KeyIndex<K> select(std::span<const KeyIndex<K>> keys, std::size_t rank, unsigned threads)
+{
+    std::span<const KeyIndex<K>> current = keys;
+    std::vector<KeyIndex<K>> kept;
+    for (std::size_t shift = sizeof(K) * 8; shift > 0 && current.size() > kSelectDirect;) {
+        shift -= kSelectBits;
+        std::size_t bucket = findBucket(current.size(), std::size_t{1} << kSelectBits,
+                                        [&](std::size_t i) { return digitOf<kSelectBits>(current[i].key, shift); }, rank, threads);
+        kept = parallelFilter<K>(current, [&](const KeyIndex<K>& k) { return digitOf<kSelectBits>(k.key, shift) == bucket; }, threads);
+        current = kept;
+    }
+    if (current.data() != kept.data()) {
+        kept.assign(current.begin(), current.end());
+    }
+    std::nth_element(kept.begin(), kept.begin() + static_cast<std::ptrdiff_t>(rank), kept.end());
+    return kept[rank];
+}
+
+template <class K>
+std::vector<std::uint32_t> indicesOf(const std::vector<KeyIndex<K>>& keys, unsigned threads)
+{
+    std::vector<std::uint32_t> rows(keys.size());
+    parallelChunks(keys.size(), chunkCount(keys.size(), threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            rows[i] = keys[i].index;
+        }
+    });
+    return rows;
+}
+
+template <class KeyOf>
+std::vector<std::uint32_t> sortBooks(std::size_t n, KeyOf keyOf, Order order, unsigned threads)
+{
+    auto keys = extractKeys(n, keyOf, order, threads);
+    radixSort(keys, threads);
+    return indicesOf(keys, threads);
+}
+
+// 不提取全部的键: 第一轮直接从书籍的字段统计最高 16 位的分布，只提取第 rank 名所在的桶，之后交给 select
+template <class KeyOf>
+KeyIndex<KeyTypeOf<KeyOf>> select(std::size_t n, KeyOf keyOf, std::size_t rank, Order order, unsigned threads)
+{
+    using K = KeyTypeOf<KeyOf>;
+    const std::size_t shift = sizeof(K) * 8 - kSelectBits;
+    std::size_t bucket = findBucket(n, std::size_t{1} << kSelectBits,
+                                    [&](std::size_t i) { return digitOf<kSelectBits>(keyAt(keyOf, i, order), shift); }, rank, threads);
+    auto keys = collectKeys(n, keyOf, order, [&](K key, std::size_t) { return digitOf<kSelectBits>(key, shift) == bucket; }, threads);
+    return select<K>(keys, rank, threads);
+}
+
+// k 不超过这个数时 topK 用每个线程一个大小为 k 的堆，只扫描一遍书籍
+constexpr std::size_t kHeapTopK = std::size_t{1} << 12;
+
+template <class KeyOf>
+std::vector<std::uint32_t> topK(std::size_t n, KeyOf keyOf, std::size_t k, Order order, unsigned threads)
+{
+    using K = KeyTypeOf<KeyOf>;
+    using Item = KeyIndex<K>;
+    checkSize(n);
+    k = std::min(k, n);
+    if (k == 0) {
+        return {};
+    }
+    std::vector<Item> keys;
+    if (k == n) {
+        keys = extractKeys(n, keyOf, order, threads);
+    } else if (k <= kHeapTopK) {
+        // 最大堆保存这一段目前最好的 k 项，堆顶是其中最差的一项。行号递增，
+        // 所以键与堆顶相同的书一定排在堆顶之后，只有键更小时才需要进堆
+        std::size_t chunks = chunkCount(n, threads);
+        std::vector<std::vector<Item>> best(chunks);
+        parallelChunks(n, chunks, [&](std::size_t c, std::size_t begin, std::size_t end) {
+            std::vector<Item>& heap = best[c];
+            heap.reserve(k);
+            for (std::size_t i = begin; i < end; ++i) {
+                K key = keyAt(keyOf, i, order);
+                if (heap.size() < k) {
+                    heap.push_back({key, static_cast<std::uint32_t>(i)});
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (key < heap.front().key) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = {key, static_cast<std::uint32_t>(i)};
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        });
+        for (const std::vector<Item>& heap : best) {
+            keys.insert(keys.end(), heap.begin(), heap.end());
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.resize(k);
+        return indicesOf(keys, threads);
+    } else {
+        Item kth = select(n, keyOf, k - 1, order, threads);
+        keys = collectKeys(n, keyOf, order, [&](K key, std::size_t i) { return !(kth < Item{key, static_cast<std::uint32_t>(i)}); },
+                           threads);
+    }
+    radixSort(keys, threads);
+    return indicesOf(keys, threads);
+}
+
+template <class KeyOf>
+std::uint32_t nthElement(std::size_t n, KeyOf keyOf, std::size_t rank, Order order, unsigned threads)
+{
+    if (rank >= n) {
+        throw std::invalid_argument("book_sort::nthElement: rank out of range");
+    }
+    checkSize(n);
+    return select(n, keyOf, rank, order, threads).index;
+}
+
+// 对 books 或 catalog 按 BookKey 调用 run(n, keyOf)
+template <class Run>
+decltype(auto) withKey(std::span<const Book> books, BookKey key, Run&& run)
+{
+    if (key == BookKey::Price) {
+        return run(books.size(), [books](std::size_t i) { return books[i].price; });
+    }
+    return run(books.size(), [books](std::size_t i) { return books[i].pages; });
+}
+
+template <class Run>
+decltype(auto) withKey(const BookCatalog& catalog, BookKey key, Run&& run)
+{
+    if (key == BookKey::Price) {
+        return run(catalog.size(), [prices = catalog.pricesColumn()](std::size_t i) { return prices[i]; });
+    }
+    return run(catalog.size(), [pages = catalog.pagesColumn()](std::size_t i) { return pages[i]; });
+}
+
+} // namespace detail
+
+// ===================================================================
+// 接口: books 可以是 std::vector<Book> / Book 数组 (转换成 span) 或 BookCatalog
+// ===================================================================
+
+/**
+ * @brief 按 key 排序后的行号: 结果的第 i 项是排名第 i 的书在 books 中的下标。
+ */
+inline std::vector<std::uint32_t> sortBooks(std::span<const Book> books, BookKey key, Order order = Order::Ascending,
+                                            unsigned threads = 0)
+{
+    return detail::withKey(books, key, [&](std::size_t n, auto keyOf) { return detail::sortBooks(n, keyOf, order, threads); });
+}
+
+inline std::vector<std::uint32_t> sortBooks(const BookCatalog& catalog, BookKey key, Order order = Order::Ascending,
+                                            unsigned threads = 0)
+{
+    return detail::withKey(catalog, key, [&](std::size_t n, auto keyOf) { return detail::sortBooks(n, keyOf, order, threads); });
+}
+
+/**
+ * @brief 排名前 k 的书 (升序时最小的 k 本，降序时最大的 k 本)，按排名顺序返回行号。
+ * k 大于书的数量时返回全部。
+ */
+inline std::vector<std::uint32_t> topK(std::span<const Book> books, BookKey key, std::size_t k,
+                                       Order order = Order::Ascending, unsigned threads = 0)
+{
+    return detail::withKey(books, key, [&](std::size_t n, auto keyOf) { return detail::topK(n, keyOf, k, order, threads); });
+}
+
+inline std::vector<std::uint32_t> topK(const BookCatalog& catalog, BookKey key, std::size_t k,
+                                       Order order = Order::Ascending, unsigned threads = 0)
+{
+    return detail::withKey(catalog, key, [&](std::size_t n, auto keyOf) { return detail::topK(n, keyOf, k, order, threads); });
+}
+
+/**
+ * @brief 排名为 rank (从 0 开始) 的书的行号，即 sortBooks(...)[rank]，但不需要完整排序。
+ * 例如 rank = n / 2 得到价格的中位数。rank 超出范围时抛出 std::invalid_argument。
+ */
+inline std::uint32_t nthElement(std::span<const Book> books, BookKey key, std::size_t rank,
+                                Order order = Order::Ascending, unsigned threads = 0)
+{
+    return detail::withKey(books, key, [&](std::size_t n, auto keyOf) { return detail::nthElement(n, keyOf, rank, order, threads); });
+}
+
+inline std::uint32_t nthElement(const BookCatalog& catalog, BookKey key, std::size_t rank,
+                                Order order = Order::Ascending, unsigned threads = 0)
+{
+    return detail::withKey(catalog, key, [&](std::size_t n, auto keyOf) { return detail::nthElement(n, keyOf, rank, order, threads); });
+}
+
+/**
+ * @brief 按任意比较函数 less(const Book&, const Book&) 稳定排序，返回行号。
+ * 用于无法编码成整数的字段 (例如书名)。并行归并排序: 每个线程对一段行号做 stable_sort，
+ * 然后每轮把相邻的两段归并成一段 (每一对由一个线程归并)，直到只剩一段。
+ */
+template <class Less>
+std::vector<std::uint32_t> sortBooksBy(std::span<const Book> books, Less less, unsigned threads = 0)
+{
+    const std::size_t n = books.size();
+    detail::checkSize(n);
+    std::vector<std::uint32_t> rows(n);
+    std::size_t chunks = detail::chunkCount(n, threads);
+    auto byBook = [&](std::uint32_t a, std::uint32_t b) { return less(books[a], books[b]); };
+    detail::parallelChunks(n, chunks, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            rows[i] = static_cast<std::uint32_t>(i);
+        }
+        std::stable_sort(rows.begin() + static_cast<std::ptrdiff_t>(begin), rows.begin() + static_cast<std::ptrdiff_t>(end), byBook);
+    });
+    // 与 parallelChunks 相同的分段边界
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; ++c) {
+        bounds[c] = n * c / chunks;
+    }
+    std::vector<std::uint32_t> merged(chunks > 1 ? n : 0);
+    while (bounds.size() > 2) {
+        std::size_t runs = bounds.size() - 1;
+        std::size_t pairs = runs / 2;
+        detail::parallelChunks(pairs, pairs, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t p = begin; p < end; ++p) {
+                auto first = rows.begin() + static_cast<std::ptrdiff_t>(bounds[2 * p]);
+                auto middle = rows.begin() + static_cast<std::ptrdiff_t>(bounds[2 * p + 1]);
+                auto last = rows.begin() + static_cast<std::ptrdiff_t>(bounds[2 * p + 2]);
+                std::merge(first, middle, middle, last, merged.begin() + (first - rows.begin()), byBook);
+            }
+        });
+        if (runs % 2 != 0) { // 落单的最后一段原样复制
+            std::copy(rows.begin() + static_cast<std::ptrdiff_t>(bounds[runs - 1]), rows.end(),
+                      merged.begin() + static_cast<std::ptrdiff_t>(bounds[runs - 1]));
+        }
+        rows.swap(merged);
+        std::vector<std::size_t> next;
+        for (std::size_t r = 0; r < runs; r += 2) {
+            next.push_back(bounds[r]);
+        }
+        next.push_back(n);
+        bounds.swap(next);
+    }
+    return rows;
+}
+
+} // namespace book_sort
+
+#endif // BOOK_SORT_H
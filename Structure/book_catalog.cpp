@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BookCatalog.h"
+using namespace std;
+
+// g++ book_catalog.cpp -o book_catalog -std=c++20 -O3 -march=native
+// 用法: ./book_catalog [书籍数量]
+// 对比 vector<Book> (AoS) 和 BookCatalog (SoA) 上的 "price < X and pages > Y" 查询
+
+// 运行 5 次取最快的一次，返回毫秒
+template <class F>
+double bestOf(F&& run)
+{
+    double best = 1e300;
+    for (int i = 0; i < 5; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        run();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+    }
+    return best;
+}
+
+void report(const char* name, double aosMs, double soaMs, bool same)
+{
+    cout << name << ": AoS " << aosMs << " ms, SoA " << soaMs << " ms, 加速比 "
+         << aosMs / soaMs << "x" << (same ? "" : "  (结果不一致!)") << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    const double maxPrice = 50.0; // price < 50
+    const int minPages = 500;     // pages > 499
+
+    // 1. 生成测试数据: 书名从 10 万个不同的书名里随机挑选
+    vector<Book> books;
+    books.reserve(n);
+    BookCatalog catalog;
+    catalog.reserve(n);
+    uint64_t state = 2463534242ull;
+    for (size_t i = 0; i < n; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        Book b = {"Book-" + to_string(state % 100000), static_cast<int>(state >> 20) % 2000 + 1,
+                  static_cast<double>((state >> 40) % 20000) / 100.0};
+        catalog.add(b);
+        books.push_back(std::move(b));
+    }
+    cout << "书籍数量: " << n << ", 不同书名: " << catalog.titles().uniqueCount()
+         << ", 书名 arena: " << catalog.titles().bytesUsed() / 1024 << " KB" << endl;
+    cout << "AoS 每本书 " << sizeof(Book) << " 字节, SoA 每本书 "
+         << sizeof(int) + sizeof(double) + sizeof(uint32_t) << " 字节" << endl << endl;
+
+    BookFilter filter;
+    filter.maxPrice = maxPrice;
+    filter.minPages = minPages;
+
+    // 2. 计数
+    size_t aosCount = 0, soaCount = 0;
+    double aosMs = bestOf([&] {
+        aosCount = 0;
+        for (const Book& b : books)
+        {
+            if (b.price < maxPrice && b.pages >= minPages)
+            {
+                aosCount++;
+            }
+        }
+    });
+    double soaMs = bestOf([&] { soaCount = catalog.count(filter); });
+    report("count    ", aosMs, soaMs, aosCount == soaCount);
+
+    // 3. 生成选择向量
+    vector<uint32_t> aosRows;
+    BookCatalog::Selection soaRows;
+    aosMs = bestOf([&] {
+        aosRows.clear();
+        for (size_t i = 0; i < books.size(); i++)
+        {
+            if (books[i].price < maxPrice && books[i].pages >= minPages)
+            {
+                aosRows.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    });
+    soaMs = bestOf([&] { soaRows = catalog.select(filter); });
+    report("select   ", aosMs, soaMs, aosRows == soaRows);
+
+    // 4. 带条件的聚合
+    double aosSum = 0, aosMin = 0;
+    BookStats stats;
+    aosMs = bestOf([&] {
+        aosSum = 0;
+        aosMin = 1e300;
+        for (const Book& b : books)
+        {
+            if (b.price < maxPrice && b.pages >= minPages)
+            {
+                aosSum += b.price;
+                aosMin = min(aosMin, b.price);
+            }
+        }
+    });
+    soaMs = bestOf([&] { stats = catalog.aggregate(filter); });
+    // 浮点求和的顺序不同，只比较到相对误差 1e-9
+    bool same = stats.minPrice == aosMin && (aosSum - stats.sumPrice) <= 1e-9 * aosSum && (stats.sumPrice - aosSum) <= 1e-9 * aosSum;
+    report("aggregate", aosMs, soaMs, same);
+
+    cout << endl << "满足条件的书: " << stats.count << " 本, 平均价格 " << stats.avgPrice()
+         << ", 平均页数 " << stats.avgPages() << ", 价格范围 [" << stats.minPrice << ", " << stats.maxPrice
+         << "], 页数范围 [" << stats.minPages << ", " << stats.maxPages << "]" << endl;
+    return 0;
+}
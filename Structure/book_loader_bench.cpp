@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BookLoader.h"
+using namespace std;
+
+// g++ book_loader_bench.cpp -o book_loader_bench -std=c++20 -O2 -pthread -Wno-psabi
+// 用法: ./book_loader_bench [书籍数量] [线程数] [CSV 文件路径]
+// 生成一个 CSV 书目文件，然后测量读取吞吐量 (GB/s，按 CSV 文件的字节数计算，文件已在页缓存中):
+// ifstream + getline 逐行解析成 Book (对照)、CsvBookReader 在各指令集下的单线程解析、多线程解析，
+// 以及转换成二进制文件后用 BinaryBookReader 读取。
+
+// 运行 3 次取最快的一次，返回秒
+template <class F>
+double bestOf(F&& run)
+{
+    double best = 1e300;
+    for (int i = 0; i < 3; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        run();
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10))
+                                : max(1u, thread::hardware_concurrency());
+    string path = argc > 3 ? argv[3] : "books.csv";
+    string binaryPath = path + ".bin";
+
+    // 1. 生成测试数据: 书名与 book_catalog.cpp 相同，每 16 本有一本带逗号、需要加引号
+    {
+        ofstream out(path, ios::binary | ios::trunc);
+        out << "title,pages,price\n";
+        uint64_t state = 2463534242ull;
+        char line[128];
+        for (size_t i = 0; i < n; i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            int pages = static_cast<int>(state >> 20) % 2000 + 1;
+            double price = static_cast<double>((state >> 40) % 20000) / 100.0;
+            const char* format = (state & 15) == 0 ? "\"Book-%llu, Vol. %d\",%d,%.2f\n" : "Book-%llu%.0d,%d,%.2f\n";
+            int length = snprintf(line, sizeof(line), format, static_cast<unsigned long long>(state % 100000),
+                                  static_cast<int>(state & 15), pages, price);
+            out.write(line, length);
+        }
+        if (!out.flush())
+        {
+            cerr << "cannot write " << path << endl;
+            return 1;
+        }
+    }
+
+    CsvBookReader reader;
+    string error;
+    if (!reader.open(path, true, &error))
+    {
+        cerr << error << endl;
+        return 1;
+    }
+    const double gigabytes = static_cast<double>(reader.bytes()) / 1e9;
+    cout << "书籍数量: " << n << ", CSV " << reader.bytes() / (1024 * 1024) << " MB, 线程数: " << threads << endl << endl;
+
+    // 2. 对照: getline + stoi / stod，每本书生成一个 Book (书名是 std::string)
+    size_t count = 0;
+    double seconds = bestOf([&] {
+        ifstream in(path);
+        string text;
+        getline(in, text); // 表头
+        vector<Book> books;
+        while (getline(in, text))
+        {
+            size_t priceComma = text.rfind(',');
+            size_t pagesComma = text.rfind(',', priceComma - 1);
+            string title = text.substr(0, pagesComma);
+            if (!title.empty() && title.front() == '"')
+            {
+                title = title.substr(1, title.size() - 2);
+            }
+            books.push_back(Book{std::move(title), stoi(text.substr(pagesComma + 1, priceComma - pagesComma - 1)),
+                                 stod(text.substr(priceComma + 1))});
+        }
+        count = books.size();
+    });
+    cout << "getline + stod (vector<Book>): " << gigabytes / seconds << " GB/s, " << count << " 本" << endl;
+
+    // 3. CsvBookReader: 单线程 forEach，各指令集
+    auto report = [&](const string& name, bool ok, size_t books, double checksum, double time) {
+        cout << name << ": " << gigabytes / time << " GB/s, " << books << " 本 (" << checksum << ")"
+             << (ok && books == n ? "" : "  (出错: " + error + ")") << endl;
+    };
+    for (array_kernels::SimdLevel level : {array_kernels::SimdLevel::Baseline, array_kernels::SimdLevel::Avx2,
+                                           array_kernels::SimdLevel::Avx512})
+    {
+        if (level > array_kernels::supportedSimdLevel())
+        {
+            continue;
+        }
+        array_kernels::setSimdLevel(level);
+        bool ok = true;
+        double sum = 0;
+        seconds = bestOf([&] {
+            count = 0;
+            sum = 0;
+            ok = reader.forEach([&](const BookView& book) {
+                count++;
+                sum += book.price;
+            }, &error);
+        });
+        report(string("CsvBookReader::forEach, ") + array_kernels::simdLevelName(level), ok, count, sum, seconds);
+    }
+
+    // 4. 多线程
+    {
+        vector<size_t> counts;
+        bool ok = true;
+        seconds = bestOf([&] {
+            counts.assign(threads * 2 + 1, 0);
+            ok = reader.forEachParallel([&](size_t chunk, const BookView&) { counts[chunk]++; }, threads, &error);
+        });
+        size_t total = 0;
+        for (size_t c : counts)
+        {
+            total += c;
+        }
+        report("CsvBookReader::forEachParallel", ok, total, 0, seconds);
+        vector<BookView> books;
+        seconds = bestOf([&] {
+            books.clear();
+            ok = reader.load(books, threads, &error);
+        });
+        report("CsvBookReader::load (vector<BookView>)", ok, books.size(), books.empty() ? 0 : books.back().price, seconds);
+
+        // 5. 二进制格式
+        BinaryBookWriter writer;
+        if (!writer.open(binaryPath, &error))
+        {
+            cerr << error << endl;
+            return 1;
+        }
+        for (const BookView& book : books)
+        {
+            writer.add(book);
+        }
+        if (!writer.finish(&error))
+        {
+            cerr << error << endl;
+            return 1;
+        }
+    }
+    BinaryBookReader binary;
+    double openSeconds = bestOf([&] {
+        if (!binary.open(binaryPath, &error))
+        {
+            cerr << error << endl;
+            exit(1);
+        }
+    });
+    cout << "二进制文件 " << binary.bytes() / (1024 * 1024) << " MB, 打开 " << openSeconds * 1e6 << " 微秒" << endl;
+    bool ok = true;
+    double sum = 0;
+    seconds = bestOf([&] {
+        count = 0;
+        sum = 0;
+        ok = binary.forEach([&](const BookView& book) {
+            count++;
+            sum += book.price;
+        }, &error);
+    });
+    report("BinaryBookReader::forEach (按 CSV 大小)", ok, count, sum, seconds);
+    vector<BookView> books;
+    seconds = bestOf([&] {
+        books.clear();
+        ok = binary.load(books, threads, &error);
+    });
+    report("BinaryBookReader::load (按 CSV 大小)", ok, books.size(), books.empty() ? 0 : books.back().price, seconds);
+    remove(binaryPath.c_str());
+    return 0;
+}
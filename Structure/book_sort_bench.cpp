@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BookSort.h"
+using namespace std;
+
+// g++ book_sort_bench.cpp -o book_sort_bench -std=c++20 -O2 -pthread -Wno-psabi
+// 用法: ./book_sort_bench [书籍数量] [线程数]
+// 对比对行号数组用 std::sort / std::partial_sort / std::nth_element (比较时读取 Book) 和
+// book_sort 的基数排序、topK、nthElement，分别在 vector<Book> 和 BookCatalog 上测量
+
+// 运行 3 次取最快的一次，返回毫秒
+template <class F>
+double bestOf(F&& run)
+{
+    double best = 1e300;
+    for (int i = 0; i < 3; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        run();
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count());
+    }
+    return best;
+}
+
+void report(const char* name, double stdMs, double oursMs, bool same)
+{
+    cout << name << ": std " << stdMs << " ms, book_sort " << oursMs << " ms, 加速比 "
+         << stdMs / oursMs << "x" << (same ? "" : "  (结果不一致!)") << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned threads = argc > 2 ? static_cast<unsigned>(strtoul(argv[2], nullptr, 10))
+                                : max(1u, thread::hardware_concurrency());
+    const size_t k = 100;
+
+    // 1. 生成测试数据 (与 book_catalog.cpp 相同)
+    vector<Book> books;
+    books.reserve(n);
+    BookCatalog catalog;
+    catalog.reserve(n);
+    uint64_t state = 2463534242ull;
+    for (size_t i = 0; i < n; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        Book b = {"Book-" + to_string(state % 100000), static_cast<int>(state >> 20) % 2000 + 1,
+                  static_cast<double>((state >> 40) % 20000) / 100.0};
+        catalog.add(b);
+        books.push_back(std::move(b));
+    }
+    cout << "书籍数量: " << n << ", 线程数: " << threads << endl << endl;
+
+    // 对照: 行号数组 + 读取 Book 的比较函数 (相同价格按行号排列，结果与 book_sort 相同)
+    auto byPrice = [&](uint32_t a, uint32_t b) {
+        return books[a].price != books[b].price ? books[a].price < books[b].price : a < b;
+    };
+    auto identity = [&] {
+        vector<uint32_t> rows(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            rows[i] = static_cast<uint32_t>(i);
+        }
+        return rows;
+    };
+
+    // 2. 完整排序
+    vector<uint32_t> expected, rows;
+    double stdMs = bestOf([&] {
+        expected = identity();
+        sort(expected.begin(), expected.end(), byPrice);
+    });
+    double oursMs = bestOf([&] { rows = book_sort::sortBooks(books, book_sort::BookKey::Price, book_sort::Order::Ascending, threads); });
+    report("sort (price, vector<Book>)  ", stdMs, oursMs, rows == expected);
+    oursMs = bestOf([&] { rows = book_sort::sortBooks(catalog, book_sort::BookKey::Price, book_sort::Order::Ascending, threads); });
+    report("sort (price, BookCatalog)   ", stdMs, oursMs, rows == expected);
+
+    vector<uint32_t> expectedPages;
+    stdMs = bestOf([&] {
+        expectedPages = identity();
+        stable_sort(expectedPages.begin(), expectedPages.end(), [&](uint32_t a, uint32_t b) { return books[a].pages < books[b].pages; });
+    });
+    oursMs = bestOf([&] { rows = book_sort::sortBooks(catalog, book_sort::BookKey::Pages, book_sort::Order::Ascending, threads); });
+    report("sort (pages, BookCatalog)   ", stdMs, oursMs, rows == expectedPages);
+
+    // 3. 前 k 名
+    vector<uint32_t> top;
+    stdMs = bestOf([&] {
+        top = identity();
+        partial_sort(top.begin(), top.begin() + static_cast<ptrdiff_t>(min(k, n)), top.end(), byPrice);
+        top.resize(min(k, n));
+    });
+    oursMs = bestOf([&] { rows = book_sort::topK(catalog, book_sort::BookKey::Price, k, book_sort::Order::Ascending, threads); });
+    report("top 100 (price)             ", stdMs, oursMs, rows == top);
+
+    // 4. 中位数
+    uint32_t median = 0, ours = 0;
+    stdMs = bestOf([&] {
+        vector<uint32_t> all = identity();
+        nth_element(all.begin(), all.begin() + static_cast<ptrdiff_t>(n / 2), all.end(), byPrice);
+        median = all[n / 2];
+    });
+    oursMs = bestOf([&] { ours = book_sort::nthElement(catalog, book_sort::BookKey::Price, n / 2, book_sort::Order::Ascending, threads); });
+    report("nth_element (median price)  ", stdMs, oursMs, ours == median);
+
+    // 5. 按书名 (比较函数) 排序
+    auto byTitle = [](const Book& a, const Book& b) { return a.title < b.title; };
+    stdMs = bestOf([&] {
+        expected = identity();
+        stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return byTitle(books[a], books[b]); });
+    });
+    oursMs = bestOf([&] { rows = book_sort::sortBooksBy(books, byTitle, threads); });
+    report("sortBooksBy (title)         ", stdMs, oursMs, rows == expected);
+
+    cout << endl << "最便宜的书: " << books[top[0]].title << ", " << books[top[0]].price << ", 价格中位数: "
+         << books[median].price << endl;
+    return 0;
+}